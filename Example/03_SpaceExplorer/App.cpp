@@ -7,12 +7,16 @@ bool GameApplication::init() {
 
     setDepthTesting(false);
 
-    debugging = FW::createRef<Debugging>();
-    debugging->init(getWindow());
-
     scene = FW::createRef<GameScene>();
     scene->init();
-    scene->setDebugging(debugging);
+
+    // ImGui needs a window, so there are no debugging windows in headless
+    // mode
+    if (!isHeadless()) {
+        debugging = FW::createRef<Debugging>();
+        debugging->init(getWindow());
+        scene->setDebugging(debugging);
+    }
 
     RenderCommand::setClearColor(glm::vec3{0.5f, 0.25f, 0.4f});
 
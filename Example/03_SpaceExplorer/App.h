@@ -16,6 +16,9 @@ class GameApplication : public FW::GLFWApplication {
     virtual bool init();
     virtual void run();
 
+    /** Stepped by the run loop in headless mode */
+    FW::ref<FW::BaseScene> getScene() override { return scene; }
+
     virtual void keyCallback(int key, int scancode, int action, int mods);
     virtual void cursorPosCallback(double xpos, double ypos);
     virtual void mouseButtonCallback(int button, int action, int mods);
@@ -44,6 +44,10 @@ void GameScene::init() {
     // simply setting it to the player's position.
     camera->setCentraliseScreenCoordinates(true);
 
+    // Sprites with the built-in shader are drawn in batches through this
+    // camera
+    renderSystem.setCamera(camera);
+
     // Background - Must be drawn first
     auto backgroundSprite = FW::createRef<FW::Sprite>(camera);
     createBackground(backgroundSprite);
@@ -52,17 +56,27 @@ void GameScene::init() {
     backgroundNode->entity = backgroundSprite;
     rootNode->addChild(backgroundNode);
 
+    // The page only has to hold one ship and a colour block
+    spriteAtlas =
+      FW::createRef<FW::TextureAtlas>("space_explorer_sprites", 512);
+    spriteAtlas->add("spaceship",
+                     TEXTURES_DIR + std::string("spaceship_sprite.png"));
+    spriteAtlas->addColor("bullet");
+    if (!spriteAtlas->build()) {
+        WARN("GameScene::init(): Not every sprite fits in the sprite atlas");
+    }
+
     // Projectiles
     projectileRoot = FW::createRef<ProjectileRoot>();
     rootNode->addChild(projectileRoot);
 
     // Player ship
-    playerShip = FW::createRef<PlayerShip>(camera, projectileRoot);
+    playerShip = FW::createRef<PlayerShip>(camera, projectileRoot, spriteAtlas);
     playerShip->setPosition(-300.0f, 500.0f);
     rootNode->addChild(playerShip);
 
     // Enemy ship
-    enemyShip = FW::createRef<EnemyShip>(camera, projectileRoot);
+    enemyShip = FW::createRef<EnemyShip>(camera, projectileRoot, spriteAtlas);
     enemyShip->setTargetShip(playerShip);
     rootNode->addChild(enemyShip);
 
@@ -23,6 +23,13 @@ class GameScene : public FW::BaseScene {
 
 private:
     FW::ref<FW::OrthographicCamera> camera;
+
+    /**
+     * Ships and bullets are packed into one atlas page, so the sprite batch
+     * draws them with a single texture.
+     */
+    FW::ref<FW::TextureAtlas> spriteAtlas;
+
     FW::ref<PlayerShip> playerShip;
     FW::ref<FW::SceneNode> backgroundNode;
     /** Simulates space objects to be far away in the background */
@@ -10,11 +10,17 @@
 #include <random>
 #include <cmath>
 
-FW::ref<Bullet> createBullet(FW::ref<FW::Camera> camera) {
+static FW::ref<Bullet> createBullet(FW::ref<FW::Camera> camera,
+                                    const FW::TextureAtlas* spriteAtlas) {
     FW::ref<Bullet> bullet = FW::createRef<Bullet>();
 
     FW::ref<FW::Sprite> sprite = FW::createRef<FW::Sprite>(camera);
     sprite->name = "Bullet";
+    if (spriteAtlas) {
+        if (const auto* region = spriteAtlas->getRegion("bullet")) {
+            sprite->setTexture(*region);
+        }
+    }
     sprite->setColor(1.0f, 0.3f, 0.75f);
     sprite->setSize(30, 10);
     sprite->setPosition(0.0f, 0.0f);
@@ -24,16 +30,22 @@ FW::ref<Bullet> createBullet(FW::ref<FW::Camera> camera) {
     return bullet;
 }
 
-Ship::Ship(FW::ref<FW::Camera> camera, FW::ref<ProjectileRoot> projectileRoot)
+Ship::Ship(FW::ref<FW::Camera> camera,
+           FW::ref<ProjectileRoot> projectileRoot,
+           FW::ref<FW::TextureAtlas> spriteAtlas)
   : camera(camera)
+  , spriteAtlas(spriteAtlas)
   , projectileRoot(projectileRoot) {
 
     FW::ref<FW::Sprite> sprite = FW::createRef<FW::Sprite>(camera);
     sprite->name = "Spaceship";
     // sprite->setColor(0.2f, 0.8f, 0.1f);
     sprite->setSize(150.0f);
-    sprite->setTexture("spaceship",
-                       TEXTURES_DIR + std::string("spaceship_sprite.png"));
+    if (spriteAtlas) {
+        if (const auto* region = spriteAtlas->getRegion("spaceship")) {
+            sprite->setTexture(*region);
+        }
+    }
     // sprite->setPosition(600.f, 400.f);
     entity = sprite;
 
@@ -124,7 +136,7 @@ void Ship::fireBullets(FW::ref<FW::SceneNode> root) {
     float angle = targetShip ? angleToEnemy(this, targetShip.get())
                              : -getRotationWithMouse().z;
     float speed = 2400.0f;
-    auto bullet = createBullet(camera);
+    auto bullet = createBullet(camera, spriteAtlas.get());
 
     // Compute bullet spread
     float randomSpread = FW::remap(FW::rng(),
@@ -236,7 +248,7 @@ void ProjectileRoot::update(float delta) {
 
     // Kill the bullet if its timer has expired. Also it may have declared
     // itself dead. If so, then also kill it.
-    std::erase_if(childNodes, [](const FW::ref<SceneNode>& child) {
+    removeChildrenIf([](const FW::ref<SceneNode>& child) {
         auto bulletScene = std::dynamic_pointer_cast<Bullet>(child);
         return bulletScene && (bulletScene->isDead ||
                                bulletScene->time >= bulletScene->maxTime);
@@ -244,8 +256,9 @@ void ProjectileRoot::update(float delta) {
 }
 
 PlayerShip::PlayerShip(FW::ref<FW::Camera> camera,
-                       FW::ref<ProjectileRoot> projectileRoot)
-  : Ship(camera, projectileRoot) {
+                       FW::ref<ProjectileRoot> projectileRoot,
+                       FW::ref<FW::TextureAtlas> spriteAtlas)
+  : Ship(camera, projectileRoot, spriteAtlas) {
 
     targetSelectorScene.reset();
     entity->name = "Player";
@@ -291,8 +304,9 @@ void PlayerShip::update(float delta) {
 }
 
 EnemyShip::EnemyShip(FW::ref<FW::Camera> camera,
-                     FW::ref<ProjectileRoot> projectileRoot)
-  : Ship(camera, projectileRoot) {
+                     FW::ref<ProjectileRoot> projectileRoot,
+                     FW::ref<FW::TextureAtlas> spriteAtlas)
+  : Ship(camera, projectileRoot, spriteAtlas) {
 
     entity->name = "Enemy";
     chaseMode = AIChaseMode::PATROLCOOLDOWN;
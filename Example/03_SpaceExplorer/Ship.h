@@ -21,7 +21,13 @@ class ProjectileRoot : public FW::SceneNode {
 class Ship : public FW::SceneNode {
 public:
     Ship() = default;
-    Ship(FW::ref<FW::Camera> camera, FW::ref<ProjectileRoot> projectileRoot);
+    /**
+     * @param spriteAtlas Holds the "spaceship" and "bullet" images. Ships and
+     * bullets are drawn untextured without it.
+     */
+    Ship(FW::ref<FW::Camera> camera,
+         FW::ref<ProjectileRoot> projectileRoot,
+         FW::ref<FW::TextureAtlas> spriteAtlas = nullptr);
     virtual ~Ship() = default;
 
 public: // Transformation
@@ -94,6 +100,7 @@ class Ship : public FW::SceneNode {
     float health;
     float gold;
     FW::ref<FW::Camera> camera;
+    FW::ref<FW::TextureAtlas> spriteAtlas;
 
     float fireMaxCooldown = 1.0f;
     float fireCurrentCooldown = 0.0f;
@@ -157,7 +164,8 @@ class PlayerShip : public Ship {
 public:
     PlayerShip() = default;
     PlayerShip(FW::ref<FW::Camera> camera,
-               FW::ref<ProjectileRoot> projectileRoot = nullptr);
+               FW::ref<ProjectileRoot> projectileRoot = nullptr,
+               FW::ref<FW::TextureAtlas> spriteAtlas = nullptr);
 
     virtual void update(float delta) override;
 };
@@ -170,7 +178,8 @@ class EnemyShip : public Ship {
 public:
     EnemyShip() = default;
     EnemyShip(FW::ref<FW::Camera> camera,
-              FW::ref<ProjectileRoot> projectileRoot = nullptr);
+              FW::ref<ProjectileRoot> projectileRoot = nullptr,
+              FW::ref<FW::TextureAtlas> spriteAtlas = nullptr);
 
     virtual void update(float delta) override;
 
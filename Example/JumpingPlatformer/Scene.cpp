@@ -16,9 +16,15 @@ void JumpingPlatformerScene::init() {
     // Uncomment below to centralise the screen coordinates.
     // camera->setCentraliseScreenCoordinates(true);
 
-    // Add physics components here.
-    gravityForce = FW::createRef<FW::Physics::GravityForce>();
+    // Add physics components here. The scene is measured in pixels, so
+    // gravity is in pixels per second squared.
+    gravityForce = FW::createRef<FW::Physics::GravityForce>(
+      glm::vec3{ 0.0f, -600.0f, 0.0f });
     mySolver.addForce(gravityForce);
+
+    // The solver moves the player's transform after every update
+    playerBody =
+      mySolver.addBody(playerSprite->getTransformationComponent().get());
 }
 
 void JumpingPlatformerScene::update(float delta) {
@@ -26,40 +32,43 @@ void JumpingPlatformerScene::update(float delta) {
     // this can be omitted for performance.
     camera->update(playerSprite->getShader());
 
-    glm::vec2 moveBy(0.0f);
+    // Speeds in pixels per second
     float speed = 300.0f;
     float jump = 400.0f;
     static bool isJumping = false;
 
-    playerSprite->getPhysicsComponent()->setVelocity(
-      0.0f, playerSprite->getPhysicsComponent()->getVelocity().y, 0.0f);
+    glm::vec3 position = mySolver.getPosition(playerBody);
+    glm::vec3 velocity = mySolver.getVelocity(playerBody);
+    velocity.x = 0.0f;
 
     // Collide with the ground floor
-    if (playerSprite->getPosition().y < 100.0f) {
-        playerSprite->setPosition(playerSprite->getPosition().x, 100.0f);
-        playerSprite->getPhysicsComponent()->getVelocity().y = 0.0f;
+    if (position.y < 100.0f) {
+        mySolver.setPosition(playerBody, { position.x, 100.0f, position.z });
+        velocity.y = 0.0f;
         isJumping = false;
-    } else {
-        playerSprite->getPhysicsComponent()->getVelocity().y += -9.8f * delta;
     }
 
     // Go right
     if (FW::Input::isKeyPressed(FW_KEY_D) == GLFW_PRESS || FW::Input::isKeyPressed(FW_KEY_LEFT) == GLFW_PRESS) {
-        playerSprite->addVelocity(speed * delta, 0.0f);
+        velocity.x += speed;
     }
 
     // Go left
     if (FW::Input::isKeyPressed(FW_KEY_A) == GLFW_PRESS ||
         FW::Input::isKeyPressed(FW_KEY_LEFT) == GLFW_PRESS) {
-        playerSprite->addVelocity(-speed * delta, 0.0f);
+        velocity.x -= speed;
     }
 
     // Jump
     if (FW::Input::isKeyPressed(FW_KEY_W) && !isJumping) {
-        playerSprite->addVelocity(0.0f, jump * delta);
+        velocity.y = jump;
         isJumping = true;
     }
 
+    // Gravity and movement
+    mySolver.setVelocity(playerBody, velocity);
+    mySolver.update(delta);
+
     // Update the rest of the scene.
     FW::BaseScene::update(delta);
 }
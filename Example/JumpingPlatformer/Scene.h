@@ -23,4 +23,5 @@ class JumpingPlatformerScene : public FW::BaseScene {
 private: // Physics
     FW::Physics::Solver mySolver;
     FW::ref<FW::Physics::GravityForce> gravityForce;
+    FW::Physics::BodyId playerBody = 0;
 };
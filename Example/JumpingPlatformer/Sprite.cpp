@@ -1,10 +1,10 @@
 #include "Sprite.h"
 
 Sprite::Sprite() {
-    drawableComponent = FW::createRef<FW::DrawableComponent>();
+    drawableComponent = FW::createComponent<FW::DrawableComponent>();
     addComponent(drawableComponent);
 
-    transformationComponent = FW::createRef<FW::TransformationComponent>();
+    transformationComponent = FW::createComponent<FW::TransformationComponent>();
     addComponent(transformationComponent);
 
     spriteShader = FW::createRef<FW::Shader>(
@@ -19,8 +19,6 @@ Sprite::Sprite() {
     drawableComponent->setShape(quadShape);
 
     transformationComponent->setShader(spriteShader);
-
-    physicsComponent = FW::createRef<FW::PhysicsComponent>();
 }
 
 void Sprite::moveBy(float x, float y) {
@@ -42,17 +40,3 @@ void Sprite::setPosition(float x, float y) {
     transformationComponent->setPosition(
       { x, y, transformationComponent->getPosition().z });
 }
-
-void Sprite::update(float delta) {
-    Entity::update(delta);
-    // Because the PhysicsComponent and TransformationComponent are independent
-    // and know nothing about each other, we must handle position update
-    // ourselves.
-
-    auto velocity = physicsComponent->getVelocity();
-    moveBy(velocity.x, velocity.y);
-}
-
-void Sprite::addVelocity(float x, float y) {
-    physicsComponent->addVelocity(x, y);
-}
\ No newline at end of file
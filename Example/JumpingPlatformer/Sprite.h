@@ -24,12 +24,8 @@ class Sprite : public FW::Entity {
     glm::vec2 getPosition();
     void setPosition(float x, float y);
 
-    void update(float delta) override;
-
-    void addVelocity(float x, float y);
-
-    FW::ref<FW::PhysicsComponent> getPhysicsComponent() {
-        return physicsComponent;
+    FW::ref<FW::TransformationComponent> getTransformationComponent() {
+        return transformationComponent;
     }
 
 private:
@@ -45,14 +41,6 @@ class Sprite : public FW::Entity {
      */
     FW::ref<FW::DrawableComponent> drawableComponent;
 
-    /**
-     * The physics component stores data like velocity, gravity and forces.
-     * It is only concerned about its own data, so to make something move the
-     * user must update other components like TransformationComponent or
-     * DrawableComponents.
-     */
-    FW::ref<FW::PhysicsComponent> physicsComponent;
-
     /**
      * The Shader is what draws the sprite on screen. Since it is a shared
      * reference, one shader can support multiple sprites.
@@ -60,7 +60,9 @@ SokobanApplication::init()
       RESOURCES_DIR + std::string("shaders/skyboxVertex.glsl"),
       RESOURCES_DIR + std::string("shaders/skyboxFrag.glsl"));
 
-    FW::TextureManager::loadTexture2D(
+    // Decoded in the background. Until they are uploaded, the white default
+    // texture is bound in their place.
+    FW::TextureManager::loadTexture2DAsync(
       { { "metal_plate_diff",
           TEXTURES_DIR +
             std::string("polyhaven/metal_plate/metal_plate_diff_1k.jpg") },
@@ -147,8 +149,9 @@ SokobanApplication::init()
         TEXTURES_DIR + std::string("skybox/demo/front.jpg"),
         TEXTURES_DIR + std::string("skybox/demo/back.jpg"),
     };
-    int skyboxId = FW::TextureManager::loadCubeMap("skybox_demo", faces);
-    skybox = FW::createRef<FW::Skybox>(skyboxId);
+    FW::TextureManager::loadCubeMapAsync("skybox_demo", faces);
+    skybox = FW::createRef<FW::Skybox>(
+      FW::TextureManager::getTextureID("skybox_demo"));
     skybox->setScale(700.0f);
 
     RenderCommand::setClearColor(glm::vec3{ 0.2f, 0.1f, 0.215f });
@@ -162,6 +165,7 @@ void
 SokobanApplication::run()
 {
     while (!glfwWindowShouldClose(getWindow())) {
+        FW::TextureManager::processUploads();
         RenderCommand::clear();
         glfwPollEvents();
         keyboardInput();
@@ -1,18 +1,73 @@
 #include "GLFWApplication.h"
+#include "Log.h"
+
+#include <charconv>
+#include <string_view>
+
+/**
+ * Read headless mode options from the command line.
+ *
+ * @details Recognized options are <i>--headless</i>, <i>--ticks=N</i> and
+ * <i>--timestep=SECONDS</i>. The latter two imply <i>--headless</i>. Other
+ * arguments are ignored.
+ */
+static FW::HeadlessSettings
+parseHeadlessSettings(int argc, char* argv[])
+{
+    FW::HeadlessSettings settings;
+
+    for (int i = 1; i < argc; i++) {
+        std::string_view argument = argv[i];
+        std::string_view value = argument.substr(argument.find('=') + 1);
+        const char* end = value.data() + value.size();
+
+        if (argument == "--headless") {
+            settings.enabled = true;
+        } else if (argument.starts_with("--ticks=")) {
+            auto result = std::from_chars(value.data(), end, settings.ticks);
+            if (result.ec != std::errc() || result.ptr != end) {
+                WARN("Invalid value for --ticks: '{}'", value);
+            }
+            settings.enabled = true;
+        } else if (argument.starts_with("--timestep=")) {
+            float timestep = 0.0f;
+            auto result = std::from_chars(value.data(), end, timestep);
+            if (result.ec != std::errc() || result.ptr != end ||
+                timestep <= 0.0f) {
+                WARN("Invalid value for --timestep: '{}'", value);
+            } else {
+                settings.timestep = timestep;
+            }
+            settings.enabled = true;
+        }
+    }
+
+    return settings;
+}
 
 int
 main(int argc, char* argv[])
 {
+    FW::HeadlessSettings headless = parseHeadlessSettings(argc, argv);
+
     bool shouldRestart = false;
     do {
 
         auto app = FW::createApplication();
+        if (headless.enabled) {
+            app->setHeadless(headless);
+        }
         
         if (!app->init()) {
             delete app;
             return 1;
         }
-        app->run(); // Game loop
+
+        if (app->isHeadless()) {
+            app->runHeadless();
+        } else {
+            app->run(); // Game loop
+        }
         shouldRestart = app->shouldRestartItself;
         
         delete app;
@@ -1,4 +1,5 @@
 // C++ libraries
+#include <chrono>
 #include <csignal>
 
 // External libraries
@@ -6,8 +7,11 @@
 
 // Framework
 #include "GLFWApplication.h"
+#include "BaseScene.h"
 #include "Log.h"
+#include "RecordingBackend.h"
 #include "RenderCommands.h"
+#include "RenderState.h"
 #include "Input.h"
 #include "ShaderManager.h"
 #include "TextureManager.h"
@@ -37,9 +41,13 @@ static void GLAPIENTRY OpenGL_DebugMessages(GLenum source,
                                             GLsizei length,
                                             const GLchar* message,
                                             const void* userParam);
+static void FW_Headless_Signal(int signal);
 
 static FW::GLFWApplication* gApp = nullptr;
 
+/** Set by SIGINT or SIGTERM to end runHeadless() */
+static volatile std::sig_atomic_t gHeadlessStop = 0;
+
 namespace FW {
     // Set initial values to member variables
     GLFWApplication::GLFWApplication(const std::string& name,
@@ -56,6 +64,11 @@ namespace FW {
         RenderCommand::destroy();
         ShaderManager::get().clear();
 
+        // GLFW was never initialized
+        if (isHeadless()) {
+            return;
+        }
+
         // Destroy window and terminate GLFW.
         // NOTE: DO NOT run any GLFW functions after calling glfwTerminate()!!
         glfwDestroyWindow(window);
@@ -63,6 +76,53 @@ namespace FW {
     }
 
     bool GLFWApplication::init() {
+        if (isHeadless()) {
+            // There is no context to load OpenGL from. Sprites, shaders and
+            // textures are still created by scenes, so their calls are
+            // accepted and dropped by the recording backend.
+            auto backend = createScope<RecordingBackend>();
+            backend->setLogCommands(false);
+            RenderCommand::setBackend(std::move(backend));
+        } else if (!createContext()) {
+            return false;
+        }
+
+        // Static pointer to this application for setting up callback functions
+        gApp = this;
+
+        // Rendering
+        RenderCommand::init();
+
+        if (!configureDirectories()) {
+            FATAL("Failed to configure directories");
+        } else {
+            INFO("Created game directories");
+        }
+
+        /* Physics */
+        // TODO: Remove. Clients may not want to implement physics.
+        physicsServer = createScope<Physics::PhysicsServer>();
+        physicsServer->stepSize = 1;
+
+        /* Time */
+        // Headless mode does not measure time between frames
+        if (!isHeadless()) {
+            timer.updateDeltaTime();
+        }
+
+        // Most drawable entities that use textures expect the default texture
+        // to be white.
+        TextureManager::createTexture(
+          "default", { 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f });
+
+        INFO("GLFWApplication \'{}\' successfully initiated{}",
+             appName,
+             isHeadless() ? " in headless mode" : "");
+
+        return true;
+    }
+
+    bool GLFWApplication::createContext() {
         // ------------------
         // Initialize GLFW and create the application window.
         // ------------------
@@ -96,44 +156,69 @@ namespace FW {
         glDebugMessageControl(
           GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
 
-        // Static pointer to this application for setting up callback functions
-        gApp = this;
-
         INFO("GLFW callback functions successfully bound");
 
-        // Rendering
-        RenderCommand::init();
+        return true;
+    }
 
-        if (!configureDirectories()) {
-            FATAL("Failed to configure directories");
-        } else {
-            INFO("Created game directories");
-        }
+    void GLFWApplication::setDepthTesting(const bool b) {
+        RenderState::get().setDepthTest(b);
+    }
 
-        /* Physics */
-        // TODO: Remove. Clients may not want to implement physics.
-        physicsServer = createScope<Physics::PhysicsServer>();
-        physicsServer->stepSize = 1;
+    uint64_t GLFWApplication::runHeadless() {
+        using Clock = std::chrono::steady_clock;
+        using Seconds = std::chrono::duration<double>;
 
-        /* Time */
-        timer.updateDeltaTime();
+        const HeadlessSettings& settings = headlessSettings;
+        ref<BaseScene> scene = getScene();
+        if (!scene) {
+            WARN("GLFWApplication::runHeadless: getScene() returned NULL. "
+                 "Only the physics server is simulated");
+        }
 
-        // Most drawable entities that use textures expect the default texture
-        // to be white.
-        TextureManager::createTexture(
-          "default", { 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f });
+        gHeadlessStop = 0;
+        auto previousInterrupt = std::signal(SIGINT, FW_Headless_Signal);
+        auto previousTerminate = std::signal(SIGTERM, FW_Headless_Signal);
+
+        physicsServer->setDelta(settings.timestep);
+
+        INFO("Headless: simulating {} s per tick", settings.timestep);
+
+        uint64_t ticks = 0;
+        uint64_t reportedTicks = 0;
+        const auto start = Clock::now();
+        auto lastReport = start;
+
+        while (!gHeadlessStop &&
+               (settings.ticks == 0 || ticks < settings.ticks)) {
+            physicsServer->update();
+            if (scene) {
+                scene->update(settings.timestep);
+            }
+            ticks++;
+
+            auto now = Clock::now();
+            Seconds sinceReport = now - lastReport;
+            if (sinceReport.count() >= settings.reportInterval) {
+                INFO("Headless: {:.0f} ticks/s",
+                     (ticks - reportedTicks) / sinceReport.count());
+                lastReport = now;
+                reportedTicks = ticks;
+            }
+        }
 
-        INFO("GLFWApplication \'{}\' successfully initiated", appName);
+        double elapsed = Seconds(Clock::now() - start).count();
+        INFO("Headless: {} ticks in {:.3f} s, {:.0f} ticks/s, {:.1f} s "
+             "simulated",
+             ticks,
+             elapsed,
+             elapsed > 0.0 ? ticks / elapsed : 0.0,
+             ticks * static_cast<double>(settings.timestep));
 
-        return true;
-    }
+        std::signal(SIGINT, previousInterrupt);
+        std::signal(SIGTERM, previousTerminate);
 
-    void GLFWApplication::setDepthTesting(const bool b) {
-        if (b) {    
-            glEnable(GL_DEPTH_TEST);
-        } else {
-            glDisable(GL_DEPTH_TEST);
-        }
+        return ticks;
     }
 
     void GLFWApplication::changeWindowMode(WindowMode mode) {
@@ -238,18 +323,22 @@ namespace FW {
         // Load OpenGL functions in runtime
         gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
 
-        glEnable(GL_BLEND); // For transparency
+        // The context is new, so it starts out with the default state
+        RenderState& state = RenderState::get();
+        state.reset();
+
+        state.setBlend(true); // For transparency
 
         // Depth testing
-        glEnable(GL_DEPTH_TEST);
-        RenderCommand::setCurrentDepthFunc(GL_LESS);
+        state.setDepthTest(true);
+        state.setDepthFunc(GL_LESS);
 
         // Culling
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_BACK);
-        glFrontFace(GL_CCW);
+        state.setCullFace(true);
+        state.setCullMode(GL_BACK);
+        state.setFrontFace(GL_CCW);
 
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        state.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     }
 
 } // namespace Framework
@@ -305,6 +394,13 @@ void FW_GLFWFramebufferSize_Callback(GLFWwindow* window,
     gApp->framebufferSizeCallback(width, height);
 }
 
+/**
+ * Called on SIGINT or SIGTERM while running headless.
+ */
+void FW_Headless_Signal(int signal) {
+    gHeadlessStop = 1;
+}
+
 // Output messages from OpenGL
 static void GLAPIENTRY OpenGL_DebugMessages(GLenum source,
                                             GLenum type,
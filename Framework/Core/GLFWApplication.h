@@ -13,12 +13,32 @@
 #include "Timer.h"
 
 namespace FW {
+    class BaseScene;
+
     enum class WindowMode { WINDOW = 0, BORDERLESS, FULLSCREEN };
     struct WindowSettings {
         glm::vec2 size = { 1280, 720 };
         WindowMode windowMode = WindowMode::WINDOW;
     };
 
+    /**
+     * Settings for running the simulation without a window or GPU.
+     *
+     * @details When enabled, init() neither initializes GLFW nor loads
+     * OpenGL. Rendering calls are sent to a \ref RecordingBackend
+     * "RecordingBackend" instead, so scenes can still create their sprites
+     * and shaders. runHeadless() then replaces run().
+     */
+    struct HeadlessSettings {
+        bool enabled = false;
+        /** Simulated seconds per tick. Ticks are not capped to real time. */
+        float timestep = 1.0f / 60.0f;
+        /** Stop after this many ticks. 0 runs until interrupted. */
+        uint64_t ticks = 0;
+        /** Seconds of real time between ticks/sec reports. */
+        float reportInterval = 1.0f;
+    };
+
     /**
      * Application class
      *
@@ -160,6 +180,43 @@ namespace FW {
          */
         virtual void run() = 0;
 
+        /**
+         * Step the simulation at a fixed timestep, as fast as possible.
+         *
+         * @details Used instead of run() in headless mode. Each tick updates
+         * the physics server and the scene returned by getScene(). The tick
+         * rate is logged every <u>reportInterval</u> seconds and once more
+         * when the loop ends, either after <u>ticks</u> ticks or on SIGINT or
+         * SIGTERM.
+         *
+         * @return The number of ticks simulated.
+         */
+        uint64_t runHeadless();
+
+        /**
+         * Enable or configure headless mode. Must be called before init().
+         *
+         * @details EntryPoint calls this for the <i>--headless</i> command
+         * line flag. Applications that read their settings from a
+         * configuration file may call it themselves.
+         */
+        void setHeadless(const HeadlessSettings& settings) {
+            headlessSettings = settings;
+        }
+        const HeadlessSettings& getHeadless() const {
+            return headlessSettings;
+        }
+        bool isHeadless() const { return headlessSettings.enabled; }
+
+        /**
+         * The scene stepped by runHeadless().
+         *
+         * @details Applications own their scenes, so they override this to
+         * make them available to the headless loop. By default, only the
+         * physics server is stepped.
+         */
+        virtual ref<BaseScene> getScene() { return nullptr; }
+
         /**
          * Return the window this application runs in.
          *
@@ -290,6 +347,16 @@ namespace FW {
         /** Used to get delta time between frames */
         Timer timer;
 
+        HeadlessSettings headlessSettings;
+
+    private:
+        /**
+         * Initialize GLFW, create the window and load OpenGL.
+         *
+         * @return False if GLFW could not be initialized.
+         */
+        bool createContext();
+
     private:
         /** Application name. This is also the window class. */
         std::string appName;
@@ -10,6 +10,11 @@ namespace FW {
     bool Input::enableKeyboardCapture = true;
 
     bool Input::isKeyPressed(int keycode) {
+        // Headless applications have no window to read input from
+        if (!window) {
+            return false;
+        }
+
         auto state = glfwGetKey(window, keycode);
         return Input::enableKeyboardCapture &&
                (state == GLFW_PRESS || state == GLFW_REPEAT);
@@ -30,6 +35,10 @@ namespace FW {
     }
 
     bool Input::isMouseButtonPressed(int mouseButton) {
+        if (!window) {
+            return false;
+        }
+
         auto state = glfwGetMouseButton(window, mouseButton);
         return state == GLFW_PRESS;
     }
@@ -47,6 +56,10 @@ namespace FW {
     }
 
     glm::vec2 Input::getMousePosition() {
+        if (!window) {
+            return { 0.0f, 0.0f };
+        }
+
         double xpos, ypos;
         glfwGetCursorPos(window, &xpos, &ypos);
 
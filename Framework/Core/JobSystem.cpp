@@ -0,0 +1,195 @@
+#include "JobSystem.h"
+
+namespace FW {
+    /** The system whose worker runs on this thread, and its deque. */
+    static thread_local const JobSystem* workerSystem = nullptr;
+    static thread_local int workerQueue = -1;
+
+    /** Pick steal victims in a different order on every thread. */
+    static uint32_t nextVictim() {
+        static thread_local uint32_t state = static_cast<uint32_t>(
+          std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1);
+
+        // xorshift32
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    JobSystem::JobSystem(uint32_t workerCount)
+      : ownerThread(std::this_thread::get_id()) {
+        for (uint32_t i = 0; i <= workerCount; i++) {
+            queues.push_back(createScope<WorkStealingDeque<Job*>>());
+        }
+
+        workers.reserve(workerCount);
+        for (uint32_t i = 1; i <= workerCount; i++) {
+            workers.emplace_back(&JobSystem::workerLoop, this, i);
+        }
+    }
+
+    JobSystem::~JobSystem() {
+        {
+            std::lock_guard lock(sleepMutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        // Nobody else is left, so any thread may empty the deques
+        for (auto& queue : queues) {
+            while (auto job = queue->steal()) {
+                delete *job;
+            }
+        }
+        for (Job* job : injected) {
+            delete job;
+        }
+    }
+
+    JobSystem& JobSystem::get() {
+        static JobSystem system(
+          std::max(std::thread::hardware_concurrency(), 1u) - 1);
+        return system;
+    }
+
+    JobHandle JobSystem::schedule(Function function) {
+        JobHandle handle = createRef<JobCounter>();
+        handle->pending.fetch_add(1, std::memory_order_relaxed);
+        push(new Job{ std::move(function), handle.get(), handle });
+        return handle;
+    }
+
+    void JobSystem::schedule(Function function, JobCounter& counter) {
+        counter.pending.fetch_add(1, std::memory_order_relaxed);
+        push(new Job{ std::move(function), &counter, nullptr });
+    }
+
+    void JobSystem::wait(const JobCounter& counter) {
+        while (!counter.isDone()) {
+            if (!runPendingJob()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void JobSystem::push(Job* job) {
+        int queue = getQueueIndex();
+        if (queue >= 0) {
+            queues[queue]->push(job);
+        } else {
+            std::lock_guard lock(injectedMutex);
+            injected.push_back(job);
+        }
+
+        // Either this sees a worker that is going to sleep, or that worker
+        // sees the job. Both are sequentially consistent.
+        queuedJobs.fetch_add(1, std::memory_order_seq_cst);
+        if (sleepingWorkers.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard lock(sleepMutex);
+            wakeUp.notify_one();
+        }
+    }
+
+    JobSystem::Job* JobSystem::findJob() {
+        int own = getQueueIndex();
+        Job* job = nullptr;
+
+        if (own >= 0) {
+            if (auto popped = queues[own]->pop()) {
+                job = *popped;
+            }
+        }
+
+        if (!job) {
+            std::unique_lock lock(injectedMutex, std::try_to_lock);
+            if (lock.owns_lock() && !injected.empty()) {
+                job = injected.front();
+                injected.pop_front();
+            }
+        }
+
+        if (!job) {
+            uint32_t count = static_cast<uint32_t>(queues.size());
+            uint32_t start = nextVictim() % count;
+            for (uint32_t i = 0; i < count && !job; i++) {
+                uint32_t victim = (start + i) % count;
+                if (static_cast<int>(victim) == own) {
+                    continue;
+                }
+                if (auto stolen = queues[victim]->steal()) {
+                    job = *stolen;
+                }
+            }
+        }
+
+        if (job) {
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    bool JobSystem::runPendingJob() {
+        Job* job = findJob();
+        if (!job) {
+            return false;
+        }
+
+        job->function();
+
+        // The handle keeps the counter alive until it has been decremented
+        JobCounter* counter = job->counter;
+        JobHandle handle = std::move(job->handle);
+        delete job;
+        counter->pending.fetch_sub(1, std::memory_order_release);
+
+        return true;
+    }
+
+    void JobSystem::workerLoop(uint32_t queue) {
+        workerSystem = this;
+        workerQueue = static_cast<int>(queue);
+
+        // Waking a sleeping thread takes microseconds, so look for work a
+        // little longer before going to sleep.
+        constexpr int spinRounds = 64;
+
+        while (!stopping.load(std::memory_order_acquire)) {
+            bool ranJob = false;
+            for (int i = 0; i < spinRounds && !ranJob; i++) {
+                ranJob = runPendingJob();
+                if (!ranJob) {
+                    std::this_thread::yield();
+                }
+            }
+            if (ranJob) {
+                continue;
+            }
+
+            std::unique_lock lock(sleepMutex);
+            sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+            wakeUp.wait(lock, [this] {
+                return stopping.load(std::memory_order_relaxed) ||
+                       queuedJobs.load(std::memory_order_seq_cst) > 0;
+            });
+            sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        workerSystem = nullptr;
+        workerQueue = -1;
+    }
+
+    int JobSystem::getQueueIndex() const {
+        if (workerSystem == this) {
+            return workerQueue;
+        }
+        if (std::this_thread::get_id() == ownerThread) {
+            return 0;
+        }
+        return -1;
+    }
+} // namespace FW
@@ -0,0 +1,228 @@
+#pragma once
+
+#include "Memory.h"
+#include "WorkStealingDeque.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace FW {
+    /**
+     * Number of unfinished jobs in a group.
+     *
+     * @details Scheduling a job with a counter increments it, and finishing
+     * the job decrements it. JobSystem::wait() returns once it reaches zero.
+     * The counter must outlive the jobs scheduled with it.
+     */
+    class JobCounter {
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        bool isDone() const {
+            return pending.load(std::memory_order_acquire) == 0;
+        }
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<uint32_t> pending{ 0 };
+    };
+
+    /** Counter of a single job, kept alive by the job until it finishes. */
+    using JobHandle = ref<JobCounter>;
+
+    /**
+     * Work-stealing thread pool.
+     *
+     * @details Every worker thread owns a \ref WorkStealingDeque
+     * "WorkStealingDeque". Jobs scheduled from a worker are pushed to its own
+     * deque and popped in LIFO order, which keeps their data in cache. Idle
+     * workers steal the oldest jobs from random other deques, and sleep when
+     * there is nothing left to steal.
+     *
+     * @details The thread that creates the system owns a deque too, but runs
+     * no loop. Instead, it runs jobs while it waits for them in wait(). Jobs
+     * scheduled from other threads go through a shared queue.
+     *
+     * @details Jobs must not throw.
+     *
+     * @example
+     * @code
+     * JobSystem& jobs = JobSystem::get();
+     *
+     * // One job
+     * JobHandle handle = jobs.schedule([] { loadLevel(); });
+     * jobs.wait(handle);
+     *
+     * // A loop, split into chunks of 256 particles
+     * jobs.parallelFor(0, particles.size(), 256,
+     *                  [&](std::size_t begin, std::size_t end) {
+     *     for (std::size_t i = begin; i < end; i++) {
+     *         particles[i].update(delta);
+     *     }
+     * });
+     * @endcode
+     */
+    class JobSystem {
+    public:
+        using Function = std::function<void()>;
+
+    public:
+        /**
+         * Start `workerCount` worker threads. With 0 workers, jobs run on the
+         * thread waiting for them.
+         */
+        explicit JobSystem(uint32_t workerCount);
+
+        /**
+         * Stop and join the workers. Jobs that were scheduled but never
+         * waited for may not run.
+         */
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        /**
+         * The shared job system, with one worker per hardware thread besides
+         * the one that first calls get().
+         */
+        static JobSystem& get();
+
+        /** Schedule a job, and return a handle to wait for it. */
+        JobHandle schedule(Function function);
+
+        /** Schedule a job as part of the group counted by `counter`. */
+        void schedule(Function function, JobCounter& counter);
+
+        /**
+         * Run jobs on the calling thread until all jobs counted by `counter`
+         * have finished.
+         *
+         * @details Safe to call from inside a job.
+         */
+        void wait(const JobCounter& counter);
+        void wait(const JobHandle& handle) { wait(*handle); }
+
+        /**
+         * Call `function(begin, end)` for chunks of [begin, end) in parallel,
+         * and wait for all of them.
+         *
+         * @param grainSize Indices per chunk. 0 picks a few chunks per
+         * thread, so threads that finish early can steal the rest.
+         */
+        template<typename Body>
+        void parallelFor(std::size_t begin,
+                         std::size_t end,
+                         std::size_t grainSize,
+                         Body&& function);
+
+        uint32_t getWorkerCount() const {
+            return static_cast<uint32_t>(workers.size());
+        }
+
+        /** Workers, and the thread that waits. */
+        uint32_t getThreadCount() const { return getWorkerCount() + 1; }
+
+    private:
+        struct Job {
+            Function function;
+            JobCounter* counter;
+            /** Owns `counter` for jobs scheduled without one. */
+            JobHandle handle;
+        };
+
+        void push(Job* job);
+
+        /**
+         * Take a job from this thread's deque, the shared queue or another
+         * thread's deque. Returns nullptr if none was found.
+         */
+        Job* findJob();
+
+        /** Run one job, if one could be found. */
+        bool runPendingJob();
+
+        void workerLoop(uint32_t queue);
+
+        /**
+         * Deque owned by the calling thread, or -1 if it owns none in this
+         * system.
+         */
+        int getQueueIndex() const;
+
+    private:
+        /** Deque 0 belongs to the creating thread, the rest to workers. */
+        std::vector<scope<WorkStealingDeque<Job*>>> queues;
+        std::vector<std::thread> workers;
+        std::thread::id ownerThread;
+
+        /** Jobs scheduled from threads that own no deque. */
+        std::deque<Job*> injected;
+        std::mutex injectedMutex;
+
+        /** Pushed but not yet taken. Workers sleep while this is 0. */
+        std::atomic<int64_t> queuedJobs{ 0 };
+        std::atomic<uint32_t> sleepingWorkers{ 0 };
+        std::mutex sleepMutex;
+        std::condition_variable wakeUp;
+        std::atomic<bool> stopping{ false };
+    };
+
+    template<typename Body>
+    void JobSystem::parallelFor(std::size_t begin,
+                                std::size_t end,
+                                std::size_t grainSize,
+                                Body&& function) {
+        if (begin >= end) {
+            return;
+        }
+
+        std::size_t count = end - begin;
+        if (grainSize == 0) {
+            std::size_t chunks = getThreadCount() * 4;
+            grainSize = std::max<std::size_t>(1, count / chunks);
+        }
+        if (count <= grainSize) {
+            function(begin, end);
+            return;
+        }
+
+        // Jobs capture only the context and a chunk index, which std::function
+        // stores without allocating.
+        struct Context {
+            std::size_t begin;
+            std::size_t end;
+            std::size_t grainSize;
+            std::remove_reference_t<Body>* function;
+        } context{ begin, end, grainSize, &function };
+
+        std::size_t chunks = (count + grainSize - 1) / grainSize;
+        JobCounter counter;
+        for (std::size_t chunk = 1; chunk < chunks; chunk++) {
+            schedule(
+              [&context, chunk] {
+                  std::size_t first = context.begin + chunk * context.grainSize;
+                  std::size_t last =
+                    std::min(first + context.grainSize, context.end);
+                  (*context.function)(first, last);
+              },
+              counter);
+        }
+
+        // The first chunk runs here, while the others are being stolen
+        function(begin, begin + grainSize);
+        wait(counter);
+    }
+} // namespace FW
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace FW {
+    /**
+     * Chase-Lev work-stealing deque.
+     *
+     * @details One thread owns the deque and pushes and pops items at the
+     * bottom, like a stack. Any other thread may steal from the top, so the
+     * oldest items are stolen first. Only steals and the pop of the last item
+     * synchronize with each other, so the owner's pushes and pops are cheap.
+     *
+     * @details The memory orderings follow Lê et al., "Correct and Efficient
+     * Work-Stealing for Weak Memory Models" (PPoPP 2013). The buffer grows
+     * when full. Outgrown buffers are kept until the deque is destroyed,
+     * because a thief may still be reading from them.
+     *
+     * @tparam T Trivially copyable item, usually a pointer.
+     */
+    template<typename T>
+    class WorkStealingDeque {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "WorkStealingDeque items must be trivially copyable");
+
+    public:
+        explicit WorkStealingDeque(int64_t capacity = 256) {
+            int64_t size = 1;
+            while (size < capacity) {
+                size <<= 1;
+            }
+            buffers.push_back(std::make_unique<Buffer>(size));
+            buffer.store(buffers.back().get(), std::memory_order_relaxed);
+        }
+
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        /** Add an item at the bottom. Owner only. */
+        void push(T item) {
+            int64_t b = bottom.load(std::memory_order_relaxed);
+            int64_t t = top.load(std::memory_order_acquire);
+            Buffer* current = buffer.load(std::memory_order_relaxed);
+
+            if (b - t > current->mask) {
+                current = grow(current, t, b);
+            }
+            current->put(b, item);
+
+            // Publishes the item to thieves that read `bottom`. The paper
+            // uses a release fence, which is equivalent but invisible to
+            // ThreadSanitizer.
+            bottom.store(b + 1, std::memory_order_release);
+        }
+
+        /** Take the most recently pushed item. Owner only. */
+        std::optional<T> pop() {
+            int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+            Buffer* current = buffer.load(std::memory_order_relaxed);
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = top.load(std::memory_order_relaxed);
+
+            if (t > b) {
+                // Empty
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+
+            T item = current->get(b);
+            if (t == b) {
+                // Last item. Race thieves for it.
+                bool won =
+                  top.compare_exchange_strong(t,
+                                              t + 1,
+                                              std::memory_order_seq_cst,
+                                              std::memory_order_relaxed);
+                bottom.store(b + 1, std::memory_order_relaxed);
+                if (!won) {
+                    return std::nullopt;
+                }
+            }
+            return item;
+        }
+
+        /**
+         * Take the oldest item. Safe from any thread.
+         *
+         * @details May fail while the deque is not empty, if another thread
+         * took the item first. Callers should move on to another deque.
+         */
+        std::optional<T> steal() {
+            int64_t t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t b = bottom.load(std::memory_order_acquire);
+
+            if (t >= b) {
+                return std::nullopt;
+            }
+
+            Buffer* current = buffer.load(std::memory_order_acquire);
+            T item = current->get(t);
+            if (!top.compare_exchange_strong(t,
+                                             t + 1,
+                                             std::memory_order_seq_cst,
+                                             std::memory_order_relaxed)) {
+                return std::nullopt;
+            }
+            return item;
+        }
+
+        /**
+         * Approximate number of items. Exact only when called by the owner
+         * while no thread is stealing.
+         */
+        int64_t size() const {
+            int64_t b = bottom.load(std::memory_order_relaxed);
+            int64_t t = top.load(std::memory_order_relaxed);
+            return b > t ? b - t : 0;
+        }
+
+        bool empty() const { return size() == 0; }
+
+    private:
+        /** Ring buffer with a power of two capacity. */
+        struct Buffer {
+            explicit Buffer(int64_t capacity)
+              : mask(capacity - 1)
+              , items(std::make_unique<std::atomic<T>[]>(capacity)) {}
+
+            void put(int64_t index, T item) {
+                items[index & mask].store(item, std::memory_order_relaxed);
+            }
+
+            T get(int64_t index) const {
+                return items[index & mask].load(std::memory_order_relaxed);
+            }
+
+            int64_t mask;
+            std::unique_ptr<std::atomic<T>[]> items;
+        };
+
+        Buffer* grow(Buffer* old, int64_t t, int64_t b) {
+            buffers.push_back(std::make_unique<Buffer>((old->mask + 1) * 2));
+            Buffer* grown = buffers.back().get();
+            for (int64_t i = t; i < b; i++) {
+                grown->put(i, old->get(i));
+            }
+            buffer.store(grown, std::memory_order_release);
+            return grown;
+        }
+
+    private:
+        // Thieves hammer `top` and the owner `bottom`. Keep them on separate
+        // cache lines.
+        alignas(64) std::atomic<int64_t> top{ 0 };
+        alignas(64) std::atomic<int64_t> bottom{ 0 };
+        alignas(64) std::atomic<Buffer*> buffer{ nullptr };
+
+        /** Every buffer ever used. Only touched by the owner. */
+        std::vector<std::unique_ptr<Buffer>> buffers;
+    };
+} // namespace FW
@@ -0,0 +1,166 @@
+/**
+ * Compare the JobSystem with std::async for fine-grained jobs.
+ *
+ * Throughput: many jobs of roughly a microsecond of work each, run through
+ * JobSystem::schedule(), JobSystem::parallelFor() and one std::async call
+ * per job. Latency: the time from scheduling a single job until it starts
+ * running, on an otherwise idle pool. With wait(), the waiting thread usually
+ * runs the job itself. Without it, a worker has to wake up and steal it.
+ */
+
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <future>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+/** A job's worth of work. */
+static float work(std::size_t index) {
+    float value = static_cast<float>(index);
+    for (int i = 0; i < 200; i++) {
+        value = std::sqrt(value * value + 1.0f);
+    }
+    return value;
+}
+
+static double toMilliseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+template<typename Func>
+static double measure(Func&& func) {
+    auto start = Clock::now();
+    func();
+    return toMilliseconds(Clock::now() - start);
+}
+
+static void printRow(const char* method, std::size_t jobs, double ms) {
+    std::printf("%-24s %10zu %12.3f %14.0f\n",
+                method,
+                jobs,
+                ms,
+                jobs / (ms / 1000.0));
+}
+
+static void benchmarkThroughput(FW::JobSystem& jobSystem, std::size_t jobs) {
+    std::vector<float> results(jobs);
+
+    double serial = measure([&] {
+        for (std::size_t i = 0; i < jobs; i++) {
+            results[i] = work(i);
+        }
+    });
+    printRow("serial", jobs, serial);
+
+    double scheduled = measure([&] {
+        FW::JobCounter counter;
+        for (std::size_t i = 0; i < jobs; i++) {
+            jobSystem.schedule([&results, i] { results[i] = work(i); },
+                               counter);
+        }
+        jobSystem.wait(counter);
+    });
+    printRow("JobSystem::schedule", jobs, scheduled);
+
+    double parallelFor = measure([&] {
+        jobSystem.parallelFor(
+          0, jobs, 0, [&](std::size_t begin, std::size_t end) {
+              for (std::size_t i = begin; i < end; i++) {
+                  results[i] = work(i);
+              }
+          });
+    });
+    printRow("JobSystem::parallelFor", jobs, parallelFor);
+
+    // One thread per job. Capped, or it takes minutes.
+    std::size_t asyncJobs = std::min<std::size_t>(jobs, 10'000);
+    double async = measure([&] {
+        std::vector<std::future<void>> futures;
+        futures.reserve(asyncJobs);
+        for (std::size_t i = 0; i < asyncJobs; i++) {
+            futures.push_back(std::async(
+              std::launch::async, [&results, i] { results[i] = work(i); }));
+        }
+        for (auto& future : futures) {
+            future.get();
+        }
+    });
+    printRow("std::async", asyncJobs, async);
+}
+
+/** Median and 99th percentile in microseconds. */
+static void printLatency(const char* method,
+                         std::vector<Clock::duration>& samples) {
+    std::sort(samples.begin(), samples.end());
+    auto microseconds = [](Clock::duration duration) {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    };
+    std::printf("%-24s %12.2f %12.2f\n",
+                method,
+                microseconds(samples[samples.size() / 2]),
+                microseconds(samples[samples.size() * 99 / 100]));
+}
+
+static void benchmarkLatency(FW::JobSystem& jobSystem, int rounds) {
+    std::vector<Clock::duration> samples(rounds);
+
+    for (int round = 0; round < rounds; round++) {
+        Clock::time_point started;
+        auto scheduled = Clock::now();
+        FW::JobHandle handle =
+          jobSystem.schedule([&started] { started = Clock::now(); });
+        jobSystem.wait(handle);
+        samples[round] = started - scheduled;
+    }
+    printLatency("JobSystem, waiter", samples);
+
+    // Spin instead of waiting, so a worker has to take the job
+    if (jobSystem.getWorkerCount() > 0) {
+        for (int round = 0; round < rounds; round++) {
+            std::atomic<Clock::rep> started = 0;
+            auto scheduled = Clock::now();
+            FW::JobHandle handle = jobSystem.schedule([&started] {
+                started = Clock::now().time_since_epoch().count();
+            });
+            while (started == 0) {
+                std::this_thread::yield();
+            }
+            jobSystem.wait(handle);
+            samples[round] =
+              Clock::duration(started) - scheduled.time_since_epoch();
+        }
+        printLatency("JobSystem, worker", samples);
+    }
+
+    for (int round = 0; round < rounds; round++) {
+        Clock::time_point started;
+        auto scheduled = Clock::now();
+        std::async(std::launch::async, [&started] {
+            started = Clock::now();
+        }).get();
+        samples[round] = started - scheduled;
+    }
+    printLatency("std::async", samples);
+}
+
+int main() {
+    FW::JobSystem& jobSystem = FW::JobSystem::get();
+    std::printf("Threads: %u\n\n", jobSystem.getThreadCount());
+
+    std::printf("%-24s %10s %12s %14s\n", "throughput", "jobs", "ms", "jobs/s");
+    for (std::size_t jobs : { 1'000, 10'000, 100'000 }) {
+        benchmarkThroughput(jobSystem, jobs);
+    }
+
+    std::printf("\n%-24s %12s %12s\n", "latency", "median us", "p99 us");
+    benchmarkLatency(jobSystem, 1000);
+
+    return 0;
+}
@@ -0,0 +1,151 @@
+#include "doctest/doctest.h"
+
+#include "JobSystem.h"
+#include "WorkStealingDeque.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_CASE("WorkStealingDeque pops LIFO, steals FIFO and grows") {
+    FW::WorkStealingDeque<int> deque(4);
+
+    for (int i = 0; i < 100; i++) {
+        deque.push(i);
+    }
+    CHECK(deque.size() == 100);
+
+    CHECK(deque.steal() == 0);
+    CHECK(deque.steal() == 1);
+    CHECK(deque.pop() == 99);
+    CHECK(deque.pop() == 98);
+    CHECK(deque.size() == 96);
+
+    while (deque.pop()) {
+    }
+    CHECK(deque.empty());
+    CHECK(!deque.steal());
+}
+
+TEST_CASE("WorkStealingDeque hands out every item once under contention") {
+    constexpr int count = 200000;
+    FW::WorkStealingDeque<int> deque;
+    std::vector<std::atomic<int>> taken(count);
+    std::atomic<bool> done = false;
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; t++) {
+        thieves.emplace_back([&] {
+            while (!done.load() || !deque.empty()) {
+                if (auto item = deque.steal()) {
+                    taken[*item]++;
+                }
+            }
+        });
+    }
+
+    // The owner interleaves pushes and pops, so it races the thieves for
+    // the last item
+    for (int i = 0; i < count; i++) {
+        deque.push(i);
+        if (i % 3 == 0) {
+            if (auto item = deque.pop()) {
+                taken[*item]++;
+            }
+        }
+    }
+    while (auto item = deque.pop()) {
+        taken[*item]++;
+    }
+    done = true;
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    int wrong = 0;
+    for (auto& t : taken) {
+        wrong += t.load() != 1;
+    }
+    CHECK(wrong == 0);
+}
+
+TEST_CASE("JobSystem runs scheduled jobs") {
+    for (uint32_t workers : { 0u, 1u, 4u }) {
+        CAPTURE(workers);
+        FW::JobSystem jobs(workers);
+
+        std::atomic<int> sum = 0;
+        FW::JobCounter counter;
+        for (int i = 1; i <= 1000; i++) {
+            jobs.schedule([&sum, i] { sum += i; }, counter);
+        }
+        jobs.wait(counter);
+        CHECK(counter.isDone());
+        CHECK(sum == 500500);
+
+        bool ran = false;
+        FW::JobHandle handle = jobs.schedule([&ran] { ran = true; });
+        jobs.wait(handle);
+        CHECK(ran);
+    }
+}
+
+TEST_CASE("JobSystem::parallelFor visits every index once") {
+    FW::JobSystem jobs(3);
+
+    for (std::size_t grainSize : { 0, 1, 7, 1000, 5000 }) {
+        CAPTURE(grainSize);
+        std::vector<int> visits(4321, 0);
+        jobs.parallelFor(
+          0, visits.size(), grainSize, [&](std::size_t begin, std::size_t end) {
+              for (std::size_t i = begin; i < end; i++) {
+                  visits[i]++;
+              }
+          });
+
+        CHECK(std::count(visits.begin(), visits.end(), 1) == visits.size());
+    }
+
+    int calls = 0;
+    jobs.parallelFor(5, 5, 0, [&](std::size_t, std::size_t) { calls++; });
+    CHECK(calls == 0);
+}
+
+TEST_CASE("JobSystem jobs can schedule and wait for jobs") {
+    FW::JobSystem jobs(2);
+    std::atomic<int> leaves = 0;
+
+    // Every job waits for its children, so a worker has to run other jobs
+    // while it waits.
+    FW::JobCounter counter;
+    for (int i = 0; i < 16; i++) {
+        jobs.schedule(
+          [&] {
+              jobs.parallelFor(
+                0, 64, 4, [&](std::size_t begin, std::size_t end) {
+                    leaves += static_cast<int>(end - begin);
+                });
+          },
+          counter);
+    }
+    jobs.wait(counter);
+
+    CHECK(leaves == 16 * 64);
+}
+
+TEST_CASE("JobSystem accepts jobs from threads without a deque") {
+    FW::JobSystem jobs(2);
+    std::atomic<int> ran = 0;
+
+    std::thread other([&] {
+        FW::JobCounter counter;
+        for (int i = 0; i < 100; i++) {
+            jobs.schedule([&ran] { ran++; }, counter);
+        }
+        jobs.wait(counter);
+    });
+    other.join();
+
+    CHECK(ran == 100);
+}
@@ -28,10 +28,34 @@ void FW::SceneNode::update(float delta) {
 
 void FW::SceneNode::addChild(ref<SceneNode> node) {
     childNodes.push_back(node);
+
+    if (renderQueue) {
+        node->setRenderQueue(renderQueue);
+    }
 }
 
 void FW::SceneNode::removeChild(ref<SceneNode> node) {
-    std::erase_if(childNodes, [&](const auto& childNode) {
+    removeChildrenIf([&](const ref<SceneNode>& childNode) {
         return childNode.get() == node.get();
     });
 }
+
+void FW::SceneNode::setRenderQueue(ref<RenderQueue> queue) {
+    if (renderQueue == queue) {
+        return;
+    }
+
+    if (entity) {
+        if (renderQueue) {
+            renderQueue->remove(entity.get());
+        }
+        if (queue) {
+            queue->add(entity.get());
+        }
+    }
+    renderQueue = queue;
+
+    for (auto& childNode : childNodes) {
+        childNode->setRenderQueue(queue);
+    }
+}
@@ -1,20 +1,55 @@
 #pragma once
 
 #include "Entity.h"
+#include "RenderQueue.h"
 #include "Viewport.h"
 
 #include <vector>
 
 namespace FW {
+    /**
+     * Node in the scene tree.
+     *
+     * Once a tree has been drawn by the \ref RenderSystem "RenderSystem", its
+     * nodes share a \ref RenderQueue "RenderQueue". Adding and removing
+     * children keeps the queue up to date, so `childNodes` should only be
+     * modified through addChild(), removeChild() and removeChildrenIf(). The
+     * entity must be assigned before the node is added to the tree.
+     */
     class SceneNode {
     public:
+        virtual ~SceneNode() = default;
+
         virtual void update(float delta);
         virtual void addChild(ref<SceneNode> node);
         virtual void removeChild(ref<SceneNode> node);
 
+        /** Remove every child node for which `predicate` returns true. */
+        template<typename Predicate>
+        void removeChildrenIf(Predicate predicate) {
+            std::erase_if(childNodes, [&](const ref<SceneNode>& node) {
+                if (!predicate(node)) {
+                    return false;
+                }
+                node->setRenderQueue(nullptr);
+                return true;
+            });
+        }
+
+        /**
+         * Register this node and all its descendants in `queue`, and
+         * unregister them from the previous one. Pass nullptr to only
+         * unregister.
+         */
+        void setRenderQueue(ref<RenderQueue> queue);
+        ref<RenderQueue> getRenderQueue() { return renderQueue; }
+
     public:
         ref<Entity> entity;
         std::vector<ref<SceneNode>> childNodes;
+
+    private:
+        ref<RenderQueue> renderQueue;
     };
 
     /** A scene is a game state. It is the overall supervisor of all things that
@@ -1,6 +1,7 @@
 #include "Component.h"
 #include "TextureManager.h"
 #include "ShaderManager.h"
+#include "ECS_Systems.h"
 
 #include "glm/gtc/matrix_transform.hpp"
 
@@ -14,10 +15,26 @@ void FW::DrawableComponent::setTexture(const std::string& name,
                                        const std::string& filepath) {
     material.getProperties().diffuseTextureID =
       FW::TextureManager::loadTexture2D(name, filepath);
+    uvRect = { 0.0f, 0.0f, 1.0f, 1.0f };
 }
 
 void FW::DrawableComponent::setTexture(const uint32_t id) {
     material.getProperties().diffuseTextureID = id;
+    uvRect = { 0.0f, 0.0f, 1.0f, 1.0f };
+}
+
+void FW::DrawableComponent::setTexture(const AtlasRegion& region) {
+    material.getProperties().diffuseTextureID = region.textureID;
+    uvRect = region.uvRect;
+}
+
+uint32_t FW::DrawableComponent::getShaderProgramID() {
+    if (shaderProgramID == 0) {
+        if (Shader* shaderRef = ShaderManager::get().getShader(shader)) {
+            shaderProgramID = shaderRef->shaderProgram;
+        }
+    }
+    return shaderProgramID;
 }
 
 void FW::DrawableComponent::draw() {
@@ -26,7 +43,15 @@ void FW::DrawableComponent::draw() {
         return;
     }
 
-    shaderRef->setFloat4("u_color", color);
+    if (uniformsProgramID != shaderRef->shaderProgram) {
+        colorUniform = shaderRef->getUniform<glm::vec4>("u_color");
+        shininessUniform = shaderRef->getUniform<float>("u_material.shininess");
+        uvRectUniform = shaderRef->getUniform<glm::vec4>("u_uvRect");
+        uniformsProgramID = shaderRef->shaderProgram;
+    }
+
+    shaderRef->setParam(colorUniform, color);
+    shaderRef->setParam(uvRectUniform, uvRect);
 
     // Upload material properties
     //        shader->setFloat3("u_material.ambient",
@@ -52,8 +77,7 @@ void FW::DrawableComponent::draw() {
         */
 
     // Shininess
-    shaderRef->setFloat("u_material.shininess",
-                        material.getProperties().shininess);
+    shaderRef->setParam(shininessUniform, material.getProperties().shininess);
 
     // Upload other parameters set by the user
     for (auto& [name, value] : shaderParams) {
@@ -70,10 +94,33 @@ void FW::DrawableComponent::draw() {
 void FW::DrawableComponent::setShaderParam(const std::string& name,
                                            const UniformType& value) {
     shaderParams[name] = value;
+    updateBatchable();
 }
 
 void FW::DrawableComponent::removeShaderParam(const std::string& name) {
     shaderParams.erase(name);
+    updateBatchable();
+}
+
+void FW::DrawableComponent::updateBatchable() {
+    batchable = shader == spriteShaderName && shaderParams.empty() &&
+                dynamic_cast<PrimitiveQuad*>(shape.get()) != nullptr;
+}
+
+FW::TransformationComponent::TransformationComponent(
+  std::string componentName)
+  : Component(componentName) {
+    markDirty();
+}
+
+FW::TransformationComponent::~TransformationComponent() {
+    TransformSystem::unqueue(this);
+    setParent(nullptr);
+
+    for (auto* child : children) {
+        child->parent = nullptr;
+        child->markDirty();
+    }
 }
 
 void FW::TransformationComponent::init() {}
@@ -84,13 +131,13 @@ void FW::TransformationComponent::update(float delta) {
 
 void FW::TransformationComponent::setPosition(glm::vec3 position) {
     this->position = position;
-    recalculateModelMatrix();
+    markDirty();
 }
 
 void FW::TransformationComponent::setPosition(glm::vec2 position) {
     this->position.x = position.x;
     this->position.y = position.y;
-    recalculateModelMatrix();
+    markDirty();
 }
 
 void FW::TransformationComponent::setPosition(float x, float y, float z) {
@@ -105,39 +152,127 @@ void FW::TransformationComponent::setScale(float x, float y, float z) {
     scale.x = x;
     scale.y = y;
     scale.z = z;
-    recalculateModelMatrix();
+    markDirty();
+}
+
+void FW::TransformationComponent::setRotation(float yaw,
+                                              float pitch,
+                                              float roll) {
+    this->yaw = yaw;
+    this->pitch = pitch;
+    this->roll = roll;
+    markDirty();
+}
+
+void FW::TransformationComponent::setParent(TransformationComponent* parent) {
+    if (this->parent == parent) {
+        return;
+    }
+
+    if (this->parent) {
+        auto& siblings = this->parent->children;
+        siblings.erase(std::find(siblings.begin(), siblings.end(), this));
+    }
+
+    this->parent = parent;
+    if (parent) {
+        parent->children.push_back(this);
+    }
+
+    // The local matrix is unchanged, but the world matrix is not
+    dirty = true;
+    if (dirtyIndex == -1) {
+        TransformSystem::queue(this);
+    }
+}
+
+const glm::mat4& FW::TransformationComponent::getLocalMatrix() {
+    if (localDirty) {
+        recalculateLocalMatrix();
+    }
+    return localMatrix;
+}
+
+const glm::mat4& FW::TransformationComponent::getWorldMatrix() {
+    resolveDirtyAncestors();
+    return worldMatrix;
 }
 
 void FW::TransformationComponent::uploadTransformationMatrix() {
-    recalculateModelMatrix();
     auto shaderRef = ShaderManager::get().bind(shader);
     if (!shaderRef) {
         return;
     }
 
-    shaderRef->setMat4("u_model", modelMatrix);
+    shaderRef->setParam("u_model", getWorldMatrix());
 }
 
-void FW::TransformationComponent::recalculateModelMatrix() {
-    modelMatrix = glm::mat4(1.0f);
-    // Translation
+void FW::TransformationComponent::markDirty() {
+    localDirty = true;
+    dirty = true;
+    if (dirtyIndex == -1) {
+        TransformSystem::queue(this);
+    }
+}
 
-    glm::mat4 newRotation, rotx, roty, rotz;
+void FW::TransformationComponent::updateHierarchy(bool parentChanged) {
+    if (!dirty && !parentChanged) {
+        return;
+    }
 
-    // Rotation
-    rotx = glm::rotate(modelMatrix, yaw, { 1.0f, 0.0f, 0.0f });
-    roty = glm::rotate(modelMatrix, pitch, { 0.0f, 1.0f, 0.0f });
-    rotz = glm::rotate(modelMatrix, roll, { 0.0f, 0.0f, 1.0f });
+    if (localDirty) {
+        recalculateLocalMatrix();
+    }
 
-    newRotation = rotx * roty * rotz;
+    worldMatrix = parent ? parent->worldMatrix * localMatrix : localMatrix;
+    dirty = false;
 
-    modelMatrix = glm::translate(modelMatrix, position) * newRotation *
-                  glm::scale(modelMatrix, scale);
+    for (auto* child : children) {
+        child->updateHierarchy(true);
+    }
 }
 
-void FW::PhysicsComponent::update(float delta) {
-    // Gravity
-    // velocity.y -= gravity;
+void FW::TransformationComponent::resolveDirtyAncestors() {
+    // Start from the topmost dirty ancestor, as everything below it has to
+    // be recomputed anyway
+    TransformationComponent* top = nullptr;
+    for (auto* node = this; node; node = node->parent) {
+        if (node->dirty) {
+            top = node;
+        }
+    }
+
+    if (top) {
+        top->updateHierarchy(true);
+    }
+}
+
+void FW::TransformationComponent::recalculateLocalMatrix() {
+    localMatrix = glm::mat4(1.0f);
+
+    // Rotation. Most entities are 2D sprites that only rotate around Z, so
+    // skip the general case when possible.
+    if (yaw == 0.0f && pitch == 0.0f) {
+        if (roll != 0.0f) {
+            float c = std::cos(roll);
+            float s = std::sin(roll);
+            localMatrix[0] = glm::vec4{ c, s, 0.0f, 0.0f };
+            localMatrix[1] = glm::vec4{ -s, c, 0.0f, 0.0f };
+        }
+    } else {
+        localMatrix = glm::rotate(localMatrix, yaw, { 1.0f, 0.0f, 0.0f });
+        localMatrix = glm::rotate(localMatrix, pitch, { 0.0f, 1.0f, 0.0f });
+        localMatrix = glm::rotate(localMatrix, roll, { 0.0f, 0.0f, 1.0f });
+    }
+
+    // Scale and translation only touch one column each, so there is no
+    // need for full matrix products
+    localMatrix[0] *= scale.x;
+    localMatrix[1] *= scale.y;
+    localMatrix[2] *= scale.z;
+    localMatrix[3] = glm::vec4{ position, 1.0f };
+
+    localDirty = false;
 }
 
 void FW::PhysicsComponent::setVelocity(float x, float y, float z) {
@@ -5,6 +5,7 @@
 #include "Shape.h"
 #include "Shader.h"
 #include "Material.h"
+#include "TextureAtlas.h"
 
 namespace FW {
 
@@ -43,10 +44,38 @@ namespace FW {
         virtual void init() override;
         virtual void update(float delta) override;
 
-        void setShape(ref<Shape> shape) { this->shape = shape; }
-        void setShader(std::string shader) { this->shader = shader; }
+        void setShape(ref<Shape> shape) {
+            this->shape = shape;
+            updateBatchable();
+        }
+        const ref<Shape>& getShape() const { return shape; }
+
+        void setShader(std::string shader) {
+            this->shader = shader;
+            shaderProgramID = 0;
+            uniformsProgramID = 0;
+            updateBatchable();
+        }
         std::string getShader() { return shader; }
 
+        /**
+         * Get the OpenGL program of the shader, used to group draws that share
+         * it. Returns 0 if the shader has not been created yet.
+         */
+        uint32_t getShaderProgramID();
+
+        /**
+         * Return true if the drawable can be drawn by the \ref SpriteBatch
+         * "SpriteBatch" instead of on its own: it is a quad drawn with the
+         * built-in sprite shader and without custom shader parameters.
+         */
+        bool isBatchable() const { return batchable; }
+
+        /** Get the diffuse texture's ID, used to group draws that share it. */
+        uint32_t getTextureID() {
+            return material.getProperties().diffuseTextureID;
+        }
+
         /** Create a new texture.
          *
          * This method creates new texture resources. The \param name "name" is
@@ -68,6 +97,20 @@ namespace FW {
          */
         void setTexture(const uint32_t id);
 
+        /**
+         * Sample part of an atlas page instead of a whole texture.
+         *
+         * @param region The image to apply. See \ref TextureAtlas
+         * "TextureAtlas".
+         */
+        void setTexture(const AtlasRegion& region);
+
+        /**
+         * Get the part of the texture that is sampled: min UV in xy, max UV
+         * in zw. The whole texture unless an atlas region was applied.
+         */
+        const glm::vec4& getUVRect() const { return uvRect; }
+
         void draw();
 
         /**
@@ -101,25 +144,58 @@ namespace FW {
         }
 
     public:
+        /** Name of the built-in shader used by Sprite and UI elements. */
+        static constexpr const char* spriteShaderName = "inbuilt_ecs_shader";
+
         glm::vec4 color{ 1.0f };
         uint32_t Z_index = 0;
         bool isTransparent = false;
 
+    private:
+        void updateBatchable();
+
     private:
         ref<Shape> shape;
         std::string shader;
+        /// Cached lookup of `shader`. Reset whenever the shader changes.
+        uint32_t shaderProgramID = 0;
+
+        /// Program the uniform handles below were resolved against.
+        uint32_t uniformsProgramID = 0;
+        UniformHandle<glm::vec4> colorUniform;
+        UniformHandle<float> shininessUniform;
+        UniformHandle<glm::vec4> uvRectUniform;
         Material material;
+        glm::vec4 uvRect{ 0.0f, 0.0f, 1.0f, 1.0f };
         GLenum drawType;
+        bool batchable = false;
 
         std::unordered_map<std::string, UniformType> shaderParams;
     };
 
+    /**
+     * Position, rotation and scale of an Entity.
+     *
+     * The local matrix is only rebuilt after one of the setters has been
+     * called, and the world matrix only when this transform or one of its
+     * ancestors changed. Changed transforms are queued and recomputed in one
+     * pass by \ref TransformSystem "TransformSystem", so transforms that
+     * never move cost nothing per frame.
+     *
+     * When an Entity with a transform is added as a child of another Entity
+     * with a transform, the child transform becomes relative to the parent.
+     */
     class TransformationComponent : public Component {
     public:
         TransformationComponent()
-          : Component("TransformationComponent") {}
-        TransformationComponent(std::string componentName)
-          : Component(componentName) {}
+          : TransformationComponent("TransformationComponent") {}
+        TransformationComponent(std::string componentName);
+        virtual ~TransformationComponent();
+
+        /** The transform is tracked by address, so it cannot be copied. */
+        TransformationComponent(const TransformationComponent&) = delete;
+        TransformationComponent& operator=(const TransformationComponent&) =
+          delete;
 
         virtual void init() override;
         virtual void update(float delta) override;
@@ -136,28 +212,62 @@ namespace FW {
         glm::vec3 getScale() { return scale; }
         glm::vec2 getScale2D() { return glm::vec2(scale); }
 
-        void setRotation(float yaw, float pitch, float roll) {
-            this->yaw = yaw;
-            this->pitch = pitch;
-            this->roll = roll;
-        }
-        glm::vec3 getRotation() { return rotation; }
+        void setRotation(float yaw, float pitch, float roll);
+        glm::vec3 getRotation() { return glm::vec3{ yaw, pitch, roll }; }
+
+        /**
+         * Make this transform relative to `parent`. Pass nullptr to detach.
+         *
+         * This is normally handled by Entity::addChild().
+         */
+        void setParent(TransformationComponent* parent);
+        TransformationComponent* getParent() { return parent; }
 
-        /** Recalculate and upload the transformation matrix to the GPU. */
+        /** Matrix relative to the parent. */
+        const glm::mat4& getLocalMatrix();
+
+        /** Matrix relative to the world, including all ancestors. */
+        const glm::mat4& getWorldMatrix();
+
+        /** Return true if the world matrix has to be recomputed. */
+        bool isDirty() const { return dirty; }
+
+        /** Upload the world matrix to the GPU. */
         void uploadTransformationMatrix();
 
     private:
-        // TODO find some way to only recalculate model matrix once per frame.
-        void recalculateModelMatrix();
+        friend class TransformSystem;
+
+        /** Flag the transform and queue it for the next update pass. */
+        void markDirty();
+
+        /** Recompute the world matrix of this transform and its subtree. */
+        void updateHierarchy(bool parentChanged);
+
+        /** Bring the world matrix up to date outside the update pass. */
+        void resolveDirtyAncestors();
+
+        void recalculateLocalMatrix();
 
     private:
         // Transformation
-        glm::mat4 modelMatrix;
+        glm::mat4 localMatrix{ 1.0f };
+        glm::mat4 worldMatrix{ 1.0f };
         std::string shader;
         glm::vec3 position{ 0.0f };
         float yaw = 0.0f, pitch = 0.0f, roll = 0.0f;
         glm::vec3 scale = glm::vec3{ 1.0f };
-        glm::vec3 rotation = glm::vec3{ 0.0f };
+
+        // Hierarchy
+        TransformationComponent* parent = nullptr;
+        std::vector<TransformationComponent*> children;
+
+        /// The world matrix is out of date.
+        bool dirty = false;
+        /// The local matrix is out of date.
+        bool localDirty = false;
+        /// Position in the TransformSystem queue, or -1 if not queued.
+        int dirtyIndex = -1;
     };
 
     /**
@@ -165,6 +275,8 @@ namespace FW {
      *
      * This class is tightly coupled with the Framework's Physics module. It
      * acts as an adapter and enables entities to have physics properties.
+     * It does not move the entity, bodies added to a Physics::Solver are
+     * integrated by the solver.
      */
     class PhysicsComponent : public Component {
     public:
@@ -174,7 +286,7 @@ namespace FW {
           : Component(name) {}
 
         virtual void init() override {};
-        virtual void update(float delta) override;
+        virtual void update(float delta) override {};
 
         /**
          * Update the current velocity with new values. To add velocity, see
@@ -186,7 +298,6 @@ namespace FW {
         void addVelocity(float x, float y);
 
     private:
-        float gravity = 9.8067f;
         glm::vec3 velocity{ 0.0f };
     };
 
@@ -0,0 +1,201 @@
+#include "ComponentStorage.h"
+#include "Entity.h"
+
+#include "assertions.h"
+
+namespace FW {
+#pragma region ComponentPool
+    ComponentPool::ComponentPool(std::size_t slotSize,
+                                 std::size_t slotAlignment)
+      : slotSize(std::max(slotSize, sizeof(void*))),
+        slotAlignment(std::max(slotAlignment, alignof(void*))) {
+        // Round up so every slot in the chunk stays aligned
+        this->slotSize = (this->slotSize + this->slotAlignment - 1) /
+                         this->slotAlignment * this->slotAlignment;
+    }
+
+    ComponentPool::~ComponentPool() {
+        for (std::byte* chunk : chunks) {
+            ::operator delete(chunk, std::align_val_t(slotAlignment));
+        }
+    }
+
+    void* ComponentPool::allocate() {
+        liveSlots++;
+
+        if (freeList) {
+            void* slot = freeList;
+            freeList = *static_cast<void**>(slot);
+            return slot;
+        }
+
+        if (bumpIndex == slotsPerChunk) {
+            chunks.push_back(static_cast<std::byte*>(::operator new(
+              slotSize * slotsPerChunk, std::align_val_t(slotAlignment))));
+            bumpIndex = 0;
+        }
+
+        return chunks.back() + slotSize * bumpIndex++;
+    }
+
+    void ComponentPool::deallocate(void* slot) {
+        liveSlots--;
+        *static_cast<void**>(slot) = freeList;
+        freeList = slot;
+    }
+#pragma endregion
+
+#pragma region ComponentTypeID
+    ComponentTypeID getComponentTypeID(std::type_index type) {
+        static std::unordered_map<std::type_index, ComponentTypeID> ids;
+
+        auto [it, inserted] =
+          ids.try_emplace(type, static_cast<ComponentTypeID>(ids.size()));
+        ASSERT(it->second < maxComponentTypes,
+               "Too many component types for the component mask.");
+        return it->second;
+    }
+#pragma endregion
+
+#pragma region Archetype
+    Archetype::Archetype(ComponentMask signature)
+      : signature(signature) {
+        columns.resize(std::popcount(signature));
+    }
+#pragma endregion
+
+#pragma region ComponentStorage
+    ComponentStorage::ComponentStorage() {
+        emptyArchetype = findOrCreateArchetype(0);
+    }
+
+    void ComponentStorage::addEntity(Entity* entity) {
+        entity->archetype = emptyArchetype;
+        entity->componentMask = 0;
+        entity->archetypeRow = emptyArchetype->entities.size();
+        emptyArchetype->entities.push_back(entity);
+    }
+
+    void ComponentStorage::removeEntity(Entity* entity) {
+        if (!entity->archetype) {
+            return;
+        }
+        removeRow(entity->archetype, entity->archetypeRow);
+        entity->archetype = nullptr;
+        entity->componentMask = 0;
+    }
+
+    bool ComponentStorage::addComponent(Entity* entity,
+                                        ComponentTypeID id,
+                                        ref<Component> component) {
+        Archetype* current = entity->archetype;
+        ASSERT(current != nullptr, "Entity is not registered in the storage.");
+
+        if (current->signature & (ComponentMask(1) << id)) {
+            return false;
+        }
+
+        Archetype*& target = current->addEdges[id];
+        if (!target) {
+            target = findOrCreateArchetype(current->signature |
+                                           (ComponentMask(1) << id));
+            target->removeEdges[id] = current;
+        }
+
+        moveEntity(entity, target, id, std::move(component));
+        return true;
+    }
+
+    void ComponentStorage::removeComponent(Entity* entity, ComponentTypeID id) {
+        Archetype* current = entity->archetype;
+        if (!current || !(current->signature & (ComponentMask(1) << id))) {
+            return;
+        }
+
+        Archetype*& target = current->removeEdges[id];
+        if (!target) {
+            target = findOrCreateArchetype(current->signature &
+                                           ~(ComponentMask(1) << id));
+            target->addEdges[id] = current;
+        }
+
+        moveEntity(entity, target, id, nullptr);
+    }
+
+    void ComponentStorage::removeComponent(Entity* entity,
+                                           const Component* component) {
+        Archetype* current = entity->archetype;
+        if (!current) {
+            return;
+        }
+
+        ComponentMask remaining = current->signature;
+        for (std::size_t i = 0; remaining; i++) {
+            ComponentTypeID id = std::countr_zero(remaining);
+            remaining &= remaining - 1;
+
+            if (current->columns[i][entity->archetypeRow].get() == component) {
+                removeComponent(entity, id);
+                return;
+            }
+        }
+    }
+
+    Archetype* ComponentStorage::findOrCreateArchetype(
+      ComponentMask signature) {
+        auto& archetype = archetypes[signature];
+        if (!archetype) {
+            archetype = createScope<Archetype>(signature);
+        }
+        return archetype.get();
+    }
+
+    void ComponentStorage::moveEntity(Entity* entity,
+                                      Archetype* target,
+                                      ComponentTypeID extraID,
+                                      ref<Component> extra) {
+        Archetype* source = entity->archetype;
+        std::size_t sourceRow = entity->archetypeRow;
+
+        ComponentMask remaining = target->signature;
+        for (std::size_t i = 0; remaining; i++) {
+            ComponentTypeID id = std::countr_zero(remaining);
+            remaining &= remaining - 1;
+
+            if (id == extraID) {
+                target->columns[i].push_back(std::move(extra));
+            } else {
+                int sourceColumn = FW::getColumnIndex(source->signature, id);
+                target->columns[i].push_back(
+                  std::move(source->columns[sourceColumn][sourceRow]));
+            }
+        }
+
+        removeRow(source, sourceRow);
+
+        entity->archetype = target;
+        entity->componentMask = target->signature;
+        entity->archetypeRow = target->entities.size();
+        target->entities.push_back(entity);
+    }
+
+    void ComponentStorage::removeRow(Archetype* archetype, std::size_t row) {
+        std::size_t last = archetype->entities.size() - 1;
+
+        if (row != last) {
+            Entity* moved = archetype->entities[last];
+            archetype->entities[row] = moved;
+            moved->archetypeRow = row;
+
+            for (auto& column : archetype->columns) {
+                column[row] = std::move(column[last]);
+            }
+        }
+
+        archetype->entities.pop_back();
+        for (auto& column : archetype->columns) {
+            column.pop_back();
+        }
+    }
+#pragma endregion
+} // namespace FW
@@ -0,0 +1,306 @@
+#pragma once
+
+#include "pch.h"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <typeindex>
+#include <unordered_map>
+
+#include "Component.h"
+
+namespace FW {
+    class Entity;
+
+    /** Dense integer identifying a component class. */
+    using ComponentTypeID = std::uint32_t;
+
+    /** One bit per \ref ComponentTypeID "ComponentTypeID". */
+    using ComponentMask = std::uint64_t;
+
+    constexpr ComponentTypeID maxComponentTypes = 64;
+
+    /**
+     * Get the ID registered for a component type, assigning the next free one
+     * on first use.
+     *
+     * This is the slow path, backed by a map keyed on `std::type_index`. It
+     * exists so components added through a `ref<Component>` resolve to the
+     * same ID as the templated API.
+     */
+    ComponentTypeID getComponentTypeID(std::type_index type);
+
+    /**
+     * Get the ID of component type `T`.
+     *
+     * The ID is looked up once per type and cached in a function-local
+     * static, so subsequent calls are a single load.
+     */
+    template<typename T>
+    ComponentTypeID componentTypeID() {
+        static_assert(std::is_base_of_v<Component, T>);
+        static const ComponentTypeID id = getComponentTypeID(typeid(T));
+        return id;
+    }
+
+    /** Get the bit of component type `T`. */
+    template<typename T>
+    ComponentMask componentMask() {
+        return ComponentMask(1) << componentTypeID<T>();
+    }
+
+    /**
+     * Column of the component with `id` in an archetype whose signature is
+     * `mask`. Columns are ordered by ID, so this is the number of set bits
+     * below `id`.
+     */
+    inline int getColumnIndex(ComponentMask mask, ComponentTypeID id) {
+        return std::popcount(mask & ((ComponentMask(1) << id) - 1));
+    }
+
+    /**
+     * Fixed-size block allocator for components of a single type.
+     *
+     * Memory is reserved in chunks of `slotsPerChunk` slots, so components of
+     * the same type end up next to each other instead of being scattered
+     * across the heap. Freed slots are recycled in LIFO order.
+     */
+    class ComponentPool {
+    public:
+        ComponentPool(std::size_t slotSize, std::size_t slotAlignment);
+        ~ComponentPool();
+
+        ComponentPool(const ComponentPool&) = delete;
+        ComponentPool& operator=(const ComponentPool&) = delete;
+
+        void* allocate();
+        void deallocate(void* slot);
+
+        /** Number of slots currently handed out. */
+        [[nodiscard]] std::size_t size() const { return liveSlots; }
+
+        /** Number of chunks reserved by the pool. */
+        [[nodiscard]] std::size_t chunkCount() const { return chunks.size(); }
+
+    public:
+        static constexpr std::size_t slotsPerChunk = 256;
+
+    private:
+        std::size_t slotSize;
+        std::size_t slotAlignment;
+        std::size_t liveSlots = 0;
+
+        /// Next unused slot in the newest chunk.
+        std::size_t bumpIndex = slotsPerChunk;
+
+        /// Intrusive free list threaded through the released slots.
+        void* freeList = nullptr;
+
+        std::vector<std::byte*> chunks;
+    };
+
+    /**
+     * Get the pool shared by every object of type `T`.
+     *
+     * The pool is intentionally never destroyed. Components may still be
+     * referenced by static objects while the program is shutting down, and
+     * the memory is released by the OS anyway.
+     */
+    template<typename T>
+    ComponentPool& getComponentPool() {
+        static ComponentPool* pool = new ComponentPool(sizeof(T), alignof(T));
+        return *pool;
+    }
+
+    /**
+     * Standard allocator that routes single-object allocations through
+     * `getComponentPool()`. Used together with `std::allocate_shared` so the
+     * control block and component are placed in one pooled slot.
+     */
+    template<typename T>
+    struct ComponentAllocator {
+        using value_type = T;
+
+        ComponentAllocator() = default;
+        template<typename U>
+        ComponentAllocator(const ComponentAllocator<U>&) {}
+
+        T* allocate(std::size_t n) {
+            if (n != 1) {
+                return std::allocator<T>().allocate(n);
+            }
+            return static_cast<T*>(getComponentPool<T>().allocate());
+        }
+
+        void deallocate(T* p, std::size_t n) {
+            if (n != 1) {
+                std::allocator<T>().deallocate(p, n);
+                return;
+            }
+            getComponentPool<T>().deallocate(p);
+        }
+
+        template<typename U>
+        bool operator==(const ComponentAllocator<U>&) const {
+            return true;
+        }
+    };
+
+    /**
+     * Create a pooled component.
+     *
+     * Behaves like `createRef<T>()`, but the component is placed in its
+     * type's \ref ComponentPool "ComponentPool". Prefer this over
+     * `createRef()` for anything that is added to an Entity.
+     */
+    template<typename T, typename... Args>
+    ref<T> createComponent(Args&&... args) {
+        return std::allocate_shared<T>(ComponentAllocator<T>(),
+                                       std::forward<Args>(args)...);
+    }
+
+    /**
+     * A table of all entities sharing the exact same set of component types.
+     *
+     * Every component type in the signature owns a column, ordered by type
+     * ID. Row `i` of each column belongs to `entities[i]`, so iterating a
+     * column visits the components of that type back to back.
+     */
+    class Archetype {
+    public:
+        explicit Archetype(ComponentMask signature);
+
+        ComponentMask getSignature() const { return signature; }
+        const std::vector<Entity*>& getEntities() const { return entities; }
+        std::size_t size() const { return entities.size(); }
+
+        /** Return the column index for `id`, or -1 if it is not stored. */
+        int getColumnIndex(ComponentTypeID id) const {
+            if (!(signature & (ComponentMask(1) << id))) {
+                return -1;
+            }
+            return FW::getColumnIndex(signature, id);
+        }
+
+        std::vector<ref<Component>>& getColumn(int index) {
+            return columns[index];
+        }
+
+    private:
+        friend class ComponentStorage;
+        friend class Entity;
+
+        ComponentMask signature;
+        std::vector<Entity*> entities;
+        std::vector<std::vector<ref<Component>>> columns;
+
+        /** Cached transitions to neighbouring archetypes, indexed by ID. */
+        std::array<Archetype*, maxComponentTypes> addEdges{};
+        std::array<Archetype*, maxComponentTypes> removeEdges{};
+    };
+
+    /**
+     * Owner of all archetypes.
+     *
+     * Entities register themselves on construction and are moved between
+     * archetypes when components are added or removed. The columns share
+     * ownership of the components with the entity, so a lookup can hand out
+     * a reference without searching the entity.
+     *
+     * Like the component pools, the instance is never destroyed so entities
+     * held by static objects can still unregister during shutdown.
+     */
+    class ComponentStorage {
+    public:
+        static ComponentStorage& get() {
+            static ComponentStorage* s = new ComponentStorage();
+            return *s;
+        }
+
+        ComponentStorage(const ComponentStorage&) = delete;
+        ComponentStorage& operator=(const ComponentStorage&) = delete;
+
+        /** Place a new entity in the empty archetype. */
+        void addEntity(Entity* entity);
+
+        /** Remove an entity and all its component references. */
+        void removeEntity(Entity* entity);
+
+        /**
+         * Register a component with type `id` on `entity`.
+         *
+         * @return false if the entity already has a component of that type.
+         */
+        bool addComponent(Entity* entity,
+                          ComponentTypeID id,
+                          ref<Component> component);
+
+        void removeComponent(Entity* entity, ComponentTypeID id);
+
+        /** Remove `component` from `entity`, whatever type it is stored as. */
+        void removeComponent(Entity* entity, const Component* component);
+
+        /**
+         * Call `func(Entity&, Ts&...)` for every entity that has all the
+         * given component types. Matching archetypes are visited one at a
+         * time, column by column.
+         *
+         * Do not add or remove components from within `func`.
+         */
+        template<typename... Ts, typename Func>
+        void each(Func&& func) {
+            const ComponentMask required = (componentMask<Ts>() | ...);
+            for (auto& [signature, archetype] : archetypes) {
+                if ((signature & required) != required) {
+                    continue;
+                }
+                int indices[] = { FW::getColumnIndex(
+                  signature, componentTypeID<Ts>())... };
+                eachInArchetype<Ts...>(*archetype,
+                                       indices,
+                                       func,
+                                       std::index_sequence_for<Ts...>{});
+            }
+        }
+
+        std::size_t getArchetypeCount() const { return archetypes.size(); }
+
+    private:
+        ComponentStorage();
+        ~ComponentStorage() = default;
+
+        Archetype* findOrCreateArchetype(ComponentMask signature);
+
+        /**
+         * Move `entity` to `target`. Components whose type exist in both
+         * archetypes are carried over; `extra` fills the column of `extraID`
+         * if given.
+         */
+        void moveEntity(Entity* entity,
+                        Archetype* target,
+                        ComponentTypeID extraID,
+                        ref<Component> extra);
+
+        /** Swap-remove a row and fix up the moved entity's row index. */
+        void removeRow(Archetype* archetype, std::size_t row);
+
+        template<typename... Ts, typename Func, std::size_t... I>
+        void eachInArchetype(Archetype& archetype,
+                             const int* indices,
+                             Func& func,
+                             std::index_sequence<I...>) {
+            auto& entities = archetype.entities;
+            for (std::size_t row = 0; row < entities.size(); row++) {
+                func(*entities[row],
+                     *static_cast<Ts*>(
+                       archetype.columns[indices[I]][row].get())...);
+            }
+        }
+
+    private:
+        std::unordered_map<ComponentMask, scope<Archetype>> archetypes;
+        Archetype* emptyArchetype = nullptr;
+    };
+} // namespace FW
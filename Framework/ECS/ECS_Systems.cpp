@@ -1,69 +1,149 @@
 #include "ECS_Systems.h"
+#include "ShaderManager.h"
+#include "RenderState.h"
+#include "TextureManager.h"
 
 #include <algorithm>
 
 namespace FW {
-    void fetchEntities(ref<SceneNode> sceneRoot,
-                       std::vector<Entity*>& entities) {
-        if (sceneRoot->entity) {
-            auto drawableComponent =
-              sceneRoot->entity->getComponent<TransformationComponent>();
-            if (drawableComponent) {
-                entities.push_back(sceneRoot->entity.get());
+    void TransformSystem::flush() {
+        for (auto* transform : dirtyTransforms) {
+            if (transform->dirty) {
+                transform->resolveDirtyAncestors();
             }
         }
 
-        for (auto& node : sceneRoot->childNodes) {
-            fetchEntities(node, entities);
+        for (auto* transform : dirtyTransforms) {
+            transform->dirtyIndex = -1;
         }
+        dirtyTransforms.clear();
+    }
+
+    void TransformSystem::queue(TransformationComponent* transform) {
+        transform->dirtyIndex = static_cast<int>(dirtyTransforms.size());
+        dirtyTransforms.push_back(transform);
+    }
+
+    void TransformSystem::unqueue(TransformationComponent* transform) {
+        if (transform->dirtyIndex == -1) {
+            return;
+        }
+
+        auto* last = dirtyTransforms.back();
+        dirtyTransforms[transform->dirtyIndex] = last;
+        last->dirtyIndex = transform->dirtyIndex;
+        dirtyTransforms.pop_back();
+        transform->dirtyIndex = -1;
     }
 
     RenderSystem::RenderSystem() {}
 
     void RenderSystem::draw(ref<SceneNode> sceneRoot) {
-        // The draw algorithm separates transparent and opaque entities. This
-        // means we can enable blend onlny for the transparent objects.
-        
-        std::vector<Entity*> drawableEntities;
-        std::size_t reserveNumber = 20;
-        // Change the number to increase how many entities to increase by.
-        drawableEntities.reserve(reserveNumber);
-
-        fetchEntities(sceneRoot, drawableEntities);
-
-        std::sort(drawableEntities.begin(),
-                  drawableEntities.end(),
-                  [](Entity* a, Entity* b) {
-                      return a->getComponent<DrawableComponent>()->Z_index <
-                             b->getComponent<DrawableComponent>()->Z_index;
-                  });
-
-        std::vector<Entity*> opaqueEntities;
-        opaqueEntities.reserve(reserveNumber);
-        std::vector<Entity*> transparentEntities;
-        transparentEntities.reserve(reserveNumber);
-
-        for (const auto& entity : drawableEntities) {
-            if (entity->getComponent<DrawableComponent>()->isTransparent) {
-                transparentEntities.push_back(entity);
-            } else {
-                opaqueEntities.push_back(entity);
+        TransformSystem::flush();
+        TextureManager::processUploads();
+
+        RenderState& state = RenderState::get();
+        state.resetStatistics();
+
+        // The first draw registers the whole tree. From then on, the queue
+        // is kept up to date as nodes are added and removed.
+        if (!sceneRoot->getRenderQueue()) {
+            sceneRoot->setRenderQueue(createRef<RenderQueue>());
+        }
+
+        // Drawables outside the view are left out before they are sorted
+        bool culling = camera && frustumCulling;
+        Frustum frustum = culling ? camera->getViewFrustum() : Frustum{};
+        auto& queue = *sceneRoot->getRenderQueue();
+        queue.prepare(culling ? &frustum : nullptr);
+
+        Shader* batchShader = nullptr;
+        if (camera) {
+            if (!spriteBatch) {
+                spriteBatch = createScope<SpriteBatch>();
+                ShaderManager::get().createShaderFromFiles(
+                  "inbuilt_sprite_batch",
+                  SHADERS_DIR + std::string("SpriteBatch.vs"),
+                  SHADERS_DIR + std::string("SpriteBatch.fs"));
             }
+            batchShader = ShaderManager::get().getShader("inbuilt_sprite_batch");
+            camera->bindUniformBuffer();
+            spriteBatch->resetStatistics();
+        } else {
+            // Sprites are drawn in clip space
+            Camera::bindIdentityUniformBuffer();
+        }
+
+        statistics = Statistics{};
+        statistics.culledDrawables = (uint32_t)queue.getCulledCount();
+        uint32_t unbatchedDraws = 0;
+        bool isBatching = false;
+
+        // Opaque items are sorted first. Blending is only enabled once we
+        // reach the transparent ones.
+        bool isBlending = false;
+        for (const auto& item : queue.getItems()) {
+            if (!item.entity) {
+                continue;
+            }
+
+            auto* transform = item.entity->get<TransformationComponent>();
+            auto* drawable = item.entity->get<DrawableComponent>();
+
+            statistics.visibleDrawables++;
+
+            if (!isBlending && (item.key & RenderQueue::transparentBit)) {
+                // Pending quads belong to the opaque pass
+                if (isBatching) {
+                    spriteBatch->end();
+                    isBatching = false;
+                }
+
+                isBlending = true;
+                state.setBlend(true);
+                state.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                state.setDepthMask(false);
+            }
+
+            if (batchShader && drawable->isBatchable()) {
+                if (!isBatching) {
+                    spriteBatch->begin(batchShader);
+                    isBatching = true;
+                }
+                spriteBatch->submit(transform->getWorldMatrix(),
+                                    drawable->color,
+                                    drawable->getTextureID(),
+                                    drawable->getUVRect());
+                continue;
+            }
+
+            // Keep the draw order: everything batched so far goes first
+            if (isBatching) {
+                spriteBatch->end();
+                isBatching = false;
+            }
+
+            transform->uploadTransformationMatrix();
+            drawable->draw();
+            unbatchedDraws++;
+        }
+
+        if (isBatching) {
+            spriteBatch->end();
         }
 
-        for (const auto& entity : opaqueEntities) {
-            entity->getComponent<TransformationComponent>()
-              ->uploadTransformationMatrix();
-            entity->getComponent<DrawableComponent>()->draw();
+        // Restore the depth mask, or the next clear would skip the depth
+        // buffer
+        if (isBlending) {
+            state.setDepthMask(true);
         }
 
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glDepthMask(GL_FALSE);
-        for (const auto& entity : transparentEntities) {
-            entity->getComponent<TransformationComponent>()
-              ->uploadTransformationMatrix();
-            entity->getComponent<DrawableComponent>()->draw();
+        statistics.drawCalls = unbatchedDraws;
+        if (spriteBatch && batchShader) {
+            statistics.drawCalls += spriteBatch->getStatistics().drawCalls;
+            statistics.batchedSprites = spriteBatch->getStatistics().quadCount;
         }
+        statistics.stateChanges = state.getStatistics().issued;
+        statistics.skippedStateChanges = state.getStatistics().skipped;
     }
 }
\ No newline at end of file
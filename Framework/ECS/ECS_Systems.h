@@ -2,6 +2,8 @@
 
 #include "BaseScene.h"
 #include "Entity.h"
+#include "SpriteBatch.h"
+#include "Camera/Camera.h"
 
 #include <vector>
 
@@ -14,12 +16,80 @@ namespace FW {
         virtual void update(float delta) = 0;
     };
 
+    /**
+     * Recomputes the world matrices of transforms that changed.
+     *
+     * Transforms queue themselves when one of their setters is called. The
+     * queue is processed once per frame, and each changed subtree is
+     * recomputed from its topmost changed node, so nothing is computed twice.
+     * RenderSystem::draw() runs this pass before drawing.
+     */
+    class TransformSystem : public BaseSystem {
+    public:
+        virtual void update(float delta) override { flush(); }
+
+        /** Recompute all queued transforms and empty the queue. */
+        static void flush();
+
+        /** Number of transforms waiting for the next pass. */
+        static std::size_t getQueuedCount() { return dirtyTransforms.size(); }
+
+    private:
+        friend class TransformationComponent;
+
+        static void queue(TransformationComponent* transform);
+        static void unqueue(TransformationComponent* transform);
+
+    private:
+        inline static std::vector<TransformationComponent*> dirtyTransforms;
+    };
+
     class RenderSystem : public BaseSystem {
+    public:
+        /** Counters for the last call to draw(). */
+        struct Statistics {
+            /** Draw calls issued, batched or not. */
+            uint32_t drawCalls = 0;
+            /** Sprites drawn through the sprite batch. */
+            uint32_t batchedSprites = 0;
+            /** GL state changes that were issued, see RenderState. */
+            uint32_t stateChanges = 0;
+            /** GL state changes that were skipped as redundant. */
+            uint32_t skippedStateChanges = 0;
+            /** Drawables inside the camera's view. */
+            uint32_t visibleDrawables = 0;
+            /** Drawables skipped because they were outside the view. */
+            uint32_t culledDrawables = 0;
+        };
+
     public:
         RenderSystem();
         virtual ~RenderSystem() = default;
 
         virtual void update(float delta) override {};
         virtual void draw(ref<SceneNode> sceneRoot);
+
+        /**
+         * Set the camera used for batched sprites.
+         *
+         * Sprites using the built-in sprite shader are only batched when a
+         * camera is set. Otherwise every drawable is drawn on its own.
+         */
+        void setCamera(ref<Camera> camera) { this->camera = camera; }
+
+        /**
+         * Skip drawables whose bounds are outside the camera's view. Only
+         * applies when a camera is set. Enabled by default.
+         */
+        void setFrustumCulling(bool enable) { frustumCulling = enable; }
+        bool isFrustumCulling() const { return frustumCulling; }
+
+        const Statistics& getStatistics() const { return statistics; }
+
+    private:
+        ref<Camera> camera;
+        scope<SpriteBatch> spriteBatch;
+        Statistics statistics;
+        bool frustumCulling = true;
     };
 }
\ No newline at end of file
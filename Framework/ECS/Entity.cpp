@@ -44,29 +44,125 @@ namespace FW {
     }
 
     void Entity::removeComponent(const std::string& componentName) {
-        components.erase(std::remove_if(
+        auto found = std::find_if(
           components.begin(), components.end(), [&](ref<Component> c) {
               return c->name == componentName;
-          }));
+          });
+
+        if (found != components.end()) {
+            removeComponent(found->get());
+        }
+    }
+
+    void Entity::removeComponent(const Component* component) {
+        auto found = std::find_if(
+          components.begin(), components.end(), [&](ref<Component> c) {
+              return c.get() == component;
+          });
+
+        if (found == components.end()) {
+            return;
+        }
+
+        if (component == get<TransformationComponent>()) {
+            get<TransformationComponent>()->setParent(nullptr);
+            for (auto& child : children) {
+                if (auto* childTransform = child->get<TransformationComponent>()) {
+                    childTransform->setParent(nullptr);
+                }
+            }
+        }
+
+        ComponentStorage::get().removeComponent(this, component);
+        components.erase(found);
+    }
+
+    void Entity::addComponent(ComponentTypeID id, ref<Component> component) {
+        if (!ComponentStorage::get().addComponent(this, id, component)) {
+            WARN("Entity {} already has a component with type ID {}", name, id);
+            return;
+        }
+
+        components.push_back(component);
+
+        // Hook a new transform into the transform hierarchy
+        if (id == componentTypeID<TransformationComponent>()) {
+            auto* transform = get<TransformationComponent>();
+            if (parent) {
+                transform->setParent(parent->get<TransformationComponent>());
+            }
+            for (auto& child : children) {
+                if (auto* childTransform = child->get<TransformationComponent>()) {
+                    childTransform->setParent(transform);
+                }
+            }
+        }
+    }
+
+    void Entity::addChild(ref<Entity> entity) {
+        children.push_back(entity);
+        entity->setParent(this);
+
+        if (auto* childTransform = entity->get<TransformationComponent>()) {
+            childTransform->setParent(get<TransformationComponent>());
+        }
+    }
+
+    void Entity::detachFromParent() {
+        parent = nullptr;
+        if (auto* transform = get<TransformationComponent>()) {
+            transform->setParent(nullptr);
+        }
     }
 
     ref<Entity> Entity::removeChildByUUID(std::string UUID) {
-        auto found = std::find_if(children.begin(),
-                                  children.end(),
-                                  [UUID](ref<Entity> e) { return e->getUUID() == UUID; });
+        // Compare against the stored field so children without a UUID are
+        // not assigned one just to be searched
+        auto found = std::find_if(
+          children.begin(), children.end(), [&UUID](const ref<Entity>& e) {
+              return e->UUID == UUID;
+          });
 
         if (found != children.end()) {
             ref<Entity> e = *found;
             children.erase(found);
+            e->detachFromParent();
             return e;
         } else {
             return nullptr;
         }
     }
 
+    ref<Entity> Entity::removeChild(EntityHandle handle) {
+        auto found = std::find_if(
+          children.begin(), children.end(), [handle](const ref<Entity>& e) {
+              return e->handle == handle;
+          });
+
+        if (found == children.end()) {
+            return nullptr;
+        }
+
+        ref<Entity> e = *found;
+        children.erase(found);
+        e->detachFromParent();
+        return e;
+    }
+
+    std::string Entity::getUUID() const {
+        if (UUID.empty()) {
+            UUID = generateUUID();
+        }
+        return UUID;
+    }
+
     Entity::Entity() {
-        UUID = generateUUID();
+        handle = EntityRegistry::get().create(this);
+        ComponentStorage::get().addEntity(this);
     }
 
-    Entity::~Entity() {}
+    Entity::~Entity() {
+        ComponentStorage::get().removeEntity(this);
+        EntityRegistry::get().destroy(handle);
+    }
 } // Framework
@@ -10,6 +10,8 @@
 #include "Material.h"
 #include "Physics.h"
 #include "Component.h"
+#include "ComponentStorage.h"
+#include "EntityRegistry.h"
 
 namespace FW {
 
@@ -32,6 +34,13 @@ namespace FW {
 
         virtual ~Entity();
 
+        /**
+         * Entities are registered by address in the \ref ComponentStorage
+         * "ComponentStorage", so they cannot be copied.
+         */
+        Entity(const Entity&) = delete;
+        Entity& operator=(const Entity&) = delete;
+
         std::vector<ref<Entity>>& getChildren() { return children; }
 
         /**
@@ -48,9 +57,11 @@ namespace FW {
          *  Add a new child
          *
          * The entity is a node in a tree structure. By adding a child, we are
-         * expanding the tree structure.
+         * expanding the tree structure. If both entities have a
+         * TransformationComponent, the child's transform becomes relative to
+         * this entity's transform.
          */
-        void addChild(ref<Entity> entity) { children.push_back(entity); entity->setParent(this); }
+        void addChild(ref<Entity> entity);
 
         /**
          * Remove a child at the i'th index.
@@ -62,10 +73,20 @@ namespace FW {
             if (i < children.size()) {
                 ref<Entity> removedChild = children[i];
                 children.erase(children.begin() + i);
+                removedChild->detachFromParent();
                 return removedChild;
             }
+            return nullptr;
         }
 
+        /**
+         * Remove a child by its handle.
+         *
+         * Please be cautious that removing a child will not delete it. It must
+         * manually be deleted by the user.
+         */
+        ref<Entity> removeChild(EntityHandle handle);
+
         /**
          * Remove a child by its id.
          *
@@ -74,12 +95,22 @@ namespace FW {
          */
         ref<Entity> removeChildByUUID(std::string UUID);
 
+        /**
+         * Return the entity's handle.
+         *
+         * The handle is unique among living entities and can be resolved
+         * through the \ref EntityRegistry "EntityRegistry".
+         */
+        [[nodiscard]] EntityHandle getHandle() const { return handle; }
+
         /**
          * Return the entity's unique identifier.
          *
-         * No other entity should have this identifier.
+         * No other entity should have this identifier. The UUID is only meant
+         * for serialization and is generated on first use. At runtime, prefer
+         * getHandle().
          */
-        [[nodiscard]] std::string getUUID() const { return UUID; }
+        [[nodiscard]] std::string getUUID() const;
 
         void setUUID(std::string UUID) { this->UUID = UUID; }
 
@@ -98,28 +129,96 @@ namespace FW {
          */
         virtual void update(float delta);
 
+        /**
+         * Add a component to the entity.
+         *
+         * The component is stored under its dynamic type. Only one component
+         * per type is allowed; adding a second one is ignored.
+         */
         void addComponent(ref<Component> component) {
-            components.push_back(component);
+            addComponent(getComponentTypeID(typeid(*component)), component);
         }
 
-        /** Get the firstly found component by type `T`. */
+        /**
+         * Add a component to the entity, stored under the static type `T`.
+         *
+         * Create the component with `createComponent<T>()` to keep it in the
+         * pooled storage.
+         */
+        template<typename T>
+        void addComponent(ref<T> component) {
+            addComponent(componentTypeID<T>(), component);
+        }
+
+        /** Get the firstly found component by name. */
         ref<Component> getComponent(std::string componentName);
 
+        /** Return true if the entity has a component stored under `T`. */
+        template<typename T>
+        bool has() const {
+            return componentMask & FW::componentMask<T>();
+        }
+
+        /**
+         * Get the component stored under type `T`, or nullptr.
+         *
+         * The column is found from the entity's component mask, so this does
+         * not search or cast at runtime. The pointer stays valid for as long
+         * as the component is attached.
+         */
+        template<typename T>
+        T* get() const {
+            if (!has<T>()) {
+                return nullptr;
+            }
+            int column = getColumnIndex(componentMask, componentTypeID<T>());
+            return static_cast<T*>(
+              archetype->columns[column][archetypeRow].get());
+        }
+
+        /**
+         * Get a shared reference to the component stored under type `T`.
+         *
+         * Prefer get<T>() in hot code, as this increments the reference count.
+         */
         template<typename T>
         ref<T> getComponent() {
-            for (auto& c : components) {
-                if (auto ptr = std::dynamic_pointer_cast<T>(c)) {
-                    return ptr;
-                }
+            if (!has<T>()) {
+                return nullptr;
             }
-            return nullptr;
+            int column = getColumnIndex(componentMask, componentTypeID<T>());
+            return std::static_pointer_cast<T>(
+              archetype->columns[column][archetypeRow]);
         }
 
         /** Return all of the Entity's components. */
         std::vector<ref<Component>>& getComponents() { return components; }
 
+        /** Return the bitmask of all component types the entity has. */
+        ComponentMask getComponentMask() const { return componentMask; }
+
+        /** Remove the component stored under type `T`. */
+        template<typename T>
+        void removeComponent() {
+            if (T* component = get<T>()) {
+                removeComponent(static_cast<const Component*>(component));
+            }
+        }
+
+        /**
+         * Remove the first component with the given name.
+         *
+         * This compares strings. Prefer removeComponent<T>().
+         */
         void removeComponent(const std::string& componentName);
 
+    private:
+        void addComponent(ComponentTypeID id, ref<Component> component);
+
+        /** Clear the parent and detach the transform from its parent. */
+        void detachFromParent();
+        void removeComponent(const Component* component);
+
     public:
         /// The node's unique name. It is display name and identifier.
         std::string name;
@@ -128,12 +227,20 @@ namespace FW {
         Entity* parent = nullptr;
         std::vector<ref<Entity>> children;
 
-        /** 
-         * The UUID is auto-generated on instantiation. It can still be
-         * overridden, but users must handle collisions manually.
+        EntityHandle handle;
+
+        /**
+         * The UUID is auto-generated the first time it is requested. It can
+         * still be overridden, but users must handle collisions manually.
          */
-        std::string UUID;
+        mutable std::string UUID;
 
+        /** Owning references, in the order the components were added. */
         std::vector<ref<Component>> components;
+
+        friend class ComponentStorage;
+        Archetype* archetype = nullptr;
+        std::size_t archetypeRow = 0;
+        ComponentMask componentMask = 0;
     };
 } // FW
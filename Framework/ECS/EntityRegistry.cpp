@@ -0,0 +1,29 @@
+#include "EntityRegistry.h"
+
+namespace FW {
+    EntityHandle EntityRegistry::create(Entity* entity) {
+        std::uint32_t index;
+
+        if (!freeSlots.empty()) {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            index = static_cast<std::uint32_t>(slots.size());
+            slots.emplace_back();
+        }
+
+        slots[index].entity = entity;
+        return EntityHandle{ index, slots[index].generation };
+    }
+
+    void EntityRegistry::destroy(EntityHandle handle) {
+        if (!isAlive(handle)) {
+            return;
+        }
+
+        Slot& slot = slots[handle.index];
+        slot.entity = nullptr;
+        slot.generation = nextGeneration(slot.generation);
+        freeSlots.push_back(handle.index);
+    }
+} // namespace FW
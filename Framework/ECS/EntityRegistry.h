@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace FW {
+    class Entity;
+
+    /**
+     * Lightweight reference to an \ref Entity "Entity".
+     *
+     * A handle is a slot index plus the generation that slot had when the
+     * entity was created. When the entity is destroyed the slot's generation
+     * is bumped, so stale handles are detected with a single compare instead
+     * of dangling. The default handle is never valid.
+     */
+    struct EntityHandle {
+        std::uint32_t index = 0;
+        std::uint32_t generation = 0;
+
+        /** True for the default handle, which is never issued. */
+        bool isNull() const { return generation == 0; }
+
+        /** Pack the handle into a single 64-bit value. */
+        std::uint64_t toU64() const {
+            return (std::uint64_t(generation) << 32) | index;
+        }
+
+        bool operator==(const EntityHandle&) const = default;
+    };
+
+    /**
+     * Issues \ref EntityHandle "EntityHandles" and resolves them back to
+     * entities.
+     *
+     * Released slots are reused from a free list, so creating and destroying
+     * entities does not allocate once the table has grown. Like the
+     * \ref ComponentStorage "ComponentStorage", the instance is never
+     * destroyed so entities outliving main() can still release their slot.
+     */
+    class EntityRegistry {
+    public:
+        static EntityRegistry& get() {
+            static EntityRegistry* s = new EntityRegistry();
+            return *s;
+        }
+
+        EntityRegistry(const EntityRegistry&) = delete;
+        EntityRegistry& operator=(const EntityRegistry&) = delete;
+
+        /** Reserve a slot for `entity` and return its handle. */
+        EntityHandle create(Entity* entity);
+
+        /** Release the slot. Existing handles to it become invalid. */
+        void destroy(EntityHandle handle);
+
+        /** Return true if `handle` refers to a living entity. */
+        bool isAlive(EntityHandle handle) const {
+            return handle.index < slots.size() &&
+                   slots[handle.index].generation == handle.generation &&
+                   !handle.isNull();
+        }
+
+        /** Return the entity `handle` refers to, or nullptr if it is stale. */
+        Entity* resolve(EntityHandle handle) const {
+            return isAlive(handle) ? slots[handle.index].entity : nullptr;
+        }
+
+        /** Number of living entities. */
+        std::size_t size() const { return slots.size() - freeSlots.size(); }
+
+        /**
+         * The generation a slot gets when its entity is destroyed. Skips 0
+         * on wrap-around, as it is reserved for null handles.
+         */
+        static std::uint32_t nextGeneration(std::uint32_t generation) {
+            return generation == UINT32_MAX ? 1 : generation + 1;
+        }
+
+    private:
+        EntityRegistry() = default;
+        ~EntityRegistry() = default;
+
+    private:
+        struct Slot {
+            Entity* entity = nullptr;
+            /// Starts at 1 so a zeroed handle never matches.
+            std::uint32_t generation = 1;
+        };
+
+        std::vector<Slot> slots;
+        std::vector<std::uint32_t> freeSlots;
+    };
+} // namespace FW
+
+template<>
+struct std::hash<FW::EntityHandle> {
+    std::size_t operator()(const FW::EntityHandle& handle) const noexcept {
+        return std::hash<std::uint64_t>()(handle.toU64());
+    }
+};
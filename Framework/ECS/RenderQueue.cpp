@@ -0,0 +1,158 @@
+#include "RenderQueue.h"
+
+#include "RadixSort.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace FW {
+    void RenderQueue::add(Entity* entity) {
+        if (!members.insert(entity->getHandle()).second) {
+            return;
+        }
+
+        // Removed and re-added within the same frame. The item was never
+        // dropped, so keep it.
+        if (pendingRemovals.erase(entity->getHandle())) {
+            return;
+        }
+
+        items.push_back(Item{ entity->getHandle() });
+        unsortedCount++;
+    }
+
+    void RenderQueue::remove(Entity* entity) {
+        if (members.erase(entity->getHandle())) {
+            pendingRemovals.insert(entity->getHandle());
+        }
+    }
+
+    /**
+     * Map a float to an unsigned integer with the same ordering, keeping the
+     * `bits` most significant bits.
+     */
+    static std::uint64_t sortableFloat(float value, int bits) {
+        std::uint32_t u = std::bit_cast<std::uint32_t>(value);
+        // Flip all bits of negatives, only the sign bit of positives
+        u ^= (u & 0x80000000u) ? 0xFFFFFFFFu : 0x80000000u;
+        return u >> (32 - bits);
+    }
+
+    std::uint64_t RenderQueue::computeKey(DrawableComponent& drawable,
+                                          float depth) {
+        constexpr int depthBits = 23;
+        constexpr std::uint64_t depthMask = (1u << depthBits) - 1;
+        constexpr std::uint64_t stateMask = 0xFFF;
+
+        std::uint64_t z = std::min<std::uint32_t>(drawable.Z_index, 0xFFFF);
+        std::uint64_t shader = drawable.getShaderProgramID() & stateMask;
+        std::uint64_t texture = drawable.getTextureID() & stateMask;
+        std::uint64_t farness = sortableFloat(-depth, depthBits);
+
+        if (drawable.isTransparent) {
+            // Back to front
+            return transparentBit | (z << 47) |
+                   ((depthMask - farness) << 24) | (shader << 12) | texture;
+        }
+
+        // Front to back, to reject hidden fragments early
+        return (z << 47) | (shader << 35) | (texture << 23) | farness;
+    }
+
+    void RenderQueue::prepare(const Frustum* frustum) {
+        static const ComponentMask drawableMask =
+          componentMask<TransformationComponent>() |
+          componentMask<DrawableComponent>();
+
+        auto& registry = EntityRegistry::get();
+        drawList.clear();
+        culledCount = 0;
+        keyedCount = 0;
+
+        // Cull, refresh keys and compact dead entries in one pass
+        std::size_t write = 0;
+        for (std::size_t read = 0; read < items.size(); read++) {
+            Item item = items[read];
+
+            Entity* entity = registry.resolve(item.handle);
+            if (!entity) {
+                members.erase(item.handle);
+                continue;
+            }
+            if (!pendingRemovals.empty() &&
+                pendingRemovals.contains(item.handle)) {
+                continue;
+            }
+
+            item.entity = nullptr;
+            if ((entity->getComponentMask() & drawableMask) == drawableMask) {
+                auto* transform = entity->get<TransformationComponent>();
+                auto* drawable = entity->get<DrawableComponent>();
+
+                const ref<Shape>& shape = drawable->getShape();
+                if (frustum && shape &&
+                    !frustum->intersects(shape->getLocalBounds().transformed(
+                      transform->getWorldMatrix()))) {
+                    item.culled = true;
+                    items[write++] = item;
+                    culledCount++;
+                    continue;
+                }
+
+                item.entity = entity;
+                std::uint64_t key = computeKey(
+                  *drawable, transform->getWorldMatrix()[3].z);
+                keyedCount++;
+
+                // Coming back into view is as good as a new key, since the
+                // item kept the place it had when it was culled
+                if (key != item.key || item.culled) {
+                    item.key = key;
+                    unsortedCount++;
+                }
+            }
+
+            item.culled = false;
+            items[write++] = item;
+            drawList.push_back(item);
+        }
+        items.resize(write);
+        pendingRemovals.clear();
+
+        if (unsortedCount == 0) {
+            return;
+        }
+
+        auto byKey = [](const Item& a, const Item& b) { return a.key < b.key; };
+
+        // Insertion sort is linear for a handful of displaced items, but
+        // quadratic when a whole level was just loaded. The radix sort is
+        // linear either way, but always touches every item.
+        if (unsortedCount * 32 < drawList.size()) {
+            for (std::size_t i = 1; i < drawList.size(); i++) {
+                Item item = drawList[i];
+                std::size_t j = i;
+                while (j > 0 && byKey(item, drawList[j - 1])) {
+                    drawList[j] = drawList[j - 1];
+                    j--;
+                }
+                drawList[j] = item;
+            }
+        } else {
+            radixSort(drawList, sortScratch, [](const Item& item) {
+                return item.key;
+            });
+        }
+
+        // Keep the new order, so the next frame starts out sorted
+        std::size_t next = 0;
+        for (auto& item : items) {
+            if (!item.culled) {
+                item = drawList[next++];
+            }
+        }
+
+        unsortedCount = 0;
+        sortCount++;
+    }
+} // namespace FW
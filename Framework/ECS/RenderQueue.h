@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Entity.h"
+#include "Frustum.h"
+
+#include <unordered_set>
+#include <vector>
+
+namespace FW {
+    /**
+     * Persistent, sorted list of entities to draw.
+     *
+     * Entities are added and removed as their scene nodes are attached to or
+     * detached from the scene, instead of collecting them every frame. Each
+     * frame, prepare() drops the drawables outside the view, refreshes the
+     * sort keys of the rest and only re-sorts if one of them changed. A few
+     * changes are fixed with an insertion sort, which is close to linear on
+     * an almost sorted list.
+     *
+     * Culled entries keep their place from the last frame they were drawn
+     * in, but are neither keyed nor sorted, so both cost as much as what is
+     * visible.
+     *
+     * Entries are stored by \ref EntityHandle "EntityHandle", so entities
+     * that are destroyed without being removed simply drop out.
+     *
+     * Items are ordered by a packed 64-bit key, most significant bits first:
+     *
+     * | Opaque         | Transparent        |
+     * |----------------|--------------------|
+     * | pass (1)       | pass (1)           |
+     * | Z_index (16)   | Z_index (16)       |
+     * | shader (12)    | depth, far first (23) |
+     * | texture (12)   | shader (12)        |
+     * | depth, near first (23) | texture (12) |
+     *
+     * Opaque draws are grouped by state to save program and texture
+     * switches. Transparent draws must blend back to front, so depth comes
+     * before state there.
+     */
+    class RenderQueue {
+    public:
+        struct Item {
+            EntityHandle handle;
+            std::uint64_t key = 0;
+
+            /// Resolved by prepare(). Null if the entity is not drawable.
+            Entity* entity = nullptr;
+
+            /// Outside the frustum given to the last prepare().
+            bool culled = false;
+        };
+
+    public:
+        /** Start tracking `entity`. Adding it twice has no effect. */
+        void add(Entity* entity);
+
+        /** Stop tracking `entity`. */
+        void remove(Entity* entity);
+
+        /**
+         * Refresh the sort keys, drop dead entries and sort if needed. Must
+         * be called before iterating the items each frame.
+         *
+         * @param frustum If not null, drawables whose shape is entirely
+         * outside it are left out of getItems(). They are skipped before
+         * their key is computed.
+         */
+        void prepare(const Frustum* frustum = nullptr);
+
+        /**
+         * Items in draw order, without the ones culled by the last
+         * prepare(). Undrawable entries have a null entity.
+         */
+        const std::vector<Item>& getItems() const { return drawList; }
+
+        /** Number of entities tracked, culled or not. */
+        std::size_t size() const { return items.size(); }
+
+        /** Number of times prepare() had to re-sort. */
+        std::size_t getSortCount() const { return sortCount; }
+
+        /** Drawables left out by the last prepare(). */
+        std::size_t getCulledCount() const { return culledCount; }
+
+        /** Sort keys computed by the last prepare(). */
+        std::size_t getKeyedCount() const { return keyedCount; }
+
+        /**
+         * Compute the sort key of a drawable.
+         *
+         * @param depth World space Z of the drawable. The camera looks down
+         * -Z, so a larger Z is closer.
+         */
+        static std::uint64_t computeKey(DrawableComponent& drawable,
+                                        float depth);
+
+        /**
+         * Opaque items are drawn before transparent ones, so the transparent
+         * flag is the most significant bit.
+         */
+        static constexpr std::uint64_t transparentBit = std::uint64_t(1) << 63;
+
+    private:
+        /// Every tracked entity. Those that were not culled are in the order
+        /// they were last drawn in.
+        std::vector<Item> items;
+        /// The visible part of `items`, sorted by key.
+        std::vector<Item> drawList;
+        std::vector<Item> sortScratch;
+        std::unordered_set<EntityHandle> members;
+
+        /// Removed since the last prepare(), but still present in `items`.
+        std::unordered_set<EntityHandle> pendingRemovals;
+
+        /// Items were appended or keys changed since the last sort.
+        std::size_t unsortedCount = 0;
+
+        std::size_t sortCount = 0;
+        std::size_t culledCount = 0;
+        std::size_t keyedCount = 0;
+    };
+} // namespace FW
@@ -12,15 +12,15 @@ namespace FW {
     }
 
     void Sprite::init() {
-        shader = "inbuilt_ecs_shader";
+        shader = DrawableComponent::spriteShaderName;
         ShaderManager::get().createShaderFromFiles(shader, SHADERS_DIR + std::string("ECS_sprite.vs"),
                                     SHADERS_DIR + std::string("ECS_sprite.fs"));
 
-        transformationComponent = FW::createRef<FW::TransformationComponent>();
+        transformationComponent = FW::createComponent<FW::TransformationComponent>();
         addComponent(transformationComponent);
 
         if (isDrawable) {
-            drawableComponent = FW::createRef<FW::DrawableComponent>();
+            drawableComponent = FW::createComponent<FW::DrawableComponent>();
             addComponent(drawableComponent);
             drawableComponent->setShader(shader);
             drawableComponent->setShape(FW::createRef<FW::PrimitiveQuad>());
@@ -108,8 +108,15 @@ namespace FW {
 
     void Sprite::update(float delta) {
         if (isDrawable && camera) {
-            Shader* shaderRef = ShaderManager::get().bind(drawableComponent->getShader());
-            camera->update(shaderRef);
+            if (drawableComponent->getShader() ==
+                DrawableComponent::spriteShaderName) {
+                // The built-in shader reads the camera's uniform buffer
+                camera->bindUniformBuffer();
+            } else {
+                Shader* shaderRef =
+                  ShaderManager::get().getShader(drawableComponent->getShader());
+                camera->update(shaderRef);
+            }
         }
 
         Entity::update(delta);
@@ -118,6 +125,9 @@ namespace FW {
                             const std::string filepath) {
         drawableComponent->setTexture(name, filepath);
     }
+    void Sprite::setTexture(const AtlasRegion& region) {
+        drawableComponent->setTexture(region);
+    }
     void Sprite::setZIndex(uint32_t z) {
         if (drawableComponent) {
             drawableComponent->Z_index = z;
@@ -56,6 +56,9 @@ namespace FW {
 
         void setTexture(const std::string& name, const std::string filepath);
 
+        /** Draw part of an atlas page. See \ref TextureAtlas "TextureAtlas". */
+        void setTexture(const AtlasRegion& region);
+
         /** The Z-index sets the draw priority in the render engine. Objects
          * with greater Z-index are drawn on top.
          */
@@ -0,0 +1,130 @@
+/**
+ * Measure the CPU cost of RenderSystem::draw() without a GPU.
+ *
+ * OpenGL calls go to the RecordingBackend, so only the work done by the
+ * Framework is timed: refreshing the render queue, culling, batching and
+ * issuing state. Sprites are scattered over a world ten times as wide and
+ * high as the view, with a few textures, and some of them move every frame.
+ * The scenes are generated from a fixed seed, so runs are comparable.
+ */
+
+#include "ECS_Systems.h"
+#include "RecordingBackend.h"
+#include "RenderCommands.h"
+#include "Sprite.h"
+#include "TextureManager.h"
+#include "Camera/OrthographicCamera.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static constexpr float viewSize = 100.0f;
+static constexpr float worldSize = viewSize * 10.0f;
+
+struct Scene {
+    FW::ref<FW::SceneNode> root;
+    std::vector<FW::ref<FW::Sprite>> movers;
+};
+
+static Scene createScene(std::size_t count,
+                         const std::vector<uint32_t>& textures) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> position(0.0f, worldSize);
+
+    Scene scene{ FW::createRef<FW::SceneNode>(), {} };
+    for (std::size_t i = 0; i < count; i++) {
+        auto sprite = FW::createRef<FW::Sprite>();
+        sprite->setPosition(position(rng), position(rng));
+        sprite->getComponent<FW::DrawableComponent>()->setTexture(
+          textures[rng() % textures.size()]);
+        if (i % 10 == 0) {
+            scene.movers.push_back(sprite);
+        }
+
+        auto node = FW::createRef<FW::SceneNode>();
+        node->entity = sprite;
+        scene.root->addChild(node);
+    }
+    return scene;
+}
+
+/** Average milliseconds per frame. */
+static double measureFrames(FW::RenderSystem& renderSystem,
+                            Scene& scene,
+                            int frames) {
+    // The first frame registers the scene and creates the batch
+    renderSystem.draw(scene.root);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        for (auto& sprite : scene.movers) {
+            sprite->moveBy(0.1f, 0.0f);
+        }
+        renderSystem.draw(scene.root);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count() /
+           frames;
+}
+
+int main() {
+    RenderCommand::setBackend(FW::createScope<FW::RecordingBackend>());
+    auto& backend =
+      static_cast<FW::RecordingBackend&>(FW::RenderBackend::get());
+    backend.setLogCommands(false);
+    RenderCommand::init();
+
+    FW::TextureManager::createTexture(
+      "default", { 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f });
+    std::vector<uint32_t> textures;
+    for (uint32_t i = 0; i < 4; i++) {
+        textures.push_back(FW::TextureManager::createTexture(
+          "bench_" + std::to_string(i), { 0.25f * i, 0.5f, 1.0f }, { 1, 1 }));
+    }
+
+    auto camera =
+      FW::createRef<FW::OrthographicCamera>(FW::OrthographicCamera::Frustum{
+        0.0f, viewSize, 0.0f, viewSize, -1.0f, 1.0f });
+    camera->initializeCamera();
+
+    std::printf("%10s %8s %12s %10s %10s %10s %12s\n",
+                "sprites",
+                "culling",
+                "ms/frame",
+                "visible",
+                "culled",
+                "draws",
+                "GL state");
+
+    for (std::size_t count : { 1'000, 10'000, 100'000 }) {
+        Scene scene = createScene(count, textures);
+
+        for (bool culling : { false, true }) {
+            FW::RenderSystem renderSystem;
+            renderSystem.setCamera(camera);
+            renderSystem.setFrustumCulling(culling);
+
+            int frames = count >= 100'000 ? 10 : 100;
+            double milliseconds = measureFrames(renderSystem, scene, frames);
+
+            // Counts of the last frame
+            backend.clear();
+            renderSystem.draw(scene.root);
+            const auto& statistics = renderSystem.getStatistics();
+
+            std::printf("%10zu %8s %12.3f %10u %10u %10u %12u\n",
+                        count,
+                        culling ? "on" : "off",
+                        milliseconds,
+                        statistics.visibleDrawables,
+                        statistics.culledDrawables,
+                        backend.getStatistics().drawCalls,
+                        backend.getStatistics().stateChanges);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include "doctest/doctest.h"
+
+#include "ComponentStorage.h"
+#include "Entity.h"
+
+#include <vector>
+
+/** Components only used in this file, so other tests do not share them. */
+struct Health : FW::Component {
+    explicit Health(int value = 0)
+      : value(value) {}
+    void init() override {}
+    void update(float delta) override {}
+    int value;
+};
+
+struct Armor : FW::Component {
+    explicit Armor(int value = 0)
+      : value(value) {}
+    void init() override {}
+    void update(float delta) override {}
+    int value;
+};
+
+struct Speed : FW::Component {
+    explicit Speed(int value = 0)
+      : value(value) {}
+    void init() override {}
+    void update(float delta) override {}
+    int value;
+};
+
+/** Check that `entity` has exactly the components with non-zero values. */
+static void checkComponents(FW::Entity& entity,
+                            int health,
+                            int armor,
+                            int speed) {
+    CHECK(entity.has<Health>() == (health != 0));
+    CHECK(entity.has<Armor>() == (armor != 0));
+    CHECK(entity.has<Speed>() == (speed != 0));
+
+    CHECK((entity.get<Health>() ? entity.get<Health>()->value : 0) == health);
+    CHECK((entity.get<Armor>() ? entity.get<Armor>()->value : 0) == armor);
+    CHECK((entity.get<Speed>() ? entity.get<Speed>()->value : 0) == speed);
+}
+
+TEST_CASE("Entities keep their components as they move between archetypes") {
+    FW::Entity first;
+    checkComponents(first, 0, 0, 0);
+
+    first.addComponent(FW::createComponent<Health>(1));
+    checkComponents(first, 1, 0, 0);
+    first.addComponent(FW::createComponent<Armor>(2));
+    checkComponents(first, 1, 2, 0);
+    first.addComponent(FW::createComponent<Speed>(3));
+    checkComponents(first, 1, 2, 3);
+
+    // The same set, added in another order
+    FW::Entity second;
+    second.addComponent(FW::createComponent<Speed>(30));
+    checkComponents(second, 0, 0, 30);
+    second.addComponent(FW::createComponent<Armor>(20));
+    checkComponents(second, 0, 20, 30);
+    second.addComponent(FW::createComponent<Health>(10));
+    checkComponents(second, 10, 20, 30);
+    CHECK(second.getComponentMask() == first.getComponentMask());
+
+    // A second component of the same type is ignored
+    second.addComponent(FW::createComponent<Health>(99));
+    checkComponents(second, 10, 20, 30);
+
+    // Remove from the middle, the start and the end of the signature
+    first.removeComponent<Armor>();
+    checkComponents(first, 1, 0, 3);
+    first.removeComponent<Health>();
+    checkComponents(first, 0, 0, 3);
+    second.removeComponent<Speed>();
+    checkComponents(second, 10, 20, 0);
+
+    // And add back what was removed
+    first.addComponent(FW::createComponent<Armor>(4));
+    checkComponents(first, 0, 4, 3);
+    first.addComponent(FW::createComponent<Health>(5));
+    checkComponents(first, 5, 4, 3);
+    checkComponents(second, 10, 20, 0);
+}
+
+TEST_CASE("Swap-removing a row keeps the moved entity's components") {
+    std::vector<FW::scope<FW::Entity>> entities;
+    for (int i = 1; i <= 4; i++) {
+        auto entity = FW::createScope<FW::Entity>();
+        entity->addComponent(FW::createComponent<Health>(i));
+        entity->addComponent(FW::createComponent<Armor>(i * 10));
+        entities.push_back(std::move(entity));
+    }
+
+    // The first row leaves the archetype, and the last entity takes its place
+    entities[0]->removeComponent<Armor>();
+    checkComponents(*entities[0], 1, 0, 0);
+    checkComponents(*entities[3], 4, 40, 0);
+
+    // Destroying an entity also removes its row
+    entities.erase(entities.begin() + 1);
+    checkComponents(*entities[1], 3, 30, 0);
+    checkComponents(*entities[2], 4, 40, 0);
+
+    // Iteration sees every remaining entity once, with its own components
+    int visited = 0;
+    int armorSum = 0;
+    FW::ComponentStorage::get().each<Health, Armor>(
+      [&](FW::Entity& entity, Health& health, Armor& armor) {
+          CHECK(entity.get<Health>() == &health);
+          CHECK(armor.value == health.value * 10);
+          visited++;
+          armorSum += armor.value;
+      });
+    CHECK(visited == 2);
+    CHECK(armorSum == 70);
+}
+
+TEST_CASE("ComponentPool reuses freed slots") {
+    FW::ComponentPool pool(sizeof(Speed), alignof(Speed));
+    void* first = pool.allocate();
+    void* second = pool.allocate();
+    CHECK(pool.size() == 2);
+    CHECK(pool.chunkCount() == 1);
+
+    // The most recently freed slot is handed out first
+    pool.deallocate(first);
+    CHECK(pool.size() == 1);
+    CHECK(pool.allocate() == first);
+    pool.deallocate(second);
+    pool.deallocate(first);
+    CHECK(pool.allocate() == first);
+    CHECK(pool.allocate() == second);
+
+    // A new chunk is only reserved once every slot is in use
+    std::vector<void*> slots;
+    while (pool.size() < FW::ComponentPool::slotsPerChunk) {
+        slots.push_back(pool.allocate());
+    }
+    CHECK(pool.chunkCount() == 1);
+    slots.push_back(pool.allocate());
+    CHECK(pool.chunkCount() == 2);
+    for (void* slot : slots) {
+        pool.deallocate(slot);
+    }
+    for (std::size_t i = 0; i < slots.size(); i++) {
+        pool.allocate();
+    }
+    CHECK(pool.chunkCount() == 2);
+
+    // Pooled components reuse slots the same way
+    auto component = FW::createComponent<Speed>(1);
+    Speed* freed = component.get();
+    component.reset();
+    component = FW::createComponent<Speed>(2);
+    CHECK(component.get() == freed);
+    CHECK(component->value == 2);
+}
@@ -0,0 +1,57 @@
+#include "doctest/doctest.h"
+
+#include "Entity.h"
+#include "EntityRegistry.h"
+
+#include <cstdint>
+
+using FW::EntityHandle;
+using FW::EntityRegistry;
+
+TEST_CASE("Stale entity handles resolve to nullptr") {
+    EntityRegistry& registry = EntityRegistry::get();
+    CHECK(registry.resolve(EntityHandle{}) == nullptr);
+
+    auto entity = FW::createScope<FW::Entity>();
+    EntityHandle handle = entity->getHandle();
+    CHECK(!handle.isNull());
+    CHECK(registry.isAlive(handle));
+    CHECK(registry.resolve(handle) == entity.get());
+
+    std::size_t living = registry.size();
+    entity.reset();
+    CHECK(registry.size() == living - 1);
+    CHECK(!registry.isAlive(handle));
+    CHECK(registry.resolve(handle) == nullptr);
+
+    // The slot is reused with a new generation, so the old handle stays stale
+    auto reused = FW::createScope<FW::Entity>();
+    EntityHandle reusedHandle = reused->getHandle();
+    CHECK(reusedHandle.index == handle.index);
+    CHECK(reusedHandle.generation != handle.generation);
+    CHECK(registry.resolve(handle) == nullptr);
+    CHECK(registry.resolve(reusedHandle) == reused.get());
+
+    // Destroying a stale handle does not release the slot again
+    registry.destroy(handle);
+    CHECK(registry.resolve(reusedHandle) == reused.get());
+}
+
+TEST_CASE("Entity generations skip 0 when they wrap around") {
+    CHECK(EntityRegistry::nextGeneration(1) == 2);
+    CHECK(EntityRegistry::nextGeneration(UINT32_MAX - 1) == UINT32_MAX);
+    CHECK(EntityRegistry::nextGeneration(UINT32_MAX) == 1);
+}
+
+TEST_CASE("Entity UUIDs are generated once and kept") {
+    FW::Entity first;
+    FW::Entity second;
+
+    std::string uuid = first.getUUID();
+    CHECK(!uuid.empty());
+    CHECK(first.getUUID() == uuid);
+    CHECK(second.getUUID() != uuid);
+
+    first.setUUID("custom");
+    CHECK(first.getUUID() == "custom");
+}
@@ -0,0 +1,82 @@
+#include "doctest/doctest.h"
+
+#include "BaseScene.h"
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <vector>
+
+static FW::ref<FW::SceneNode> createNode() {
+    auto node = FW::createRef<FW::SceneNode>();
+    node->entity = FW::createRef<FW::Entity>();
+    return node;
+}
+
+/** Handles in the queue, sorted so they can be compared as sets. */
+static std::vector<std::uint64_t> getHandles(FW::RenderQueue& queue) {
+    queue.prepare();
+    std::vector<std::uint64_t> handles;
+    for (const auto& item : queue.getItems()) {
+        handles.push_back(item.handle.toU64());
+    }
+    std::sort(handles.begin(), handles.end());
+    return handles;
+}
+
+static std::vector<std::uint64_t> getHandles(
+  std::initializer_list<FW::ref<FW::SceneNode>> nodes) {
+    std::vector<std::uint64_t> handles;
+    for (const auto& node : nodes) {
+        handles.push_back(node->entity->getHandle().toU64());
+    }
+    std::sort(handles.begin(), handles.end());
+    return handles;
+}
+
+TEST_CASE("RenderQueue follows nodes added and removed after the first draw") {
+    auto root = createNode();
+    auto a = createNode();
+    auto b = createNode();
+    root->addChild(a);
+    root->addChild(b);
+
+    // Like the first RenderSystem::draw(), which registers the whole tree
+    auto queue = FW::createRef<FW::RenderQueue>();
+    root->setRenderQueue(queue);
+    CHECK(getHandles(*queue) == getHandles({ root, a, b }));
+
+    // A subtree added later is registered with all its nodes
+    auto c = createNode();
+    auto d = createNode();
+    c->addChild(d);
+    a->addChild(c);
+    CHECK(c->getRenderQueue() == queue);
+    CHECK(d->getRenderQueue() == queue);
+    CHECK(getHandles(*queue) == getHandles({ root, a, b, c, d }));
+
+    // Removing a node unregisters its subtree
+    root->removeChild(a);
+    CHECK(a->getRenderQueue() == nullptr);
+    CHECK(d->getRenderQueue() == nullptr);
+    CHECK(getHandles(*queue) == getHandles({ root, b }));
+
+    // Removed and added back within one frame, or registered twice, the
+    // node is still listed once
+    root->removeChild(b);
+    root->addChild(b);
+    b->setRenderQueue(queue);
+    root->addChild(a);
+    CHECK(getHandles(*queue) == getHandles({ root, a, b, c, d }));
+
+    a->removeChildrenIf([&](const FW::ref<FW::SceneNode>& node) {
+        return node == c;
+    });
+    CHECK(getHandles(*queue) == getHandles({ root, a, b }));
+
+    // An entity destroyed while still in the tree drops out on its own
+    auto e = createNode();
+    root->addChild(e);
+    CHECK(getHandles(*queue).size() == 4);
+    e->entity.reset();
+    CHECK(getHandles(*queue) == getHandles({ root, a, b }));
+}
@@ -0,0 +1,191 @@
+#include "doctest/doctest.h"
+
+#include "ECS_Systems.h"
+#include "RecordingBackend.h"
+#include "RenderCommands.h"
+#include "Sprite.h"
+#include "TextureManager.h"
+#include "Camera/OrthographicCamera.h"
+
+#include <algorithm>
+#include <vector>
+
+using Command = FW::RecordingBackend::Command;
+
+/** Record instead of drawing, for every test in this file. */
+static FW::RecordingBackend& getBackend() {
+    static bool installed = [] {
+        RenderCommand::setBackend(FW::createScope<FW::RecordingBackend>());
+        RenderCommand::init();
+        FW::TextureManager::createTexture(
+          "default", { 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f });
+        return true;
+    }();
+    (void)installed;
+    return static_cast<FW::RecordingBackend&>(FW::RenderBackend::get());
+}
+
+/** A camera seeing x and y in [0, 20]. */
+static FW::ref<FW::Camera> createCamera() {
+    auto camera = FW::createRef<FW::OrthographicCamera>(
+      FW::OrthographicCamera::Frustum{ 0.0f, 20.0f, 0.0f, 20.0f, -1.0f, 1.0f });
+    camera->initializeCamera();
+    return camera;
+}
+
+/** A row of sprites inside the camera's view, and a row far outside it. */
+static FW::ref<FW::SceneNode> createScene(int visible, int hidden) {
+    auto root = FW::createRef<FW::SceneNode>();
+    for (int i = 0; i < visible + hidden; i++) {
+        auto sprite = FW::createRef<FW::Sprite>();
+        float x = i < visible ? 1.0f + i % 18 : 1000.0f + i;
+        sprite->setPosition(x, 10.0f);
+
+        auto node = FW::createRef<FW::SceneNode>();
+        node->entity = sprite;
+        root->addChild(node);
+    }
+    return root;
+}
+
+TEST_CASE("RenderSystem batches sprites sharing a texture into one draw call") {
+    FW::RecordingBackend& backend = getBackend();
+    FW::RenderSystem renderSystem;
+    renderSystem.setCamera(createCamera());
+    auto scene = createScene(16, 0);
+
+    backend.clear();
+    renderSystem.draw(scene);
+
+    CHECK(backend.getStatistics().drawCalls == 1);
+    CHECK(backend.getStatistics().indices == 16 * 6);
+    CHECK(renderSystem.getStatistics().drawCalls == 1);
+    CHECK(renderSystem.getStatistics().batchedSprites == 16);
+}
+
+TEST_CASE("RenderSystem does not submit sprites outside the camera") {
+    FW::RecordingBackend& backend = getBackend();
+    FW::RenderSystem renderSystem;
+    renderSystem.setCamera(createCamera());
+    auto scene = createScene(10, 30);
+
+    backend.clear();
+    renderSystem.draw(scene);
+
+    CHECK(renderSystem.getStatistics().visibleDrawables == 10);
+    CHECK(renderSystem.getStatistics().culledDrawables == 30);
+    CHECK(backend.getStatistics().indices == 10 * 6);
+
+    renderSystem.setFrustumCulling(false);
+    backend.clear();
+    renderSystem.draw(scene);
+
+    CHECK(renderSystem.getStatistics().culledDrawables == 0);
+    CHECK(backend.getStatistics().indices == 40 * 6);
+}
+
+TEST_CASE("RenderSystem records the same commands for an unchanged scene") {
+    FW::RecordingBackend& backend = getBackend();
+    FW::RenderSystem renderSystem;
+    renderSystem.setCamera(createCamera());
+    auto scene = createScene(8, 8);
+
+    // The first frame also creates the batch's buffers and shader
+    renderSystem.draw(scene);
+
+    backend.clear();
+    renderSystem.draw(scene);
+    std::vector<Command> first = backend.getCommands();
+
+    backend.clear();
+    renderSystem.draw(scene);
+
+    REQUIRE(!first.empty());
+    CHECK(backend.getCommands() == first);
+}
+
+/** Number of writes to the camera's uniform buffer. */
+static long countCameraUploads(const FW::RecordingBackend& backend) {
+    return std::ranges::count_if(backend.getCommands(), [](const Command& c) {
+        return c.type == Command::Type::BufferUpload &&
+               c.value == sizeof(FW::Camera::UniformData);
+    });
+}
+
+TEST_CASE("RenderSystem uploads the camera again after a context restart") {
+    FW::RecordingBackend& backend = getBackend();
+    FW::RenderSystem renderSystem;
+    renderSystem.setCamera(createCamera());
+    auto scene = createScene(0, 0);
+
+    renderSystem.draw(scene);
+    backend.clear();
+    renderSystem.draw(scene);
+    CHECK(countCameraUploads(backend) == 0);
+
+    // The new context has a new buffer that holds no camera yet
+    RenderCommand::destroy();
+    RenderCommand::init();
+    backend.clear();
+    renderSystem.draw(scene);
+    CHECK(countCameraUploads(backend) == 1);
+}
+
+TEST_CASE("RenderSystem uploads an identity camera when it has none") {
+    FW::RecordingBackend& backend = getBackend();
+    FW::RenderSystem renderSystem;
+    renderSystem.setCamera(createCamera());
+    auto scene = createScene(0, 0);
+    renderSystem.draw(scene);
+
+    renderSystem.setCamera(nullptr);
+    backend.clear();
+    renderSystem.draw(scene);
+    CHECK(countCameraUploads(backend) == 1);
+}
+
+TEST_CASE("RenderQueue culls drawables before keying and sorting them") {
+    getBackend();
+    FW::Frustum frustum = createCamera()->getViewFrustum();
+
+    // The same rows as createScene(10, 30)
+    FW::RenderQueue queue;
+    std::vector<FW::ref<FW::Sprite>> sprites;
+    for (int i = 0; i < 40; i++) {
+        auto sprite = FW::createRef<FW::Sprite>();
+        sprite->setPosition(i < 10 ? 1.0f + i : 1000.0f + i, 10.0f);
+        queue.add(sprite.get());
+        sprites.push_back(sprite);
+    }
+
+    queue.prepare(&frustum);
+    CHECK(queue.size() == 40);
+    CHECK(queue.getItems().size() == 10);
+    CHECK(queue.getKeyedCount() == 10);
+    CHECK(queue.getCulledCount() == 30);
+    for (const auto& item : queue.getItems()) {
+        REQUIRE(item.entity);
+        CHECK(static_cast<FW::Sprite*>(item.entity)->getPosition().x < 20.0f);
+    }
+
+    // Nothing changed, so nothing is sorted again
+    std::size_t sortCount = queue.getSortCount();
+    queue.prepare(&frustum);
+    CHECK(queue.getSortCount() == sortCount);
+
+    // Drawables coming into view are sorted in with the rest
+    for (int i = 10; i < 15; i++) {
+        sprites[i]->setPosition(19.0f - i, 5.0f);
+    }
+    queue.prepare(&frustum);
+    CHECK(queue.getItems().size() == 15);
+    CHECK(queue.getKeyedCount() == 15);
+    CHECK(queue.getSortCount() == sortCount + 1);
+    CHECK(std::ranges::is_sorted(
+      queue.getItems(), {}, &FW::RenderQueue::Item::key));
+
+    // Without a frustum, everything is drawn
+    queue.prepare();
+    CHECK(queue.getItems().size() == 40);
+    CHECK(queue.getCulledCount() == 0);
+}
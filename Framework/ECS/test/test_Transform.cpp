@@ -0,0 +1,106 @@
+#include "doctest/doctest.h"
+
+#include "Component.h"
+#include "ECS_Systems.h"
+#include "Entity.h"
+
+using FW::TransformationComponent;
+using FW::TransformSystem;
+
+/** An entity with a transform at `position`. */
+static FW::ref<FW::Entity> createEntity(glm::vec3 position) {
+    auto entity = FW::createRef<FW::Entity>();
+    auto transform = FW::createComponent<TransformationComponent>();
+    transform->setPosition(position);
+    entity->addComponent(transform);
+    return entity;
+}
+
+static glm::vec3 getWorldPosition(FW::Entity& entity) {
+    return glm::vec3(
+      entity.get<TransformationComponent>()->getWorldMatrix()[3]);
+}
+
+TEST_CASE("Child transforms follow their parent") {
+    auto parent = createEntity({ 10.0f, 0.0f, 0.0f });
+    auto child = createEntity({ 1.0f, 2.0f, 0.0f });
+    auto grandchild = createEntity({ 0.0f, 0.0f, 3.0f });
+    parent->addChild(child);
+    child->addChild(grandchild);
+
+    TransformSystem::flush();
+    CHECK(TransformSystem::getQueuedCount() == 0);
+    CHECK(getWorldPosition(*child) == glm::vec3{ 11.0f, 2.0f, 0.0f });
+    CHECK(getWorldPosition(*grandchild) == glm::vec3{ 11.0f, 2.0f, 3.0f });
+
+    // Only the moved transform is queued, its subtree is updated with it
+    parent->get<TransformationComponent>()->setPosition(20.0f, 5.0f);
+    CHECK(TransformSystem::getQueuedCount() == 1);
+    CHECK(child->get<TransformationComponent>()->isDirty() == false);
+    TransformSystem::flush();
+    CHECK(getWorldPosition(*child) == glm::vec3{ 21.0f, 7.0f, 0.0f });
+    CHECK(getWorldPosition(*grandchild) == glm::vec3{ 21.0f, 7.0f, 3.0f });
+
+    // Reading the world matrix before the pass brings it up to date too
+    parent->get<TransformationComponent>()->setPosition(0.0f, 0.0f);
+    CHECK(getWorldPosition(*grandchild) == glm::vec3{ 1.0f, 2.0f, 3.0f });
+    TransformSystem::flush();
+}
+
+TEST_CASE("Reparented and detached transforms move with their new parent") {
+    auto first = createEntity({ 10.0f, 0.0f, 0.0f });
+    auto second = createEntity({ 0.0f, 100.0f, 0.0f });
+    auto child = createEntity({ 1.0f, 0.0f, 0.0f });
+    auto* transform = child->get<TransformationComponent>();
+
+    first->addChild(child);
+    TransformSystem::flush();
+    CHECK(transform->getParent() == first->get<TransformationComponent>());
+    CHECK(getWorldPosition(*child) == glm::vec3{ 11.0f, 0.0f, 0.0f });
+
+    // Detaching makes the local position the world position
+    CHECK(first->removeChild(child->getHandle()) == child);
+    TransformSystem::flush();
+    CHECK(transform->getParent() == nullptr);
+    CHECK(getWorldPosition(*child) == glm::vec3{ 1.0f, 0.0f, 0.0f });
+
+    // The old parent no longer moves the child
+    first->get<TransformationComponent>()->setPosition(50.0f, 0.0f);
+    TransformSystem::flush();
+    CHECK(getWorldPosition(*child) == glm::vec3{ 1.0f, 0.0f, 0.0f });
+
+    second->addChild(child);
+    TransformSystem::flush();
+    CHECK(getWorldPosition(*child) == glm::vec3{ 1.0f, 100.0f, 0.0f });
+
+    // Removing the parent's transform detaches the child's as well
+    second->removeComponent<TransformationComponent>();
+    TransformSystem::flush();
+    CHECK(transform->getParent() == nullptr);
+    CHECK(getWorldPosition(*child) == glm::vec3{ 1.0f, 0.0f, 0.0f });
+}
+
+TEST_CASE("Destroyed transforms leave the update queue") {
+    TransformSystem::flush();
+
+    auto kept = FW::createComponent<TransformationComponent>();
+    auto destroyed = FW::createComponent<TransformationComponent>();
+    auto child = FW::createComponent<TransformationComponent>();
+    child->setParent(destroyed.get());
+    child->setPosition(1.0f, 0.0f);
+    destroyed->setPosition(10.0f, 0.0f);
+    CHECK(TransformSystem::getQueuedCount() == 3);
+
+    // Destroy a queued transform that is not at the end of the queue
+    destroyed.reset();
+    CHECK(TransformSystem::getQueuedCount() == 2);
+    CHECK(child->getParent() == nullptr);
+
+    kept->setPosition(3.0f, 0.0f);
+    TransformSystem::flush();
+    CHECK(TransformSystem::getQueuedCount() == 0);
+    CHECK(glm::vec3(kept->getWorldMatrix()[3]) ==
+          glm::vec3{ 3.0f, 0.0f, 0.0f });
+    CHECK(glm::vec3(child->getWorldMatrix()[3]) ==
+          glm::vec3{ 1.0f, 0.0f, 0.0f });
+}
@@ -0,0 +1,462 @@
+#include "AABBTree.h"
+#include "assertions.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace FW::Physics {
+
+bool AABBTree::Bounds::contains(const Bounds& other) const {
+    return min.x <= other.min.x && min.y <= other.min.y &&
+           min.z <= other.min.z && max.x >= other.max.x &&
+           max.y >= other.max.y && max.z >= other.max.z;
+}
+
+bool AABBTree::Bounds::overlaps(const Bounds& other) const {
+    return min.x <= other.max.x && max.x >= other.min.x &&
+           min.y <= other.max.y && max.y >= other.min.y &&
+           min.z <= other.max.z && max.z >= other.min.z;
+}
+
+float AABBTree::Bounds::getSurfaceArea() const {
+    glm::vec3 size = max - min;
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+AABBTree::Bounds AABBTree::Bounds::merge(const Bounds& a, const Bounds& b) {
+    return { glm::min(a.min, b.min), glm::max(a.max, b.max) };
+}
+
+AABBTree::AABBTree(float margin)
+  : margin(margin) {
+    ASSERT(margin >= 0.0f, "Margin must not be negative.");
+}
+
+ProxyId AABBTree::insert(const BoundingBox_Quad& box, void* userData) {
+    int32_t leaf = allocateNode();
+    nodes[leaf].bounds = fatten(box);
+    boxes[leaf] = box;
+    this->userData[leaf] = userData;
+
+    insertLeaf(leaf);
+    proxyCount++;
+    return static_cast<ProxyId>(leaf);
+}
+
+void AABBTree::move(ProxyId proxy, const BoundingBox_Quad& box) {
+    auto leaf = static_cast<int32_t>(proxy);
+    ASSERT(nodes[leaf].height == 0, "Moving a proxy that is not in the tree.");
+
+    boxes[leaf] = box;
+
+    // Still inside the fat box, and not so small that the fat box would
+    // produce many false candidates. The tree is unchanged.
+    Bounds tight{ { box.minX, box.minY, box.minZ },
+                  { box.maxX, box.maxY, box.maxZ } };
+    Bounds loose{ tight.min - glm::vec3(4.0f * margin),
+                  tight.max + glm::vec3(4.0f * margin) };
+    if (nodes[leaf].bounds.contains(tight) &&
+        loose.contains(nodes[leaf].bounds)) {
+        return;
+    }
+
+    removeLeaf(leaf);
+    nodes[leaf].bounds = fatten(box);
+    insertLeaf(leaf);
+    reinsertCount++;
+}
+
+void AABBTree::remove(ProxyId proxy) {
+    auto leaf = static_cast<int32_t>(proxy);
+    ASSERT(nodes[leaf].height == 0,
+           "Removing a proxy that is not in the tree.");
+
+    removeLeaf(leaf);
+    freeNode(leaf);
+    proxyCount--;
+}
+
+void AABBTree::clear() {
+    nodes.clear();
+    boxes.clear();
+    userData.clear();
+    root = nullNode;
+    freeList = nullNode;
+    proxyCount = 0;
+}
+
+void AABBTree::findPairs(std::vector<ProxyPair>& pairs) const {
+    pairs.clear();
+    if (root == nullNode) {
+        return;
+    }
+
+    // Collide the tree with itself. A node paired with itself yields the
+    // pairs within each child and between the two children. Two different
+    // nodes are only descended into while their bounds overlap, so every
+    // pair of subtrees is tested at most once.
+    nodePairs.clear();
+    nodePairs.push_back({ root, root });
+    while (!nodePairs.empty()) {
+        auto [indexA, indexB] = nodePairs.back();
+        nodePairs.pop_back();
+        const Node& a = nodes[indexA];
+        const Node& b = nodes[indexB];
+
+        if (indexA == indexB) {
+            if (!a.isLeaf()) {
+                nodePairs.push_back({ a.child1, a.child1 });
+                nodePairs.push_back({ a.child2, a.child2 });
+                nodePairs.push_back({ a.child1, a.child2 });
+            }
+            continue;
+        }
+
+        if (!a.bounds.overlaps(b.bounds)) {
+            continue;
+        }
+
+        // Once one side is a leaf, the rest of the descent only tests that
+        // leaf, so its candidates are gathered and tested in batches
+        if (a.isLeaf() || b.isLeaf()) {
+            int32_t leaf = a.isLeaf() ? indexA : indexB;
+            int32_t other = a.isLeaf() ? indexB : indexA;
+            forEachBoxOverlap(
+              other, nodes[leaf].bounds, boxes[leaf], [&](int32_t found) {
+                  auto [first, second] = std::minmax(leaf, found);
+                  pairs.push_back({ static_cast<ProxyId>(first),
+                                    static_cast<ProxyId>(second) });
+              });
+            continue;
+        }
+
+        // Split the larger node
+        if (a.bounds.getSurfaceArea() >= b.bounds.getSurfaceArea()) {
+            nodePairs.push_back({ a.child1, indexB });
+            nodePairs.push_back({ a.child2, indexB });
+        } else {
+            nodePairs.push_back({ indexA, b.child1 });
+            nodePairs.push_back({ indexA, b.child2 });
+        }
+    }
+}
+
+void AABBTree::query(const BoundingBox_Quad& box,
+                     std::vector<ProxyId>& result) const {
+    Bounds bounds{ { box.minX, box.minY, box.minZ },
+                   { box.maxX, box.maxY, box.maxZ } };
+
+    forEachBoxOverlap(root, bounds, box, [&](int32_t leaf) {
+        result.push_back(static_cast<ProxyId>(leaf));
+    });
+}
+
+void AABBTree::raycast(const glm::vec3& from,
+                       const glm::vec3& to,
+                       std::vector<RayHit>& hits) const {
+    hits.clear();
+    if (root == nullNode) {
+        return;
+    }
+
+    glm::vec3 inverseDirection = 1.0f / (to - from);
+
+    stack.clear();
+    stack.push_back(root);
+    while (!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        int32_t index = stack.back();
+        stack.pop_back();
+
+        const Bounds& bounds = node.bounds;
+        if (intersectSegment(from, inverseDirection, bounds.min, bounds.max) <
+            0.0f) {
+            continue;
+        }
+
+        if (!node.isLeaf()) {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+            continue;
+        }
+
+        const BoundingBox_Quad& box = boxes[index];
+        float fraction = intersectSegment(from,
+                                          inverseDirection,
+                                          { box.minX, box.minY, box.minZ },
+                                          { box.maxX, box.maxY, box.maxZ });
+        if (fraction >= 0.0f) {
+            hits.push_back({ static_cast<ProxyId>(index), fraction });
+        }
+    }
+
+    std::sort(hits.begin(), hits.end(), [](const RayHit& a, const RayHit& b) {
+        return a.fraction < b.fraction;
+    });
+}
+
+int32_t AABBTree::getHeight() const {
+    return root == nullNode ? 0 : nodes[root].height;
+}
+
+int32_t AABBTree::allocateNode() {
+    int32_t node;
+    if (freeList != nullNode) {
+        node = freeList;
+        freeList = nodes[node].parent;
+        nodes[node] = Node{};
+    } else {
+        node = static_cast<int32_t>(nodes.size());
+        nodes.emplace_back();
+        boxes.emplace_back();
+        userData.push_back(nullptr);
+    }
+
+    nodes[node].height = 0;
+    return node;
+}
+
+void AABBTree::freeNode(int32_t node) {
+    nodes[node].parent = freeList;
+    nodes[node].height = -1;
+    userData[node] = nullptr;
+    freeList = node;
+}
+
+void AABBTree::insertLeaf(int32_t leaf) {
+    if (root == nullNode) {
+        root = leaf;
+        nodes[root].parent = nullNode;
+        return;
+    }
+
+    // Descend towards the sibling with the lowest cost. Pairing the leaf with
+    // a node costs the area of their union, plus the growth of every
+    // ancestor on the way down.
+    Bounds leafBounds = nodes[leaf].bounds;
+    int32_t index = root;
+    while (!nodes[index].isLeaf()) {
+        const Node& node = nodes[index];
+
+        float area = node.bounds.getSurfaceArea();
+        float combinedArea = Bounds::merge(node.bounds, leafBounds)
+                               .getSurfaceArea();
+
+        // Cost of making the leaf a sibling of this node
+        float cost = 2.0f * combinedArea;
+
+        // Minimum cost of pushing the leaf further down
+        float inheritance = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int32_t child) {
+            const Bounds& bounds = nodes[child].bounds;
+            float merged = Bounds::merge(leafBounds, bounds).getSurfaceArea();
+            if (nodes[child].isLeaf()) {
+                return merged + inheritance;
+            }
+            return merged - bounds.getSurfaceArea() + inheritance;
+        };
+        float cost1 = descendCost(node.child1);
+        float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2) {
+            break;
+        }
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+    int32_t sibling = index;
+
+    // Replace the sibling with a new parent of the sibling and the leaf
+    int32_t oldParent = nodes[sibling].parent;
+    int32_t newParent = allocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].bounds = Bounds::merge(leafBounds, nodes[sibling].bounds);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent == nullNode) {
+        root = newParent;
+    } else if (nodes[oldParent].child1 == sibling) {
+        nodes[oldParent].child1 = newParent;
+    } else {
+        nodes[oldParent].child2 = newParent;
+    }
+
+    refitAncestors(oldParent);
+}
+
+void AABBTree::removeLeaf(int32_t leaf) {
+    if (leaf == root) {
+        root = nullNode;
+        return;
+    }
+
+    // The sibling takes the parent's place
+    int32_t parent = nodes[leaf].parent;
+    int32_t grandParent = nodes[parent].parent;
+    int32_t sibling = nodes[parent].child1 == leaf ? nodes[parent].child2
+                                                   : nodes[parent].child1;
+
+    nodes[sibling].parent = grandParent;
+    if (grandParent == nullNode) {
+        root = sibling;
+    } else if (nodes[grandParent].child1 == parent) {
+        nodes[grandParent].child1 = sibling;
+    } else {
+        nodes[grandParent].child2 = sibling;
+    }
+    freeNode(parent);
+
+    refitAncestors(grandParent);
+}
+
+void AABBTree::refitAncestors(int32_t index) {
+    while (index != nullNode) {
+        index = balance(index);
+
+        Node& node = nodes[index];
+        const Node& child1 = nodes[node.child1];
+        const Node& child2 = nodes[node.child2];
+        node.height = 1 + std::max(child1.height, child2.height);
+        node.bounds = Bounds::merge(child1.bounds, child2.bounds);
+
+        index = node.parent;
+    }
+}
+
+int32_t AABBTree::balance(int32_t indexA) {
+    Node& a = nodes[indexA];
+    if (a.isLeaf() || a.height < 2) {
+        return indexA;
+    }
+
+    int32_t indexB = a.child1;
+    int32_t indexC = a.child2;
+    Node& b = nodes[indexB];
+    Node& c = nodes[indexC];
+
+    int32_t difference = c.height - b.height;
+    if (difference >= -1 && difference <= 1) {
+        return indexA;
+    }
+
+    // Rotate the taller child up into A's place. A keeps the shorter child,
+    // and takes the taller child's shorter grandchild.
+    bool rotateC = difference > 1;
+    int32_t indexUp = rotateC ? indexC : indexB;
+    Node& up = rotateC ? c : b;
+    Node& kept = rotateC ? b : c;
+
+    int32_t indexF = up.child1;
+    int32_t indexG = up.child2;
+    Node& f = nodes[indexF];
+    Node& g = nodes[indexG];
+
+    // `up` replaces A under A's parent
+    up.child1 = indexA;
+    up.parent = a.parent;
+    a.parent = indexUp;
+    if (up.parent == nullNode) {
+        root = indexUp;
+    } else if (nodes[up.parent].child1 == indexA) {
+        nodes[up.parent].child1 = indexUp;
+    } else {
+        nodes[up.parent].child2 = indexUp;
+    }
+
+    // The taller grandchild stays with `up`, the shorter one moves to A
+    bool keepF = f.height > g.height;
+    int32_t indexStays = keepF ? indexF : indexG;
+    int32_t indexMoves = keepF ? indexG : indexF;
+    Node& stays = keepF ? f : g;
+    Node& moves = keepF ? g : f;
+
+    up.child2 = indexStays;
+    if (rotateC) {
+        a.child2 = indexMoves;
+    } else {
+        a.child1 = indexMoves;
+    }
+    moves.parent = indexA;
+
+    a.bounds = Bounds::merge(kept.bounds, moves.bounds);
+    a.height = 1 + std::max(kept.height, moves.height);
+    up.bounds = Bounds::merge(a.bounds, stays.bounds);
+    up.height = 1 + std::max(a.height, stays.height);
+
+    return indexUp;
+}
+
+AABBTree::Bounds AABBTree::fatten(const BoundingBox_Quad& box) const {
+    glm::vec3 extension(margin);
+    return { glm::vec3(box.minX, box.minY, box.minZ) - extension,
+             glm::vec3(box.maxX, box.maxY, box.maxZ) + extension };
+}
+
+template<typename Visit>
+void AABBTree::forEachOverlap(int32_t start,
+                              const Bounds& bounds,
+                              Visit&& visit) const {
+    if (start == nullNode) {
+        return;
+    }
+
+    stack.clear();
+    stack.push_back(start);
+    while (!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        int32_t index = stack.back();
+        stack.pop_back();
+
+        if (!node.bounds.overlaps(bounds)) {
+            continue;
+        }
+
+        if (node.isLeaf()) {
+            visit(index);
+        } else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+template<typename Report>
+void AABBTree::forEachBoxOverlap(int32_t start,
+                                 const Bounds& bounds,
+                                 const BoundingBox_Quad& box,
+                                 Report&& report) const {
+    candidates.clear();
+    forEachOverlap(
+      start, bounds, [&](int32_t leaf) { candidates.push_back(leaf); });
+
+    // Many candidates are worth copying into a BoxArray, to test 8 boxes at
+    // a time
+    if (candidates.size() > BoxArray::batchSize) {
+        candidateBoxes.clear();
+        for (int32_t leaf : candidates) {
+            candidateBoxes.add(boxes[leaf]);
+        }
+
+        for (std::size_t first = 0; first < candidates.size();
+             first += BoxArray::batchSize) {
+            for (uint32_t mask = candidateBoxes.overlapBatch(box, first);
+                 mask != 0;
+                 mask &= mask - 1) {
+                report(candidates[first + std::countr_zero(mask)]);
+            }
+        }
+        return;
+    }
+
+    for (int32_t leaf : candidates) {
+        if (isOverlapping(box, boxes[leaf])) {
+            report(leaf);
+        }
+    }
+}
+
+} // namespace FW::Physics
@@ -0,0 +1,166 @@
+/**
+ * Broadphase collision detection with a dynamic bounding volume hierarchy.
+ *
+ * @file AABBTree.h
+ */
+
+#pragma once
+
+#include "pch.h"
+#include "BoxArray.h"
+#include "Broadphase.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace FW::Physics {
+
+/**
+ * Dynamic AABB tree, after Box2D's b2DynamicTree.
+ *
+ * Every box is a leaf of a binary tree whose inner nodes bound their
+ * children. Queries only descend into nodes that overlap, so the cost grows
+ * with log n and does not depend on how big the boxes are. Ships, bullets and
+ * large level pieces can share a tree.
+ *
+ * Leaves store a fat box, the real box grown by a margin on every side. A box
+ * that moves within its fat box leaves the tree untouched. Only when it leaves
+ * it, or shrinks well inside it, is the leaf removed and inserted again. The
+ * path from the new leaf to the root is then refit, and rotated wherever one
+ * child has grown more than one level taller than the other.
+ *
+ * New leaves are placed next to the sibling that increases the total surface
+ * area of the tree the least, which keeps queries tight.
+ */
+class AABBTree : public Broadphase {
+public:
+    /**
+     * @param margin How far the fat box extends beyond the real box on every
+     * side. Larger margins mean fewer reinsertions but more candidates.
+     */
+    explicit AABBTree(float margin = 2.0f);
+    virtual ~AABBTree() = default;
+
+    ProxyId insert(const BoundingBox_Quad& box,
+                   void* userData = nullptr) override;
+    void move(ProxyId proxy, const BoundingBox_Quad& box) override;
+    void remove(ProxyId proxy) override;
+    void clear() override;
+
+    /** Traverses the tree against itself, without a query per leaf. */
+    void findPairs(std::vector<ProxyPair>& pairs) const override;
+
+    void query(const BoundingBox_Quad& box,
+               std::vector<ProxyId>& result) const override;
+
+    void raycast(const glm::vec3& from,
+                 const glm::vec3& to,
+                 std::vector<RayHit>& hits) const override;
+
+    const BoundingBox_Quad& getBox(ProxyId proxy) const override {
+        return boxes[proxy];
+    }
+    void* getUserData(ProxyId proxy) const override {
+        return userData[proxy];
+    }
+
+    uint32_t getProxyCount() const override { return proxyCount; }
+
+    /** Levels below the root. An empty tree or a single leaf has height 0. */
+    int32_t getHeight() const;
+
+    /** Number of reinsertions caused by move() since construction. */
+    uint32_t getReinsertCount() const { return reinsertCount; }
+
+private:
+    static constexpr int32_t nullNode = -1;
+
+    struct Bounds {
+        glm::vec3 min;
+        glm::vec3 max;
+
+        bool contains(const Bounds& other) const;
+        bool overlaps(const Bounds& other) const;
+        float getSurfaceArea() const;
+        static Bounds merge(const Bounds& a, const Bounds& b);
+    };
+
+    struct Node {
+        /** Fat box of a leaf, or the union of the children. */
+        Bounds bounds;
+
+        /** Parent, or the next free node while on the free list. */
+        int32_t parent = nullNode;
+        int32_t child1 = nullNode;
+        int32_t child2 = nullNode;
+        /** 0 for leaves, -1 for free nodes. */
+        int32_t height = -1;
+
+        bool isLeaf() const { return child1 == nullNode; }
+    };
+
+    int32_t allocateNode();
+    void freeNode(int32_t node);
+
+    void insertLeaf(int32_t leaf);
+    void removeLeaf(int32_t leaf);
+
+    /** Refit and rebalance every node from `node` up to the root. */
+    void refitAncestors(int32_t node);
+
+    /**
+     * Rotate the taller child of `node` up if the heights of its children
+     * differ by more than one. Returns the node now in its place.
+     */
+    int32_t balance(int32_t node);
+
+    Bounds fatten(const BoundingBox_Quad& box) const;
+
+    /**
+     * Call `visit(leaf)` for every leaf under `start` whose fat box overlaps
+     * `bounds`.
+     */
+    template<typename Visit>
+    void forEachOverlap(int32_t start,
+                        const Bounds& bounds,
+                        Visit&& visit) const;
+
+    /**
+     * Call `report(leaf)` for every leaf under `start` whose box overlaps
+     * `box`. The leaves found by forEachOverlap() are tested 8 at a time
+     * once there are more than 8 of them.
+     */
+    template<typename Report>
+    void forEachBoxOverlap(int32_t start,
+                           const Bounds& bounds,
+                           const BoundingBox_Quad& box,
+                           Report&& report) const;
+
+private:
+    float margin;
+
+    std::vector<Node> nodes;
+    /**
+     * The real box and user data of each leaf, by node index. Kept out of
+     * `nodes` so traversals touch less memory.
+     */
+    std::vector<BoundingBox_Quad> boxes;
+    std::vector<void*> userData;
+    int32_t root = nullNode;
+    int32_t freeList = nullNode;
+    uint32_t proxyCount = 0;
+    uint32_t reinsertCount = 0;
+
+    /** Reused traversal stack. */
+    mutable std::vector<int32_t> stack;
+    /** Reused by findPairs(). */
+    mutable std::vector<std::pair<int32_t, int32_t>> nodePairs;
+    /** Reused by forEachBoxOverlap(). */
+    mutable std::vector<int32_t> candidates;
+    mutable BoxArray candidateBoxes;
+};
+
+} // namespace FW::Physics
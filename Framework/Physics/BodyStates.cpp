@@ -0,0 +1,62 @@
+#include "BodyStates.h"
+#include "assertions.h"
+
+namespace FW::Physics {
+
+std::size_t BodyStates::add(const glm::vec3& position, float mass) {
+    positionX.push_back(position.x);
+    positionY.push_back(position.y);
+    positionZ.push_back(position.z);
+    velocityX.push_back(0.0f);
+    velocityY.push_back(0.0f);
+    velocityZ.push_back(0.0f);
+    forceX.push_back(0.0f);
+    forceY.push_back(0.0f);
+    forceZ.push_back(0.0f);
+    this->mass.push_back(0.0f);
+    inverseMass.push_back(0.0f);
+
+    std::size_t index = size() - 1;
+    setMass(index, mass);
+    return index;
+}
+
+void BodyStates::swapRemove(std::size_t index) {
+    ASSERT(index < size(), "Body index out of range.");
+
+    for (auto* component : { &positionX,
+                             &positionY,
+                             &positionZ,
+                             &velocityX,
+                             &velocityY,
+                             &velocityZ,
+                             &forceX,
+                             &forceY,
+                             &forceZ,
+                             &mass,
+                             &inverseMass }) {
+        (*component)[index] = component->back();
+        component->pop_back();
+    }
+}
+
+void BodyStates::setMass(std::size_t index, float mass) {
+    ASSERT(mass >= 0.0f, "Mass must not be negative.");
+
+    this->mass[index] = mass;
+    inverseMass[index] = mass > 0.0f ? 1.0f / mass : 0.0f;
+}
+
+void BodyStates::setPosition(std::size_t index, const glm::vec3& position) {
+    positionX[index] = position.x;
+    positionY[index] = position.y;
+    positionZ[index] = position.z;
+}
+
+void BodyStates::setVelocity(std::size_t index, const glm::vec3& velocity) {
+    velocityX[index] = velocity.x;
+    velocityY[index] = velocity.y;
+    velocityZ[index] = velocity.z;
+}
+
+} // namespace FW::Physics
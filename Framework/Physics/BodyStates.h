@@ -0,0 +1,58 @@
+/**
+ * The simulated state of the bodies in a Solver.
+ *
+ * @file BodyStates.h
+ */
+
+#pragma once
+
+#include "pch.h"
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace FW::Physics {
+
+/**
+ * Position, velocity, mass and accumulated force of every body, with one
+ * array per component.
+ *
+ * Forces and the integrator run one loop over a few of the arrays, so the
+ * compiler can turn each loop into SIMD instructions. Bodies are densely
+ * packed: removing one moves the last body into its place.
+ */
+struct BodyStates {
+    std::vector<float> positionX, positionY, positionZ;
+    std::vector<float> velocityX, velocityY, velocityZ;
+
+    /** Sum of the forces applied since the last step. */
+    std::vector<float> forceX, forceY, forceZ;
+
+    /** 0 for static bodies, which forces do not move. */
+    std::vector<float> mass;
+    std::vector<float> inverseMass;
+
+    std::size_t size() const { return mass.size(); }
+
+    /** Append a body at rest. Returns its index. */
+    std::size_t add(const glm::vec3& position, float mass);
+
+    /** Remove body `index` by moving the last body into its place. */
+    void swapRemove(std::size_t index);
+
+    void setMass(std::size_t index, float mass);
+
+    glm::vec3 getPosition(std::size_t index) const {
+        return { positionX[index], positionY[index], positionZ[index] };
+    }
+    void setPosition(std::size_t index, const glm::vec3& position);
+
+    glm::vec3 getVelocity(std::size_t index) const {
+        return { velocityX[index], velocityY[index], velocityZ[index] };
+    }
+    void setVelocity(std::size_t index, const glm::vec3& velocity);
+};
+
+} // namespace FW::Physics
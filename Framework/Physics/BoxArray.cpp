@@ -0,0 +1,274 @@
+#include "BoxArray.h"
+#include "assertions.h"
+
+#include <bit>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define FW_PHYSICS_X86_64
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang only emit AVX2 instructions in functions that ask for them.
+// MSVC emits them anywhere.
+#if defined(FW_PHYSICS_X86_64) && (defined(__GNUC__) || defined(__clang__))
+#define FW_PHYSICS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define FW_PHYSICS_TARGET_AVX2
+#endif
+
+namespace FW::Physics {
+
+// Constant initialized, so boxes tested before the selection below still get
+// a working kernel
+OverlapKernel BoxArray::selectedKernel = OverlapKernel::Scalar;
+BoxArray::KernelFunction BoxArray::kernel = &BoxArray::overlapScalar;
+
+[[maybe_unused]] static const bool kernelSelected = [] {
+    return BoxArray::setKernel(OverlapKernel::AVX2) ||
+           BoxArray::setKernel(OverlapKernel::SSE);
+}();
+
+BoxArray::BoxArray() {
+    clear();
+}
+
+uint32_t BoxArray::add(const BoundingBox_Quad& box) {
+    // Overwrite the first empty box, and append a new one to keep the
+    // padding the same length
+    minX.push_back(std::numeric_limits<float>::infinity());
+    maxX.push_back(-std::numeric_limits<float>::infinity());
+    minY.push_back(std::numeric_limits<float>::infinity());
+    maxY.push_back(-std::numeric_limits<float>::infinity());
+    minZ.push_back(std::numeric_limits<float>::infinity());
+    maxZ.push_back(-std::numeric_limits<float>::infinity());
+
+    auto index = static_cast<uint32_t>(count++);
+    set(index, box);
+    return index;
+}
+
+void BoxArray::set(uint32_t index, const BoundingBox_Quad& box) {
+    ASSERT(index < count, "Box index out of range.");
+
+    minX[index] = box.minX;
+    maxX[index] = box.maxX;
+    minY[index] = box.minY;
+    maxY[index] = box.maxY;
+    minZ[index] = box.minZ;
+    maxZ[index] = box.maxZ;
+}
+
+void BoxArray::clear() {
+    count = 0;
+    minX.assign(batchSize - 1, std::numeric_limits<float>::infinity());
+    maxX.assign(batchSize - 1, -std::numeric_limits<float>::infinity());
+    minY.assign(batchSize - 1, std::numeric_limits<float>::infinity());
+    maxY.assign(batchSize - 1, -std::numeric_limits<float>::infinity());
+    minZ.assign(batchSize - 1, std::numeric_limits<float>::infinity());
+    maxZ.assign(batchSize - 1, -std::numeric_limits<float>::infinity());
+}
+
+void BoxArray::reserve(std::size_t capacity) {
+    for (auto* bounds : { &minX, &maxX, &minY, &maxY, &minZ, &maxZ }) {
+        bounds->reserve(capacity + batchSize - 1);
+    }
+}
+
+void BoxArray::query(const BoundingBox_Quad& box,
+                     std::vector<uint32_t>& result) const {
+    for (std::size_t first = 0; first < count; first += batchSize) {
+        for (uint32_t mask = kernel(box, *this, first); mask != 0;
+             mask &= mask - 1) {
+            result.push_back(
+              static_cast<uint32_t>(first + std::countr_zero(mask)));
+        }
+    }
+}
+
+void BoxArray::findPairs(std::vector<ProxyPair>& pairs) const {
+    pairs.clear();
+
+    for (std::size_t i = 0; i < count; i++) {
+        BoundingBox_Quad box = getBounds(i);
+
+        // Only the boxes after i, so each pair is tested once
+        for (std::size_t first = i + 1; first < count; first += batchSize) {
+            for (uint32_t mask = kernel(box, *this, first); mask != 0;
+                 mask &= mask - 1) {
+                pairs.push_back(
+                  { static_cast<ProxyId>(i),
+                    static_cast<ProxyId>(first + std::countr_zero(mask)) });
+            }
+        }
+    }
+}
+
+bool BoxArray::setKernel(OverlapKernel kernel) {
+    if (!isKernelSupported(kernel)) {
+        return false;
+    }
+
+    selectedKernel = kernel;
+    BoxArray::kernel = getKernelFunction(kernel);
+    return true;
+}
+
+OverlapKernel BoxArray::getKernel() {
+    return selectedKernel;
+}
+
+bool BoxArray::isKernelSupported(OverlapKernel kernel) {
+    switch (kernel) {
+        case OverlapKernel::Scalar:
+            return true;
+#ifdef FW_PHYSICS_X86_64
+        case OverlapKernel::SSE:
+            return true;
+        case OverlapKernel::AVX2: {
+#if defined(_MSC_VER)
+            // AVX2 support in the CPU, and AVX state saving in the OS
+            int info[4];
+            __cpuidex(info, 7, 0);
+            bool avx2 = (info[1] & (1 << 5)) != 0;
+            __cpuid(info, 1);
+            bool osxsave = (info[2] & (1 << 27)) != 0;
+            return avx2 && osxsave && (_xgetbv(0) & 0x6) == 0x6;
+#else
+            // Needed when called before static constructors have run, as
+            // during the selection at startup
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#endif
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+BoxArray::KernelFunction BoxArray::getKernelFunction(OverlapKernel kernel) {
+    switch (kernel) {
+        case OverlapKernel::SSE:
+            return &BoxArray::overlapSSE;
+        case OverlapKernel::AVX2:
+            return &BoxArray::overlapAVX2;
+        case OverlapKernel::Scalar:
+        default:
+            return &BoxArray::overlapScalar;
+    }
+}
+
+BoundingBox_Quad BoxArray::getBounds(std::size_t index) const {
+    BoundingBox_Quad box;
+    box.minX = minX[index];
+    box.maxX = maxX[index];
+    box.minY = minY[index];
+    box.maxY = maxY[index];
+    box.minZ = minZ[index];
+    box.maxZ = maxZ[index];
+    return box;
+}
+
+uint32_t BoxArray::overlapScalar(const BoundingBox_Quad& box,
+                                 const BoxArray& boxes,
+                                 std::size_t first) {
+    // Same test as FW::isOverlapping(). The bitwise ands avoid a branch per
+    // comparison.
+    uint32_t mask = 0;
+    for (std::size_t i = 0; i < batchSize; i++) {
+        std::size_t other = first + i;
+        bool hit = (box.minX <= boxes.maxX[other]) &
+                   (box.maxX >= boxes.minX[other]) &
+                   (box.minY <= boxes.maxY[other]) &
+                   (box.maxY >= boxes.minY[other]) &
+                   (box.minZ <= boxes.maxZ[other]) &
+                   (box.maxZ >= boxes.minZ[other]);
+        mask |= static_cast<uint32_t>(hit) << i;
+    }
+    return mask;
+}
+
+#ifdef FW_PHYSICS_X86_64
+
+uint32_t BoxArray::overlapSSE(const BoundingBox_Quad& box,
+                              const BoxArray& boxes,
+                              std::size_t first) {
+    __m128 boxMinX = _mm_set1_ps(box.minX);
+    __m128 boxMaxX = _mm_set1_ps(box.maxX);
+    __m128 boxMinY = _mm_set1_ps(box.minY);
+    __m128 boxMaxY = _mm_set1_ps(box.maxY);
+    __m128 boxMinZ = _mm_set1_ps(box.minZ);
+    __m128 boxMaxZ = _mm_set1_ps(box.maxZ);
+
+    uint32_t mask = 0;
+    for (std::size_t half = 0; half < batchSize; half += 4) {
+        std::size_t other = first + half;
+        __m128 hit = _mm_and_ps(
+          _mm_cmple_ps(boxMinX, _mm_loadu_ps(&boxes.maxX[other])),
+          _mm_cmpge_ps(boxMaxX, _mm_loadu_ps(&boxes.minX[other])));
+        hit = _mm_and_ps(
+          hit, _mm_cmple_ps(boxMinY, _mm_loadu_ps(&boxes.maxY[other])));
+        hit = _mm_and_ps(
+          hit, _mm_cmpge_ps(boxMaxY, _mm_loadu_ps(&boxes.minY[other])));
+        hit = _mm_and_ps(
+          hit, _mm_cmple_ps(boxMinZ, _mm_loadu_ps(&boxes.maxZ[other])));
+        hit = _mm_and_ps(
+          hit, _mm_cmpge_ps(boxMaxZ, _mm_loadu_ps(&boxes.minZ[other])));
+        mask |= static_cast<uint32_t>(_mm_movemask_ps(hit)) << half;
+    }
+    return mask;
+}
+
+FW_PHYSICS_TARGET_AVX2
+uint32_t BoxArray::overlapAVX2(const BoundingBox_Quad& box,
+                               const BoxArray& boxes,
+                               std::size_t first) {
+    // Ordered comparisons, so NaN bounds never overlap, as in the scalar test
+    __m256 hit = _mm256_and_ps(
+      _mm256_cmp_ps(_mm256_set1_ps(box.minX),
+                    _mm256_loadu_ps(&boxes.maxX[first]),
+                    _CMP_LE_OQ),
+      _mm256_cmp_ps(_mm256_set1_ps(box.maxX),
+                    _mm256_loadu_ps(&boxes.minX[first]),
+                    _CMP_GE_OQ));
+    hit = _mm256_and_ps(hit,
+                        _mm256_cmp_ps(_mm256_set1_ps(box.minY),
+                                      _mm256_loadu_ps(&boxes.maxY[first]),
+                                      _CMP_LE_OQ));
+    hit = _mm256_and_ps(hit,
+                        _mm256_cmp_ps(_mm256_set1_ps(box.maxY),
+                                      _mm256_loadu_ps(&boxes.minY[first]),
+                                      _CMP_GE_OQ));
+    hit = _mm256_and_ps(hit,
+                        _mm256_cmp_ps(_mm256_set1_ps(box.minZ),
+                                      _mm256_loadu_ps(&boxes.maxZ[first]),
+                                      _CMP_LE_OQ));
+    hit = _mm256_and_ps(hit,
+                        _mm256_cmp_ps(_mm256_set1_ps(box.maxZ),
+                                      _mm256_loadu_ps(&boxes.minZ[first]),
+                                      _CMP_GE_OQ));
+    return static_cast<uint32_t>(_mm256_movemask_ps(hit));
+}
+
+#else
+
+// Never selected, as isKernelSupported() rejects them
+uint32_t BoxArray::overlapSSE(const BoundingBox_Quad& box,
+                              const BoxArray& boxes,
+                              std::size_t first) {
+    return overlapScalar(box, boxes, first);
+}
+
+uint32_t BoxArray::overlapAVX2(const BoundingBox_Quad& box,
+                               const BoxArray& boxes,
+                               std::size_t first) {
+    return overlapScalar(box, boxes, first);
+}
+
+#endif
+
+} // namespace FW::Physics
@@ -0,0 +1,137 @@
+/**
+ * Bounding boxes stored as structure of arrays, for testing many boxes at
+ * once with SIMD instructions.
+ *
+ * @file BoxArray.h
+ */
+
+#pragma once
+
+#include "pch.h"
+#include "Broadphase.h"
+#include "Physics.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace FW::Physics {
+
+/** The implementations of BoxArray::overlapBatch(). */
+enum class OverlapKernel {
+    /** Plain C++, available everywhere. */
+    Scalar,
+    /** Two groups of 4 boxes. Every x86-64 CPU has SSE2. */
+    SSE,
+    /** All 8 boxes in one group. Used when the CPU supports AVX2. */
+    AVX2,
+};
+
+/**
+ * Each bound of every box in its own array: minX[], maxX[], minY[] and so on.
+ *
+ * BoundingBox_Quad keeps the six bounds of a box next to each other, so
+ * testing a box against many others loads them one at a time. Here the same
+ * bound of 8 neighbouring boxes is one load, and a single overlap test covers
+ * all 8.
+ *
+ * The arrays are followed by empty boxes that never overlap anything, so a
+ * batch may start at any index below size().
+ *
+ * @code{.cpp}
+ * FW::Physics::BoxArray boxes;
+ * for (const auto& box : levelBoxes) {
+ *     boxes.add(box);
+ * }
+ *
+ * std::vector<FW::Physics::ProxyPair> pairs;
+ * boxes.findPairs(pairs);
+ * @endcode
+ */
+class BoxArray {
+public:
+    /** Number of boxes tested by one call to overlapBatch(). */
+    static constexpr std::size_t batchSize = 8;
+
+    BoxArray();
+    virtual ~BoxArray() = default;
+
+    /** Append a box. Returns its index. */
+    uint32_t add(const BoundingBox_Quad& box);
+    void set(uint32_t index, const BoundingBox_Quad& box);
+    void clear();
+    void reserve(std::size_t capacity);
+
+    std::size_t size() const { return count; }
+
+    /**
+     * Test `box` against the boxes from `first` to `first + batchSize`.
+     *
+     * @return Bit i is set if box `first + i` overlaps. Indices at or beyond
+     * size() are never set.
+     */
+    uint32_t overlapBatch(const BoundingBox_Quad& box,
+                          std::size_t first) const {
+        return kernel(box, *this, first);
+    }
+
+    /** Append the index of every box that overlaps `box` to `result`. */
+    void query(const BoundingBox_Quad& box,
+               std::vector<uint32_t>& result) const;
+
+    /**
+     * Test every box against every other box, and report each overlapping
+     * pair once, by index.
+     *
+     * @details Still O(n²), but 8 tests at a time. Use it for small sets of
+     * boxes, and a Broadphase for large ones.
+     *
+     * @param pairs Cleared, then filled.
+     */
+    void findPairs(std::vector<ProxyPair>& pairs) const;
+
+    /**
+     * Select the kernel used by overlapBatch() in every BoxArray.
+     *
+     * The fastest kernel the CPU supports is selected at startup, so this is
+     * only needed to compare kernels. Not thread safe.
+     *
+     * @return false if the CPU does not support `kernel`. The selection is
+     * then unchanged.
+     */
+    static bool setKernel(OverlapKernel kernel);
+    static OverlapKernel getKernel();
+    static bool isKernelSupported(OverlapKernel kernel);
+
+private:
+    using KernelFunction = uint32_t (*)(const BoundingBox_Quad& box,
+                                        const BoxArray& boxes,
+                                        std::size_t first);
+
+    static uint32_t overlapScalar(const BoundingBox_Quad& box,
+                                  const BoxArray& boxes,
+                                  std::size_t first);
+    static uint32_t overlapSSE(const BoundingBox_Quad& box,
+                               const BoxArray& boxes,
+                               std::size_t first);
+    static uint32_t overlapAVX2(const BoundingBox_Quad& box,
+                                const BoxArray& boxes,
+                                std::size_t first);
+
+    static KernelFunction getKernelFunction(OverlapKernel kernel);
+
+    /** Box `index` with only its bounds set. */
+    BoundingBox_Quad getBounds(std::size_t index) const;
+
+private:
+    /** count boxes, then batchSize - 1 empty boxes. */
+    std::vector<float> minX, maxX;
+    std::vector<float> minY, maxY;
+    std::vector<float> minZ, maxZ;
+    std::size_t count = 0;
+
+    static OverlapKernel selectedKernel;
+    static KernelFunction kernel;
+};
+
+} // namespace FW::Physics
@@ -0,0 +1,45 @@
+#include "Broadphase.h"
+#include "AABBTree.h"
+#include "SpatialHash.h"
+
+#include <algorithm>
+
+namespace FW::Physics {
+
+scope<Broadphase> Broadphase::create(BroadphaseType type) {
+    switch (type) {
+        case BroadphaseType::SpatialHash:
+            return createScope<SpatialHash>();
+        case BroadphaseType::AABBTree:
+        default:
+            return createScope<AABBTree>();
+    }
+}
+
+float Broadphase::intersectSegment(const glm::vec3& from,
+                                   const glm::vec3& inverseDirection,
+                                   const glm::vec3& boxMin,
+                                   const glm::vec3& boxMax) {
+    // Slab test. Clip [0, 1] by the fractions where the segment enters and
+    // leaves each pair of planes. Parallel axes produce infinities, or NaN
+    // when the segment lies on a plane, which std::min and std::max skip.
+    float enter = 0.0f;
+    float leave = 1.0f;
+
+    for (int axis = 0; axis < 3; axis++) {
+        float nearPlane = (boxMin[axis] - from[axis]) * inverseDirection[axis];
+        float farPlane = (boxMax[axis] - from[axis]) * inverseDirection[axis];
+        if (nearPlane > farPlane) {
+            std::swap(nearPlane, farPlane);
+        }
+
+        enter = std::max(enter, nearPlane);
+        leave = std::min(leave, farPlane);
+        if (enter > leave) {
+            return -1.0f;
+        }
+    }
+    return enter;
+}
+
+} // namespace FW::Physics
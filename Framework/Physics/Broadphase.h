@@ -0,0 +1,123 @@
+/**
+ * Common interface of the broadphase collision detection structures.
+ *
+ * A broadphase keeps track of a set of bounding boxes and quickly finds the
+ * ones that overlap, so the expensive narrowphase only runs on pairs that can
+ * actually collide.
+ *
+ * @file Broadphase.h
+ */
+
+#pragma once
+
+#include "pch.h"
+#include "Physics.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace FW::Physics {
+
+/** Handle to a box in a broadphase. */
+using ProxyId = uint32_t;
+
+/** Two proxies whose boxes overlap. `a` is always less than `b`. */
+struct ProxyPair {
+    ProxyId a;
+    ProxyId b;
+
+    bool operator==(const ProxyPair&) const = default;
+};
+
+/** A box hit by a ray. */
+struct RayHit {
+    ProxyId proxy;
+    /** Where the box was entered, from 0 at the start to 1 at the end. */
+    float fraction;
+};
+
+/** The available broadphase implementations. */
+enum class BroadphaseType {
+    /** Uniform grid. Best when boxes are of similar size. */
+    SpatialHash,
+    /** Dynamic bounding volume hierarchy. Handles any mix of sizes. */
+    AABBTree,
+};
+
+class Broadphase {
+public:
+    Broadphase() = default;
+    virtual ~Broadphase() = default;
+
+    /**
+     * Add a box.
+     *
+     * @param userData Returned by getUserData(), usually the owning entity.
+     * @return Handle to move or remove the box later. Handles of removed
+     * boxes may be reused.
+     */
+    virtual ProxyId insert(const BoundingBox_Quad& box,
+                           void* userData = nullptr) = 0;
+
+    /** Update the bounds of a box that has moved or changed size. */
+    virtual void move(ProxyId proxy, const BoundingBox_Quad& box) = 0;
+
+    virtual void remove(ProxyId proxy) = 0;
+
+    /** Remove every box. */
+    virtual void clear() = 0;
+
+    /**
+     * Find every pair of overlapping boxes, each pair once.
+     *
+     * @param pairs Cleared, then filled. Reuse it between calls to avoid
+     * allocating.
+     */
+    virtual void findPairs(std::vector<ProxyPair>& pairs) const = 0;
+
+    /** Append every proxy whose box overlaps `box` to `result`. */
+    virtual void query(const BoundingBox_Quad& box,
+                       std::vector<ProxyId>& result) const = 0;
+
+    /** Append every proxy whose box contains `point` to `result`. */
+    void queryPoint(const glm::vec3& point,
+                    std::vector<ProxyId>& result) const {
+        BoundingBox_Quad box;
+        box.setScale(0.0f);
+        box.setPosition(point);
+        query(box, result);
+    }
+
+    /**
+     * Find the boxes crossed by the segment from `from` to `to`.
+     *
+     * @param hits Cleared, then filled in order of distance from `from`.
+     */
+    virtual void raycast(const glm::vec3& from,
+                         const glm::vec3& to,
+                         std::vector<RayHit>& hits) const = 0;
+
+    /** The box as last inserted or moved. */
+    virtual const BoundingBox_Quad& getBox(ProxyId proxy) const = 0;
+    virtual void* getUserData(ProxyId proxy) const = 0;
+
+    /** Number of boxes in the broadphase. */
+    virtual uint32_t getProxyCount() const = 0;
+
+    /** Create an empty broadphase of the given type, with default settings. */
+    static scope<Broadphase> create(BroadphaseType type);
+
+protected:
+    /**
+     * Where the segment from `from` along `direction` enters `box`, as a
+     * fraction of `direction`. Returns a negative number if it misses.
+     */
+    static float intersectSegment(const glm::vec3& from,
+                                  const glm::vec3& inverseDirection,
+                                  const glm::vec3& boxMin,
+                                  const glm::vec3& boxMax);
+};
+
+} // namespace FW::Physics
@@ -1,5 +1,19 @@
 #include "Force.h"
 
-void FW::Physics::GravityForce::update(float delta) {
-    
-}
\ No newline at end of file
+/** force[i] += acceleration * mass[i], which the compiler can vectorize. */
+static void addWeight(float* force,
+                      const float* mass,
+                      std::size_t count,
+                      float acceleration) {
+    for (std::size_t i = 0; i < count; i++) {
+        force[i] += acceleration * mass[i];
+    }
+}
+
+void FW::Physics::GravityForce::apply(BodyStates& bodies) {
+    // Static bodies have no mass, so gravity leaves them alone
+    std::size_t count = bodies.size();
+    addWeight(bodies.forceX.data(), bodies.mass.data(), count, acceleration.x);
+    addWeight(bodies.forceY.data(), bodies.mass.data(), count, acceleration.y);
+    addWeight(bodies.forceZ.data(), bodies.mass.data(), count, acceleration.z);
+}
@@ -1,25 +1,47 @@
 #pragma once
 
+#include "BodyStates.h"
+
 #include "glm/glm.hpp"
 
 namespace FW::Physics {
 
+/**
+ * A force that acts on every body in a Solver.
+ *
+ * Forces are applied once per Solver::update(), before the bodies move.
+ */
 class Force {
 public:
     Force() = default;
     virtual ~Force() = default;
-    virtual void update(float delta) = 0;
+
+    /** Add this force to `bodies.forceX`, `forceY` and `forceZ`. */
+    virtual void apply(BodyStates& bodies) = 0;
 };
 
+/**
+ * Accelerates every body equally, whatever its mass.
+ *
+ * The default is Earth's gravity in metres per second squared. Games that
+ * measure in pixels will want a larger value.
+ */
 class GravityForce : public Force {
 public:
     GravityForce() = default;
+    explicit GravityForce(const glm::vec3& acceleration)
+      : acceleration(acceleration) {}
     virtual ~GravityForce() = default;
 
-    virtual void update(float delta);
+    virtual void apply(BodyStates& bodies) override;
+
+    void setAcceleration(const glm::vec3& acceleration) {
+        this->acceleration = acceleration;
+    }
+    glm::vec3 getAcceleration() const { return acceleration; }
 
 private:
     glm::vec3 acceleration{ 0.0f, -9.8067f, 0.0f };
 };
 
-} // namespace FW::Physics
\ No newline at end of file
+} // namespace FW::Physics
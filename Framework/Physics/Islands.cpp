@@ -0,0 +1,102 @@
+#include "Islands.h"
+
+#include <numeric>
+
+namespace FW::Physics {
+
+void IslandBuilder::build(std::size_t bodyCount,
+                          const std::vector<BodyPair>& contacts,
+                          const float* inverseMass) {
+    parents.resize(bodyCount);
+    std::iota(parents.begin(), parents.end(), 0u);
+    touched.assign(bodyCount, 0);
+
+    for (const BodyPair& contact : contacts) {
+        bool movingA = inverseMass[contact.a] > 0.0f;
+        bool movingB = inverseMass[contact.b] > 0.0f;
+        touched[contact.a] |= movingA;
+        touched[contact.b] |= movingB;
+        if (movingA && movingB) {
+            join(contact.a, contact.b);
+        }
+    }
+
+    // Number the islands in order of their lowest body
+    islands.clear();
+    islandOfRoot.assign(bodyCount, noIsland);
+    for (uint32_t body = 0; body < bodyCount; body++) {
+        if (!touched[body]) {
+            continue;
+        }
+
+        uint32_t root = findRoot(body);
+        if (islandOfRoot[root] == noIsland) {
+            islandOfRoot[root] = static_cast<uint32_t>(islands.size());
+            islands.emplace_back();
+        }
+        islands[islandOfRoot[root]].bodyCount++;
+    }
+
+    auto islandOfContact = [&](const BodyPair& contact) {
+        uint32_t moving = inverseMass[contact.a] > 0.0f ? contact.a : contact.b;
+        return islandOfRoot[findRoot(moving)];
+    };
+    for (const BodyPair& contact : contacts) {
+        if (inverseMass[contact.a] > 0.0f || inverseMass[contact.b] > 0.0f) {
+            islands[islandOfContact(contact)].contactCount++;
+        }
+    }
+
+    // Lay the islands out one after another, then fill them in order
+    uint32_t bodyOffset = 0;
+    uint32_t contactOffset = 0;
+    for (Island& island : islands) {
+        island.firstBody = bodyOffset;
+        island.firstContact = contactOffset;
+        bodyOffset += island.bodyCount;
+        contactOffset += island.contactCount;
+    }
+
+    bodies.resize(bodyOffset);
+    cursors.resize(islands.size());
+    for (std::size_t i = 0; i < islands.size(); i++) {
+        cursors[i] = islands[i].firstBody;
+    }
+    for (uint32_t body = 0; body < bodyCount; body++) {
+        if (touched[body]) {
+            bodies[cursors[islandOfRoot[findRoot(body)]]++] = body;
+        }
+    }
+
+    this->contacts.resize(contactOffset);
+    for (std::size_t i = 0; i < islands.size(); i++) {
+        cursors[i] = islands[i].firstContact;
+    }
+    for (uint32_t i = 0; i < contacts.size(); i++) {
+        const BodyPair& contact = contacts[i];
+        if (inverseMass[contact.a] > 0.0f || inverseMass[contact.b] > 0.0f) {
+            this->contacts[cursors[islandOfContact(contact)]++] = i;
+        }
+    }
+}
+
+uint32_t IslandBuilder::findRoot(uint32_t body) {
+    // Path halving: point every other node on the way at its grandparent
+    while (parents[body] != body) {
+        parents[body] = parents[parents[body]];
+        body = parents[body];
+    }
+    return body;
+}
+
+void IslandBuilder::join(uint32_t a, uint32_t b) {
+    uint32_t rootA = findRoot(a);
+    uint32_t rootB = findRoot(b);
+    if (rootA < rootB) {
+        parents[rootB] = rootA;
+    } else if (rootB < rootA) {
+        parents[rootA] = rootB;
+    }
+}
+
+} // namespace FW::Physics
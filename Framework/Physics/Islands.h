@@ -0,0 +1,101 @@
+/**
+ * Grouping of bodies into islands that can be simulated independently.
+ *
+ * @file Islands.h
+ */
+
+#pragma once
+
+#include "pch.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace FW::Physics {
+
+/** Two bodies in contact, by index. */
+struct BodyPair {
+    uint32_t a;
+    uint32_t b;
+};
+
+/**
+ * Bodies connected by contacts, directly or through other bodies.
+ *
+ * Solving the contacts of one island never touches the moving bodies of
+ * another, so islands can be solved in parallel.
+ */
+struct Island {
+    /** Range in IslandBuilder::getBodies(). */
+    uint32_t firstBody = 0;
+    uint32_t bodyCount = 0;
+
+    /** Range in IslandBuilder::getContacts(). */
+    uint32_t firstContact = 0;
+    uint32_t contactCount = 0;
+};
+
+/**
+ * Finds the islands of a contact graph with union-find.
+ *
+ * Static bodies do not join islands together. A box resting on the ground
+ * is in the same island as the boxes stacked on it, but not as another
+ * stack on the same ground. Contacts with static bodies belong to the island
+ * of the moving body, so a static body may appear in the contacts of several
+ * islands. It must only be read while solving them.
+ *
+ * The result depends only on the order of the contacts, so the same contacts
+ * always produce the same islands, in the same order.
+ */
+class IslandBuilder {
+public:
+    IslandBuilder() = default;
+    virtual ~IslandBuilder() = default;
+
+    /**
+     * Group the bodies touched by `contacts`.
+     *
+     * @param bodyCount Bodies are numbered from 0 to bodyCount - 1.
+     * @param contacts Pairs of bodies in contact. Pairs of static bodies are
+     * ignored.
+     * @param inverseMass 0 marks a static body.
+     */
+    void build(std::size_t bodyCount,
+               const std::vector<BodyPair>& contacts,
+               const float* inverseMass);
+
+    /** Islands in order of their lowest body. */
+    const std::vector<Island>& getIslands() const { return islands; }
+
+    /** Moving bodies with contacts, grouped by island, in increasing order. */
+    const std::vector<uint32_t>& getBodies() const { return bodies; }
+
+    /**
+     * Indices into the contacts passed to build(), grouped by island, in the
+     * order they were passed.
+     */
+    const std::vector<uint32_t>& getContacts() const { return contacts; }
+
+private:
+    uint32_t findRoot(uint32_t body);
+    void join(uint32_t a, uint32_t b);
+
+private:
+    static constexpr uint32_t noIsland = UINT32_MAX;
+
+    /** Union-find forest over the bodies. */
+    std::vector<uint32_t> parents;
+    /** Island of each root body, or noIsland. */
+    std::vector<uint32_t> islandOfRoot;
+    /** Moving bodies with at least one contact. */
+    std::vector<uint8_t> touched;
+    /** Next free slot of each island while filling. */
+    std::vector<uint32_t> cursors;
+
+    std::vector<Island> islands;
+    std::vector<uint32_t> bodies;
+    std::vector<uint32_t> contacts;
+};
+
+} // namespace FW::Physics
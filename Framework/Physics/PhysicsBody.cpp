@@ -1,3 +0,0 @@
-#include "PhysicsBody.h"
-
-void FW::Physics::RigidBody::update(float delta) {}
\ No newline at end of file
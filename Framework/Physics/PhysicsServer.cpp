@@ -1,12 +1,16 @@
 #include "PhysicsServer.h"
+#include "JobSystem.h"
 #include "assertions.h"
 
 void FW::Physics::PhysicsServer::update() {
     ASSERT(stepSize > 0, "Step size must be greater than 0.");
 
+    JobSystem& jobs = JobSystem::get();
     for (int i = 0; i < stepSize; i++) {
         for (auto& solver : solvers) {
-            solver.update(delta);
+            solver->update(delta, jobs);
         }
     }
+
+    broadphase->findPairs(pairs);
 }
\ No newline at end of file
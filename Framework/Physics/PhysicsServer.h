@@ -16,6 +16,7 @@
 
 #include "pch.h"
 
+#include "Broadphase.h"
 #include "Solver.h"
 
 namespace FW::Physics {
@@ -27,13 +28,36 @@ class PhysicsServer {
 
     /**
      * Update the underlying physics engines.
+     *
+     * The islands of each solver are solved in parallel on the shared
+     * JobSystem.
      */
     void update();
 
+    /** Update `solver` on every update(). */
+    void addSolver(ref<Solver> solver) { solvers.push_back(solver); }
+
     void setDelta(float delta) {
         this->delta = delta;
     }
 
+    /**
+     * Replace the broadphase with an empty one of the given type.
+     *
+     * NB! Every box in the current broadphase is discarded, so this should be
+     * called before any boxes are inserted.
+     */
+    void setBroadphase(BroadphaseType type) {
+        broadphase = Broadphase::create(type);
+        pairs.clear();
+    }
+
+    /** Insert, move and remove collision boxes here. */
+    Broadphase& getBroadphase() { return *broadphase; }
+
+    /** The overlapping pairs found at the end of the last update(). */
+    const std::vector<ProxyPair>& getPairs() const { return pairs; }
+
 public:
     /**
      * Global step size.
@@ -46,8 +70,11 @@ class PhysicsServer {
     int stepSize = 1;
 
 private:
-    std::vector<Solver> solvers;
+    std::vector<ref<Solver>> solvers;
     float delta = 1.0/60.0;
+
+    scope<Broadphase> broadphase = Broadphase::create(BroadphaseType::AABBTree);
+    std::vector<ProxyPair> pairs;
 };
 
 } // namespace FW::Physics
\ No newline at end of file
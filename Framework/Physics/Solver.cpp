@@ -1,9 +1,381 @@
 #include "Solver.h"
+#include "Component.h"
+#include "JobSystem.h"
+#include "assertions.h"
+
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * Semi-implicit Euler along one axis. The arrays are separate, so the
+ * compiler can vectorize the loop.
+ */
+static void integrateAxis(float* position,
+                          float* velocity,
+                          float* force,
+                          const float* inverseMass,
+                          std::size_t count,
+                          float delta) {
+    for (std::size_t i = 0; i < count; i++) {
+        velocity[i] += force[i] * inverseMass[i] * delta;
+        position[i] += velocity[i] * delta;
+        force[i] = 0.0f;
+    }
+}
+
+/** Overlap of the boxes of bodies `a` and `b` along one axis. */
+static float overlapAxis(float positionA,
+                         float sizeA,
+                         float positionB,
+                         float sizeB) {
+    return std::min(positionA + sizeA, positionB + sizeB) -
+           std::max(positionA, positionB);
+}
 
 void FW::Physics::Solver::update(float delta) {
-    glm::vec3 totalAcceleration{0.0f};
+    step(delta, nullptr);
+}
 
+void FW::Physics::Solver::update(float delta, JobSystem& jobs) {
+    step(delta, &jobs);
+}
+
+void FW::Physics::Solver::step(float delta, JobSystem* jobs) {
     for (auto& force : forces) {
-        force->update(delta);
+        force->apply(bodies);
+    }
+
+    integrate(delta);
+    findContacts();
+
+    // Islands share no moving body, so they can be solved in any order
+    const std::vector<Island>& found = islands.getIslands();
+    if (jobs) {
+        jobs->parallelFor(
+          0, found.size(), 0, [&](std::size_t begin, std::size_t end) {
+              for (std::size_t i = begin; i < end; i++) {
+                  solveIsland(found[i]);
+              }
+          });
+    } else {
+        for (const Island& island : found) {
+            solveIsland(island);
+        }
+    }
+
+    syncTransforms();
+}
+
+FW::Physics::BodyId FW::Physics::Solver::addBody(
+  TransformationComponent* transform,
+  float mass) {
+    glm::vec3 position{ 0.0f };
+    if (transform) {
+        position = transform->getPosition();
+    }
+
+    BodyId body;
+    if (!freeHandles.empty()) {
+        body = freeHandles.back();
+        freeHandles.pop_back();
+    } else {
+        body = static_cast<BodyId>(indices.size());
+        indices.push_back(0);
+    }
+
+    indices[body] = static_cast<uint32_t>(bodies.add(position, mass));
+    transforms.push_back(transform);
+    handles.push_back(body);
+    sizes.emplace_back(0.0f);
+    proxies.push_back(noProxy);
+    return body;
+}
+
+void FW::Physics::Solver::removeBody(BodyId body) {
+    std::size_t index = getIndex(body);
+    if (proxies[index] != noProxy) {
+        broadphase->remove(proxies[index]);
     }
-}
\ No newline at end of file
+
+    // The last body moves into the gap
+    bodies.swapRemove(index);
+    transforms[index] = transforms.back();
+    transforms.pop_back();
+    handles[index] = handles.back();
+    handles.pop_back();
+    sizes[index] = sizes.back();
+    sizes.pop_back();
+    proxies[index] = proxies.back();
+    proxies.pop_back();
+    if (index < handles.size()) {
+        indices[handles[index]] = static_cast<uint32_t>(index);
+    }
+
+    indices[body] = UINT32_MAX;
+    freeHandles.push_back(body);
+}
+
+void FW::Physics::Solver::applyForce(BodyId body, const glm::vec3& force) {
+    std::size_t index = getIndex(body);
+    bodies.forceX[index] += force.x;
+    bodies.forceY[index] += force.y;
+    bodies.forceZ[index] += force.z;
+}
+
+glm::vec3 FW::Physics::Solver::getPosition(BodyId body) const {
+    return bodies.getPosition(getIndex(body));
+}
+
+void FW::Physics::Solver::setPosition(BodyId body, const glm::vec3& position) {
+    std::size_t index = getIndex(body);
+    bodies.setPosition(index, position);
+    if (transforms[index]) {
+        transforms[index]->setPosition(position);
+    }
+}
+
+glm::vec3 FW::Physics::Solver::getVelocity(BodyId body) const {
+    return bodies.getVelocity(getIndex(body));
+}
+
+void FW::Physics::Solver::setVelocity(BodyId body, const glm::vec3& velocity) {
+    bodies.setVelocity(getIndex(body), velocity);
+}
+
+float FW::Physics::Solver::getMass(BodyId body) const {
+    return bodies.mass[getIndex(body)];
+}
+
+void FW::Physics::Solver::setMass(BodyId body, float mass) {
+    bodies.setMass(getIndex(body), mass);
+}
+
+void FW::Physics::Solver::setBodySize(BodyId body, const glm::vec3& size) {
+    std::size_t index = getIndex(body);
+    bool empty = size.x == 0.0f && size.y == 0.0f && size.z == 0.0f;
+    ASSERT(empty || (size.x > 0.0f && size.y > 0.0f && size.z > 0.0f),
+           "Body size must be greater than 0 along every axis.");
+
+    sizes[index] = size;
+    if (empty) {
+        if (proxies[index] != noProxy) {
+            broadphase->remove(proxies[index]);
+            proxies[index] = noProxy;
+        }
+        return;
+    }
+
+    BoundingBox_Quad box;
+    box.setScale(size);
+    box.setPosition(bodies.getPosition(index));
+    if (proxies[index] == noProxy) {
+        // The handle survives the swaps of removeBody(), unlike the index
+        void* userData = reinterpret_cast<void*>(static_cast<uintptr_t>(body));
+        proxies[index] = broadphase->insert(box, userData);
+    } else {
+        broadphase->move(proxies[index], box);
+    }
+}
+
+glm::vec3 FW::Physics::Solver::getBodySize(BodyId body) const {
+    return sizes[getIndex(body)];
+}
+
+void FW::Physics::Solver::integrate(float delta) {
+    std::size_t count = bodies.size();
+    const float* inverseMass = bodies.inverseMass.data();
+
+    integrateAxis(bodies.positionX.data(),
+                  bodies.velocityX.data(),
+                  bodies.forceX.data(),
+                  inverseMass,
+                  count,
+                  delta);
+    integrateAxis(bodies.positionY.data(),
+                  bodies.velocityY.data(),
+                  bodies.forceY.data(),
+                  inverseMass,
+                  count,
+                  delta);
+    integrateAxis(bodies.positionZ.data(),
+                  bodies.velocityZ.data(),
+                  bodies.forceZ.data(),
+                  inverseMass,
+                  count,
+                  delta);
+}
+
+void FW::Physics::Solver::findContacts() {
+    bodyContacts.clear();
+    bodyPairs.clear();
+    contacts.clear();
+    if (broadphase->getProxyCount() == 0) {
+        islands.build(0, bodyPairs, nullptr);
+        return;
+    }
+
+    BoundingBox_Quad box;
+    for (std::size_t i = 0; i < bodies.size(); i++) {
+        if (proxies[i] != noProxy) {
+            box.setScale(sizes[i]);
+            box.setPosition(bodies.getPosition(i));
+            broadphase->move(proxies[i], box);
+        }
+    }
+    broadphase->findPairs(proxyPairs);
+
+    const float* inverseMass = bodies.inverseMass.data();
+    for (const ProxyPair& pair : proxyPairs) {
+        auto toIndex = [&](ProxyId proxy) {
+            auto handle = reinterpret_cast<uintptr_t>(
+              broadphase->getUserData(proxy));
+            return indices[static_cast<BodyId>(handle)];
+        };
+        uint32_t a = toIndex(pair.a);
+        uint32_t b = toIndex(pair.b);
+        if (inverseMass[a] == 0.0f && inverseMass[b] == 0.0f) {
+            continue;
+        }
+        if (b < a) {
+            std::swap(a, b);
+        }
+
+        // The broadphase is conservative, so test the real boxes. They are
+        // separated along the axis of least overlap.
+        glm::vec3 positionA = bodies.getPosition(a);
+        glm::vec3 positionB = bodies.getPosition(b);
+        Contact contact{ a, b, glm::vec3{ 0.0f }, 0.0f };
+        int axis = -1;
+        for (int i = 0; i < 3; i++) {
+            float overlap = overlapAxis(
+              positionA[i], sizes[a][i], positionB[i], sizes[b][i]);
+            if (overlap < 0.0f) {
+                axis = -1;
+                break;
+            }
+            if (axis == -1 || overlap < contact.penetration) {
+                axis = i;
+                contact.penetration = overlap;
+            }
+        }
+        if (axis == -1) {
+            continue;
+        }
+
+        float centerA = positionA[axis] + sizes[a][axis] / 2.0f;
+        float centerB = positionB[axis] + sizes[b][axis] / 2.0f;
+        contact.normal[axis] = centerA <= centerB ? 1.0f : -1.0f;
+        bodyContacts.push_back(contact);
+    }
+
+    // The broadphase reports pairs in the order of its internal layout.
+    // Sorting makes the islands depend on the bodies alone.
+    std::sort(bodyContacts.begin(),
+              bodyContacts.end(),
+              [](const Contact& x, const Contact& y) {
+                  return x.a != y.a ? x.a < y.a : x.b < y.b;
+              });
+    for (const Contact& contact : bodyContacts) {
+        bodyPairs.push_back({ contact.a, contact.b });
+    }
+    islands.build(bodies.size(), bodyPairs, inverseMass);
+
+    for (uint32_t i : islands.getContacts()) {
+        Contact contact = bodyContacts[i];
+        contact.a = handles[contact.a];
+        contact.b = handles[contact.b];
+        contacts.push_back(contact);
+    }
+}
+
+void FW::Physics::Solver::solveIsland(const Island& island) {
+    // Only the moving bodies of this island are written. Static bodies may
+    // be shared with islands solved on other threads, and are only read.
+    const float* inverseMass = bodies.inverseMass.data();
+    const uint32_t* first = islands.getContacts().data() + island.firstContact;
+    const uint32_t* last = first + island.contactCount;
+
+    // Stop the bodies from moving into each other, without bouncing
+    for (int iteration = 0; iteration < contactIterations; iteration++) {
+        for (const uint32_t* i = first; i != last; i++) {
+            const Contact& contact = bodyContacts[*i];
+            float weightA = inverseMass[contact.a];
+            float weightB = inverseMass[contact.b];
+            glm::vec3 velocityA = bodies.getVelocity(contact.a);
+            glm::vec3 velocityB = bodies.getVelocity(contact.b);
+
+            float approach = glm::dot(velocityB - velocityA, contact.normal);
+            if (approach >= 0.0f) {
+                continue;
+            }
+
+            float impulse = -approach / (weightA + weightB);
+            if (weightA > 0.0f) {
+                bodies.setVelocity(
+                  contact.a, velocityA - contact.normal * impulse * weightA);
+            }
+            if (weightB > 0.0f) {
+                bodies.setVelocity(
+                  contact.b, velocityB + contact.normal * impulse * weightB);
+            }
+        }
+    }
+
+    // Push the bodies apart, in proportion to their inverse masses. The
+    // overlap is measured again, as earlier contacts may have moved them.
+    for (int iteration = 0; iteration < contactIterations; iteration++) {
+        for (const uint32_t* i = first; i != last; i++) {
+            const Contact& contact = bodyContacts[*i];
+            int axis = contact.normal.x != 0.0f   ? 0
+                       : contact.normal.y != 0.0f ? 1
+                                                  : 2;
+            std::vector<float>& position = axis == 0   ? bodies.positionX
+                                           : axis == 1 ? bodies.positionY
+                                                       : bodies.positionZ;
+            float overlap = overlapAxis(position[contact.a],
+                                        sizes[contact.a][axis],
+                                        position[contact.b],
+                                        sizes[contact.b][axis]);
+            if (overlap <= 0.0f) {
+                continue;
+            }
+
+            float weightA = inverseMass[contact.a];
+            float weightB = inverseMass[contact.b];
+            float correction = overlap / (weightA + weightB);
+            float direction = contact.normal[axis];
+            if (weightA > 0.0f) {
+                position[contact.a] -= direction * correction * weightA;
+            }
+            if (weightB > 0.0f) {
+                position[contact.b] += direction * correction * weightB;
+            }
+        }
+    }
+}
+
+void FW::Physics::Solver::syncTransforms() {
+    for (std::size_t i = 0; i < bodies.size(); i++) {
+        // Only bodies that moved. Resting bodies keep their transforms clean.
+        if (!transforms[i] ||
+            (bodies.velocityX[i] == 0.0f && bodies.velocityY[i] == 0.0f &&
+             bodies.velocityZ[i] == 0.0f)) {
+            continue;
+        }
+
+        transforms[i]->setPosition(bodies.getPosition(i));
+    }
+
+    // Bodies pushed out of a contact may have come to rest
+    for (uint32_t i : islands.getBodies()) {
+        if (transforms[i]) {
+            transforms[i]->setPosition(bodies.getPosition(i));
+        }
+    }
+}
+
+std::size_t FW::Physics::Solver::getIndex(BodyId body) const {
+    ASSERT(body < indices.size() && indices[body] != UINT32_MAX,
+           "Body is not in the solver.");
+    return indices[body];
+}
@@ -5,7 +5,7 @@
  * energy.
  * 
  * This project's solver implementation involves putting together forces to
- * impact bodies. Currently, only gravity is supported.
+ * impact bodies. Bodies are point masses: they move, but do not rotate.
  * 
  * @file Solver.h
  * @author Khai Duong
@@ -19,18 +19,165 @@
 #pragma once
 
 #include "pch.h"
+#include "BodyStates.h"
+#include "Broadphase.h"
 #include "Force.h"
+#include "Islands.h"
+
+#include <cstdint>
+
+namespace FW {
+class JobSystem;
+class TransformationComponent;
+} // namespace FW
 
 namespace FW::Physics {
+
+/** Handle to a body in a Solver. */
+using BodyId = uint32_t;
+
+/** Two colliding bodies. */
+struct Contact {
+    BodyId a;
+    BodyId b;
+    /** Unit vector along one axis, pointing from `a` to `b`. */
+    glm::vec3 normal;
+    /** How deep the boxes overlapped along the normal, before solving. */
+    float penetration;
+};
+
+/**
+ * Moves bodies by the forces acting on them.
+ *
+ * Each update() applies every force to all bodies at once, then integrates
+ * with semi-implicit Euler: the velocity is updated first, and the position
+ * moves by the new velocity. This is as cheap as plain Euler, but stays
+ * stable for orbits and springs.
+ *
+ * A body may be attached to a TransformationComponent, whose position is
+ * then set after every update. The solver owns the position, so a body is
+ * teleported with setPosition() and not through the transform.
+ *
+ * Bodies given a size with setBodySize() collide as axis-aligned boxes. After
+ * integrating, overlapping boxes are pushed apart and stop moving towards each
+ * other. Colliding bodies are grouped into islands, which never share a moving
+ * body, so update() may solve islands on several threads. Each island is
+ * solved the same way whichever thread runs it, so the result does not depend
+ * on the number of threads.
+ *
+ * @code{.cpp}
+ * FW::Physics::Solver solver;
+ * solver.addForce(FW::createRef<FW::Physics::GravityForce>());
+ * FW::Physics::BodyId ball = solver.addBody(transform.get(), 2.0f);
+ *
+ * solver.applyForce(ball, { 100.0f, 0.0f, 0.0f });
+ * solver.update(delta);
+ * @endcode
+ */
 class Solver {
 public:
     Solver() = default;
     virtual ~Solver() = default;
 
     void update(float delta);
+
+    /** Like update(delta), but solve the islands in parallel on `jobs`. */
+    void update(float delta, JobSystem& jobs);
+
     void addForce(ref<Force> force) { forces.push_back(force); }
 
+    /**
+     * Add a body at rest.
+     *
+     * @param transform Receives the position of the body after every update,
+     * and provides its initial position. May be nullptr. It must outlive the
+     * body.
+     * @param mass A mass of 0 makes a static body, which forces do not move.
+     * @return Handle to the body. Handles of removed bodies may be reused.
+     */
+    BodyId addBody(TransformationComponent* transform, float mass = 1.0f);
+    void removeBody(BodyId body);
+
+    /** Push `body` during the next update. */
+    void applyForce(BodyId body, const glm::vec3& force);
+
+    glm::vec3 getPosition(BodyId body) const;
+    /** Teleport the body, and its transform. */
+    void setPosition(BodyId body, const glm::vec3& position);
+
+    glm::vec3 getVelocity(BodyId body) const;
+    void setVelocity(BodyId body, const glm::vec3& velocity);
+
+    float getMass(BodyId body) const;
+    void setMass(BodyId body, float mass);
+
+    /**
+     * Make `body` collide as a box from its position to position + size.
+     *
+     * @param size Every component must be greater than 0. A size of 0 stops
+     * the body from colliding.
+     */
+    void setBodySize(BodyId body, const glm::vec3& size);
+    glm::vec3 getBodySize(BodyId body) const;
+
+    std::size_t getBodyCount() const { return bodies.size(); }
+
+    /** The state of every body, in no particular order. */
+    const BodyStates& getBodies() const { return bodies; }
+
+    /** Contacts found in the last update, grouped by island. */
+    const std::vector<Contact>& getContacts() const { return contacts; }
+
+    /** Number of islands solved in the last update. */
+    std::size_t getIslandCount() const {
+        return islands.getIslands().size();
+    }
+
+public:
+    /**
+     * Passes over the contacts of an island per update. More passes settle
+     * stacks faster, but cost more.
+     */
+    int contactIterations = 4;
+
 protected:
     std::vector<ref<Force>> forces;
+
+private:
+    void step(float delta, JobSystem* jobs);
+    void integrate(float delta);
+
+    /** Find the overlapping boxes and group them into islands. */
+    void findContacts();
+    void solveIsland(const Island& island);
+    void syncTransforms();
+
+    std::size_t getIndex(BodyId body) const;
+
+private:
+    static constexpr ProxyId noProxy = UINT32_MAX;
+
+    BodyStates bodies;
+
+    /** Transform of each body, in the same order as `bodies`. */
+    std::vector<TransformationComponent*> transforms;
+    /** Handle of each body, in the same order as `bodies`. */
+    std::vector<BodyId> handles;
+    /** Index into `bodies` of each handle. */
+    std::vector<uint32_t> indices;
+    std::vector<BodyId> freeHandles;
+
+    /** Box size and proxy of each body, in the same order as `bodies`. */
+    std::vector<glm::vec3> sizes;
+    std::vector<ProxyId> proxies;
+    /** Holds the boxes of the bodies that collide. */
+    scope<Broadphase> broadphase = Broadphase::create(BroadphaseType::AABBTree);
+
+    std::vector<ProxyPair> proxyPairs;
+    /** Contacts between indices into `bodies`, sorted by body. */
+    std::vector<Contact> bodyContacts;
+    std::vector<BodyPair> bodyPairs;
+    IslandBuilder islands;
+    std::vector<Contact> contacts;
 };
-} // namespace FW::Physics
\ No newline at end of file
+} // namespace FW::Physics
@@ -0,0 +1,272 @@
+#include "SpatialHash.h"
+#include "assertions.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace FW::Physics {
+
+SpatialHash::SpatialHash(float cellSize)
+  : cellSize(cellSize)
+  , inverseCellSize(1.0f / cellSize) {
+    ASSERT(cellSize > 0.0f, "Cell size must be greater than 0.");
+}
+
+ProxyId SpatialHash::insert(const BoundingBox_Quad& box, void* userData) {
+    ProxyId proxy;
+    if (!freeProxies.empty()) {
+        proxy = freeProxies.back();
+        freeProxies.pop_back();
+    } else {
+        proxy = static_cast<ProxyId>(proxies.size());
+        proxies.emplace_back();
+    }
+
+    Proxy& entry = proxies[proxy];
+    entry.box = box;
+    entry.cells = getCellRange(box);
+    entry.userData = userData;
+    entry.active = true;
+    proxyCount++;
+
+    addToCells(proxy, entry.cells);
+    return proxy;
+}
+
+void SpatialHash::move(ProxyId proxy, const BoundingBox_Quad& box) {
+    Proxy& entry = proxies[proxy];
+    ASSERT(entry.active, "Moving a proxy that is not in the spatial hash.");
+
+    entry.box = box;
+
+    // Most moves stay within the same cells
+    CellRange range = getCellRange(box);
+    if (range == entry.cells) {
+        return;
+    }
+
+    removeFromCells(proxy, entry.cells);
+    entry.cells = range;
+    addToCells(proxy, entry.cells);
+}
+
+void SpatialHash::remove(ProxyId proxy) {
+    Proxy& entry = proxies[proxy];
+    ASSERT(entry.active, "Removing a proxy that is not in the spatial hash.");
+
+    removeFromCells(proxy, entry.cells);
+    entry.active = false;
+    entry.userData = nullptr;
+    freeProxies.push_back(proxy);
+    proxyCount--;
+}
+
+void SpatialHash::clear() {
+    cells.clear();
+    proxies.clear();
+    freeProxies.clear();
+    proxyCount = 0;
+}
+
+void SpatialHash::findPairs(std::vector<ProxyPair>& pairs) const {
+    pairs.clear();
+
+    for (const auto& [key, members] : cells) {
+        if (members.size() < 2) {
+            continue;
+        }
+
+        auto cellX = static_cast<int32_t>(static_cast<uint32_t>(key >> 32));
+        auto cellY = static_cast<int32_t>(static_cast<uint32_t>(key));
+
+        auto report = [&](std::size_t i, std::size_t j) {
+            const Proxy& first = proxies[members[i]];
+            const Proxy& second = proxies[members[j]];
+
+            // Report the pair only from the first cell both boxes cover
+            if (std::max(first.cells.minX, second.cells.minX) == cellX &&
+                std::max(first.cells.minY, second.cells.minY) == cellY) {
+                pairs.push_back({ std::min(members[i], members[j]),
+                                  std::max(members[i], members[j]) });
+            }
+        };
+
+        // Crowded cells are worth copying into a BoxArray, to test 8 boxes
+        // at a time
+        if (members.size() > BoxArray::batchSize) {
+            cellBoxes.clear();
+            for (ProxyId proxy : members) {
+                cellBoxes.add(proxies[proxy].box);
+            }
+
+            for (std::size_t i = 0; i < members.size(); i++) {
+                const BoundingBox_Quad& box = proxies[members[i]].box;
+                for (std::size_t first = i + 1; first < members.size();
+                     first += BoxArray::batchSize) {
+                    for (uint32_t mask = cellBoxes.overlapBatch(box, first);
+                         mask != 0;
+                         mask &= mask - 1) {
+                        report(i, first + std::countr_zero(mask));
+                    }
+                }
+            }
+            continue;
+        }
+
+        for (std::size_t i = 0; i < members.size(); i++) {
+            for (std::size_t j = i + 1; j < members.size(); j++) {
+                if (isOverlapping(proxies[members[i]].box,
+                                  proxies[members[j]].box)) {
+                    report(i, j);
+                }
+            }
+        }
+    }
+}
+
+void SpatialHash::query(const BoundingBox_Quad& box,
+                        std::vector<ProxyId>& result) const {
+    nextQueryMark();
+
+    CellRange range = getCellRange(box);
+    for (int32_t x = range.minX; x <= range.maxX; x++) {
+        for (int32_t y = range.minY; y <= range.maxY; y++) {
+            auto cell = cells.find(getCellKey(x, y));
+            if (cell == cells.end()) {
+                continue;
+            }
+
+            for (ProxyId proxy : cell->second) {
+                if (queryMarks[proxy] == queryMark) {
+                    continue;
+                }
+                queryMarks[proxy] = queryMark;
+
+                if (isOverlapping(box, proxies[proxy].box)) {
+                    result.push_back(proxy);
+                }
+            }
+        }
+    }
+}
+
+void SpatialHash::raycast(const glm::vec3& from,
+                          const glm::vec3& to,
+                          std::vector<RayHit>& hits) const {
+    hits.clear();
+    nextQueryMark();
+
+    glm::vec3 direction = to - from;
+    glm::vec3 inverseDirection = 1.0f / direction;
+
+    // Amanatides and Woo: step into whichever neighbouring cell the segment
+    // reaches first, until the segment ends.
+    int32_t x = static_cast<int32_t>(std::floor(from.x * inverseCellSize));
+    int32_t y = static_cast<int32_t>(std::floor(from.y * inverseCellSize));
+    int32_t stepX = direction.x > 0.0f ? 1 : -1;
+    int32_t stepY = direction.y > 0.0f ? 1 : -1;
+
+    // Fraction of the segment at the next cell border, and between borders
+    auto firstBorder = [&](int32_t cell, int32_t step, float start, float inv) {
+        if (std::isinf(inv)) {
+            return std::numeric_limits<float>::infinity();
+        }
+        float border = (cell + (step > 0 ? 1 : 0)) * cellSize;
+        return (border - start) * inv;
+    };
+    float nextX = firstBorder(x, stepX, from.x, inverseDirection.x);
+    float nextY = firstBorder(y, stepY, from.y, inverseDirection.y);
+    float deltaX = std::abs(cellSize * inverseDirection.x);
+    float deltaY = std::abs(cellSize * inverseDirection.y);
+
+    while (true) {
+        auto cell = cells.find(getCellKey(x, y));
+        if (cell != cells.end()) {
+            for (ProxyId proxy : cell->second) {
+                if (queryMarks[proxy] == queryMark) {
+                    continue;
+                }
+                queryMarks[proxy] = queryMark;
+
+                const BoundingBox_Quad& box = proxies[proxy].box;
+                float fraction =
+                  intersectSegment(from,
+                                   inverseDirection,
+                                   { box.minX, box.minY, box.minZ },
+                                   { box.maxX, box.maxY, box.maxZ });
+                if (fraction >= 0.0f) {
+                    hits.push_back({ proxy, fraction });
+                }
+            }
+        }
+
+        // The segment ends before reaching the next cell
+        if (std::min(nextX, nextY) > 1.0f) {
+            break;
+        }
+        if (nextX < nextY) {
+            x += stepX;
+            nextX += deltaX;
+        } else {
+            y += stepY;
+            nextY += deltaY;
+        }
+    }
+
+    std::sort(hits.begin(), hits.end(), [](const RayHit& a, const RayHit& b) {
+        return a.fraction < b.fraction;
+    });
+}
+
+void SpatialHash::nextQueryMark() const {
+    queryMarks.resize(proxies.size(), 0);
+    if (++queryMark == 0) {
+        // Wrapped around. Old marks could collide with the new one.
+        std::fill(queryMarks.begin(), queryMarks.end(), 0);
+        queryMark = 1;
+    }
+}
+
+SpatialHash::CellRange SpatialHash::getCellRange(
+  const BoundingBox_Quad& box) const {
+    return { static_cast<int32_t>(std::floor(box.minX * inverseCellSize)),
+             static_cast<int32_t>(std::floor(box.minY * inverseCellSize)),
+             static_cast<int32_t>(std::floor(box.maxX * inverseCellSize)),
+             static_cast<int32_t>(std::floor(box.maxY * inverseCellSize)) };
+}
+
+void SpatialHash::addToCells(ProxyId proxy, const CellRange& range) {
+    for (int32_t x = range.minX; x <= range.maxX; x++) {
+        for (int32_t y = range.minY; y <= range.maxY; y++) {
+            cells[getCellKey(x, y)].push_back(proxy);
+        }
+    }
+}
+
+void SpatialHash::removeFromCells(ProxyId proxy, const CellRange& range) {
+    for (int32_t x = range.minX; x <= range.maxX; x++) {
+        for (int32_t y = range.minY; y <= range.maxY; y++) {
+            auto cell = cells.find(getCellKey(x, y));
+            if (cell == cells.end()) {
+                continue;
+            }
+
+            // Order within a cell does not matter
+            std::vector<ProxyId>& members = cell->second;
+            auto it = std::find(members.begin(), members.end(), proxy);
+            if (it != members.end()) {
+                *it = members.back();
+                members.pop_back();
+            }
+
+            // Boxes flying off keep leaving cells behind
+            if (members.empty()) {
+                cells.erase(cell);
+            }
+        }
+    }
+}
+
+} // namespace FW::Physics
@@ -0,0 +1,132 @@
+/**
+ * Broadphase collision detection on a uniform grid.
+ *
+ * Finding every overlapping pair by testing each box against every other box
+ * costs O(n²). The spatial hash bins boxes by the grid cells they cover, so
+ * only boxes sharing a cell are tested against each other.
+ *
+ * @file SpatialHash.h
+ */
+
+#pragma once
+
+#include "pch.h"
+#include "Broadphase.h"
+#include "BoxArray.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace FW::Physics {
+
+/**
+ * Uniform grid over the XY plane, stored sparsely in a hash map.
+ *
+ * Boxes are binned by their X and Y extents. Candidates that share a cell are
+ * tested with FW::isOverlapping(), so Z is still taken into account.
+ *
+ * The cell size should be about the size of a typical box. Much smaller
+ * cells make large boxes occupy many cells. Much larger cells put many boxes
+ * in each cell, which approaches the brute force cost.
+ *
+ * @example
+ * @code
+ * Physics::SpatialHash broadphase(32.0f);
+ * Physics::ProxyId player = broadphase.insert(playerBox, &playerSprite);
+ *
+ * // Every frame
+ * broadphase.move(player, playerBox);
+ * broadphase.findPairs(pairs);
+ * for (auto [a, b] : pairs) {
+ *     resolve(broadphase.getUserData(a), broadphase.getUserData(b));
+ * }
+ * @endcode
+ */
+class SpatialHash : public Broadphase {
+public:
+    explicit SpatialHash(float cellSize = 64.0f);
+    virtual ~SpatialHash() = default;
+
+    ProxyId insert(const BoundingBox_Quad& box,
+                   void* userData = nullptr) override;
+    void move(ProxyId proxy, const BoundingBox_Quad& box) override;
+    void remove(ProxyId proxy) override;
+    void clear() override;
+
+    /**
+     * Find every pair of overlapping boxes.
+     *
+     * @details Pairs of boxes that share several cells are only reported
+     * once, by the first cell they share. No set is needed to remove
+     * duplicates.
+     */
+    void findPairs(std::vector<ProxyPair>& pairs) const override;
+
+    void query(const BoundingBox_Quad& box,
+               std::vector<ProxyId>& result) const override;
+
+    /** Walks the cells along the segment, in the XY plane. */
+    void raycast(const glm::vec3& from,
+                 const glm::vec3& to,
+                 std::vector<RayHit>& hits) const override;
+
+    const BoundingBox_Quad& getBox(ProxyId proxy) const override {
+        return proxies[proxy].box;
+    }
+    void* getUserData(ProxyId proxy) const override {
+        return proxies[proxy].userData;
+    }
+
+    uint32_t getProxyCount() const override { return proxyCount; }
+
+    float getCellSize() const { return cellSize; }
+
+private:
+    /** Inclusive range of cells covered by a box. */
+    struct CellRange {
+        int32_t minX, minY;
+        int32_t maxX, maxY;
+
+        bool operator==(const CellRange&) const = default;
+    };
+
+    struct Proxy {
+        BoundingBox_Quad box;
+        CellRange cells;
+        void* userData = nullptr;
+        bool active = false;
+    };
+
+    CellRange getCellRange(const BoundingBox_Quad& box) const;
+
+    /** Start a new visit, so each proxy is only tested once. */
+    void nextQueryMark() const;
+    void addToCells(ProxyId proxy, const CellRange& range);
+    void removeFromCells(ProxyId proxy, const CellRange& range);
+
+    static uint64_t getCellKey(int32_t x, int32_t y) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) |
+               static_cast<uint32_t>(y);
+    }
+
+private:
+    float cellSize;
+    float inverseCellSize;
+
+    std::vector<Proxy> proxies;
+    std::vector<ProxyId> freeProxies;
+    uint32_t proxyCount = 0;
+
+    /** Proxies in each non-empty cell, keyed by getCellKey(). */
+    std::unordered_map<uint64_t, std::vector<ProxyId>> cells;
+
+    /** Marks proxies already visited by the current query or raycast. */
+    mutable std::vector<uint32_t> queryMarks;
+    mutable uint32_t queryMark = 0;
+
+    /** Boxes of a crowded cell, reused by findPairs(). */
+    mutable BoxArray cellBoxes;
+};
+
+} // namespace FW::Physics
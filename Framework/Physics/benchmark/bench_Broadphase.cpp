@@ -0,0 +1,193 @@
+/**
+ * Compare broadphase collision detection with the brute force
+ * FW::isOverlapping() loop.
+ *
+ * Boxes of 1 to 4 units are scattered over a square world that grows with
+ * the box count, so each box has a similar number of neighbours at every
+ * size, like bullets spread over a level. Every method must report the same
+ * number of overlapping pairs.
+ *
+ * The brute force run at 100k boxes performs 10^10 box tests, and takes about
+ * a minute. The mixed size scenario stops at 10k boxes. Above 10k boxes, only
+ * the fastest BoxArray kernel is run.
+ */
+
+#include "AABBTree.h"
+#include "BoxArray.h"
+#include "Physics.h"
+#include "SpatialHash.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static std::vector<FW::BoundingBox_Quad> makeBoxes(std::size_t count,
+                                                   unsigned seed) {
+    std::mt19937 rng(seed);
+    float worldSize = std::sqrt(static_cast<float>(count)) * 10.0f;
+    std::uniform_real_distribution<float> position(0.0f, worldSize);
+    std::uniform_real_distribution<float> size(1.0f, 4.0f);
+
+    std::vector<FW::BoundingBox_Quad> boxes(count);
+    for (auto& box : boxes) {
+        box.setScale(size(rng), size(rng), 1.0f);
+        box.setPosition({ position(rng), position(rng), 0.0f });
+    }
+    return boxes;
+}
+
+/**
+ * Bullets, ships and a few large pieces of level, which a uniform grid
+ * handles poorly: the cells are either too small for the level pieces or too
+ * large for the bullets.
+ */
+static std::vector<FW::BoundingBox_Quad> makeMixedBoxes(std::size_t count,
+                                                        unsigned seed) {
+    std::mt19937 rng(seed);
+    float worldSize = std::sqrt(static_cast<float>(count)) * 10.0f;
+    std::uniform_real_distribution<float> position(0.0f, worldSize);
+    std::uniform_real_distribution<float> bullet(0.2f, 0.5f);
+    std::uniform_real_distribution<float> ship(4.0f, 8.0f);
+    std::uniform_real_distribution<float> level(50.0f, 200.0f);
+
+    std::vector<FW::BoundingBox_Quad> boxes(count);
+    for (std::size_t i = 0; i < count; i++) {
+        auto& size = i % 100 == 0 ? level : i % 5 == 0 ? ship : bullet;
+        boxes[i].setScale(size(rng), size(rng), 1.0f);
+        boxes[i].setPosition({ position(rng), position(rng), 0.0f });
+    }
+    return boxes;
+}
+
+template<typename Func>
+static double measure(Func&& func) {
+    auto start = Clock::now();
+    func();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+static void printRow(const char* method,
+                     std::size_t boxes,
+                     double ms,
+                     std::size_t pairs) {
+    std::printf("%-28s %8zu %12.3f %10zu\n", method, boxes, ms, pairs);
+}
+
+/** The loop games write today: every box against the list of all boxes. */
+static void benchmarkBruteForce(std::vector<FW::BoundingBox_Quad>& boxes) {
+    std::vector<FW::BoundingBox_Quad*> pointers;
+    for (auto& box : boxes) {
+        pointers.push_back(&box);
+    }
+
+    std::size_t found = 0;
+    double ms = measure([&] {
+        for (auto* box : pointers) {
+            found += FW::isOverlapping(box, pointers).size();
+        }
+    });
+    // Every pair was found from both of its boxes
+    printRow("brute force", boxes.size(), ms, found / 2);
+}
+
+/** The same loop over a BoxArray, 8 boxes per test, with every kernel. */
+static void benchmarkBoxArray(const std::vector<FW::BoundingBox_Quad>& boxes,
+                              bool allKernels) {
+    using FW::Physics::BoxArray;
+    using FW::Physics::OverlapKernel;
+
+    BoxArray array;
+    array.reserve(boxes.size());
+    for (const auto& box : boxes) {
+        array.add(box);
+    }
+
+    struct Kernel {
+        OverlapKernel kernel;
+        const char* name;
+    };
+    OverlapKernel selected = BoxArray::getKernel();
+    for (Kernel kernel : { Kernel{ OverlapKernel::Scalar, "scalar" },
+                           Kernel{ OverlapKernel::SSE, "sse" },
+                           Kernel{ OverlapKernel::AVX2, "avx2" } }) {
+        if ((!allKernels && kernel.kernel != selected) ||
+            !BoxArray::setKernel(kernel.kernel)) {
+            continue;
+        }
+
+        std::vector<FW::Physics::ProxyPair> pairs;
+        double ms = measure([&] { array.findPairs(pairs); });
+        printRow((std::string("box array ") + kernel.name).c_str(),
+                 boxes.size(),
+                 ms,
+                 pairs.size());
+    }
+    BoxArray::setKernel(selected);
+}
+
+static void benchmarkBroadphase(const std::string& name,
+                               FW::Physics::Broadphase& broadphase,
+                               std::vector<FW::BoundingBox_Quad> boxes) {
+    std::vector<FW::Physics::ProxyId> proxies(boxes.size());
+    std::vector<FW::Physics::ProxyPair> pairs;
+
+    double insert = measure([&] {
+        for (std::size_t i = 0; i < boxes.size(); i++) {
+            proxies[i] = broadphase.insert(boxes[i]);
+        }
+    });
+    printRow((name + " insert").c_str(), boxes.size(), insert, 0);
+
+    double findPairs = measure([&] { broadphase.findPairs(pairs); });
+    printRow(
+      (name + " findPairs").c_str(), boxes.size(), findPairs, pairs.size());
+
+    // A frame: a tenth of the boxes move a little, then pairs are found
+    constexpr int frames = 10;
+    double frame = measure([&] {
+        for (int f = 0; f < frames; f++) {
+            for (std::size_t i = f; i < boxes.size(); i += 10) {
+                glm::vec3 position{ boxes[i].minX + 0.5f, boxes[i].minY, 0.0f };
+                boxes[i].setPosition(position);
+                broadphase.move(proxies[i], boxes[i]);
+            }
+            broadphase.findPairs(pairs);
+        }
+    });
+    printRow(
+      (name + " frame").c_str(), boxes.size(), frame / frames, pairs.size());
+}
+
+static void benchmarkAll(std::vector<FW::BoundingBox_Quad>& boxes) {
+    benchmarkBruteForce(boxes);
+    benchmarkBoxArray(boxes, boxes.size() <= 10'000);
+
+    FW::Physics::SpatialHash hash(8.0f);
+    benchmarkBroadphase("spatial hash", hash, boxes);
+
+    FW::Physics::AABBTree tree(1.0f);
+    benchmarkBroadphase("aabb tree", tree, boxes);
+}
+
+int main() {
+    std::printf("%-28s %8s %12s %10s\n", "method", "boxes", "ms", "pairs");
+
+    for (std::size_t count : { 1'000, 10'000, 100'000 }) {
+        std::vector<FW::BoundingBox_Quad> boxes = makeBoxes(count, 42);
+
+        benchmarkAll(boxes);
+        std::printf("\n");
+    }
+
+    std::printf("mixed sizes\n");
+    std::vector<FW::BoundingBox_Quad> boxes = makeMixedBoxes(10'000, 42);
+    benchmarkAll(boxes);
+
+    return 0;
+}
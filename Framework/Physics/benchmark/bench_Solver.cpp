@@ -0,0 +1,170 @@
+/**
+ * Compare the Solver's batched integrator with per-body updates, as each
+ * game wrote them before.
+ *
+ * Every body falls under gravity. The per-body version keeps each body in its
+ * own heap allocation and updates it through a virtual call, like a
+ * component. All versions must end with the same total height.
+ *
+ * The second table drops stacks of colliding boxes on a shared ground, and
+ * solves their islands on one thread and on the JobSystem. The final height
+ * must match, whatever the number of threads.
+ */
+
+#include "JobSystem.h"
+#include "Solver.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int steps = 100;
+constexpr float delta = 1.0f / 60.0f;
+static const glm::vec3 gravity{ 0.0f, -9.8067f, 0.0f };
+
+template<typename Func>
+static double measure(Func&& func) {
+    auto start = Clock::now();
+    func();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+static void printRow(const char* method,
+                     std::size_t bodies,
+                     double ms,
+                     double height) {
+    double nsPerBody = ms * 1e6 / (static_cast<double>(bodies) * steps);
+    std::printf("%-20s %9zu %10.3f %12.2f %14.1f\n",
+                method,
+                bodies,
+                ms,
+                nsPerBody,
+                height);
+}
+
+class Body {
+public:
+    virtual ~Body() = default;
+
+    virtual void update(float delta) {
+        velocity += (force * inverseMass + gravity) * delta;
+        position += velocity * delta;
+        force = glm::vec3{ 0.0f };
+    }
+
+    glm::vec3 position{ 0.0f };
+    glm::vec3 velocity{ 0.0f };
+    glm::vec3 force{ 0.0f };
+    float inverseMass = 1.0f;
+};
+
+static void benchmarkPerBody(std::size_t count) {
+    std::vector<FW::ref<Body>> bodies;
+    for (std::size_t i = 0; i < count; i++) {
+        bodies.push_back(FW::createRef<Body>());
+    }
+
+    double ms = measure([&] {
+        for (int step = 0; step < steps; step++) {
+            for (auto& body : bodies) {
+                body->update(delta);
+            }
+        }
+    });
+
+    double height = 0.0;
+    for (auto& body : bodies) {
+        height += body->position.y;
+    }
+    printRow("per body", count, ms, height);
+}
+
+static void benchmarkSolver(std::size_t count) {
+    FW::Physics::Solver solver;
+    solver.addForce(FW::createRef<FW::Physics::GravityForce>(gravity));
+    for (std::size_t i = 0; i < count; i++) {
+        solver.addBody(nullptr);
+    }
+
+    double ms = measure([&] {
+        for (int step = 0; step < steps; step++) {
+            solver.update(delta);
+        }
+    });
+
+    double height = 0.0;
+    for (float y : solver.getBodies().positionY) {
+        height += y;
+    }
+    printRow("solver", count, ms, height);
+}
+
+static void benchmarkIslands(std::size_t stacks, FW::JobSystem* jobs) {
+    FW::Physics::Solver solver;
+    solver.addForce(FW::createRef<FW::Physics::GravityForce>(gravity));
+    FW::Physics::BodyId ground = solver.addBody(nullptr, 0.0f);
+    solver.setPosition(ground, { -1.0f, -1.0f, 0.0f });
+    solver.setBodySize(ground, { stacks * 4.0f + 2.0f, 1.0f, 1.0f });
+
+    constexpr int stackHeight = 8;
+    for (std::size_t stack = 0; stack < stacks; stack++) {
+        for (int i = 0; i < stackHeight; i++) {
+            FW::Physics::BodyId body = solver.addBody(nullptr);
+            float x = stack * 4.0f + (i % 2) * 0.3f;
+            solver.setPosition(body, { x, i * 1.1f, 0.0f });
+            solver.setBodySize(body, glm::vec3{ 1.0f });
+        }
+    }
+
+    double ms = measure([&] {
+        for (int step = 0; step < steps; step++) {
+            if (jobs) {
+                solver.update(delta, *jobs);
+            } else {
+                solver.update(delta);
+            }
+        }
+    });
+
+    double height = 0.0;
+    for (float y : solver.getBodies().positionY) {
+        height += y;
+    }
+
+    char method[32] = "islands, serial";
+    if (jobs) {
+        std::snprintf(method,
+                      sizeof(method),
+                      "islands, %u threads",
+                      jobs->getThreadCount());
+    }
+    printRow(method, solver.getBodyCount(), ms, height);
+}
+
+int main() {
+    std::printf("%d steps per run\n", steps);
+    std::printf("%-20s %9s %10s %12s %14s\n",
+                "method",
+                "bodies",
+                "ms",
+                "ns/body/step",
+                "total height");
+
+    for (std::size_t count : { 1'000, 100'000, 1'000'000 }) {
+        benchmarkPerBody(count);
+        benchmarkSolver(count);
+        std::printf("\n");
+    }
+
+    FW::JobSystem& jobs = FW::JobSystem::get();
+    for (std::size_t stacks : { 100, 1'000, 10'000 }) {
+        benchmarkIslands(stacks, nullptr);
+        benchmarkIslands(stacks, &jobs);
+        std::printf("\n");
+    }
+
+    return 0;
+}
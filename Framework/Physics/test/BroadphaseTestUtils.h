@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Broadphase.h"
+
+#include <algorithm>
+#include <vector>
+
+/** A box with its bottom left corner at (x, y). */
+inline FW::BoundingBox_Quad makeBox(float x,
+                                    float y,
+                                    float width,
+                                    float height) {
+    FW::BoundingBox_Quad box;
+    box.setScale(width, height, 1.0f);
+    box.setPosition({ x, y, 0.0f });
+    return box;
+}
+
+/** Every overlapping pair of `proxies`, found by testing all of them. */
+inline std::vector<FW::Physics::ProxyPair> bruteForcePairs(
+  const FW::Physics::Broadphase& broadphase,
+  const std::vector<FW::Physics::ProxyId>& proxies) {
+    std::vector<FW::Physics::ProxyPair> pairs;
+    for (std::size_t i = 0; i < proxies.size(); i++) {
+        for (std::size_t j = i + 1; j < proxies.size(); j++) {
+            if (FW::isOverlapping(broadphase.getBox(proxies[i]),
+                                  broadphase.getBox(proxies[j]))) {
+                pairs.push_back({ std::min(proxies[i], proxies[j]),
+                                  std::max(proxies[i], proxies[j]) });
+            }
+        }
+    }
+    return pairs;
+}
+
+/** Order pairs so the results of two broadphases can be compared. */
+inline void sortPairs(std::vector<FW::Physics::ProxyPair>& pairs) {
+    std::sort(pairs.begin(),
+              pairs.end(),
+              [](FW::Physics::ProxyPair x, FW::Physics::ProxyPair y) {
+                  return x.a != y.a ? x.a < y.a : x.b < y.b;
+              });
+}
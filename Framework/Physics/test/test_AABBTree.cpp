@@ -0,0 +1,188 @@
+#include "doctest/doctest.h"
+
+#include "AABBTree.h"
+#include "BroadphaseTestUtils.h"
+#include "SpatialHash.h"
+
+#include <algorithm>
+#include <random>
+
+using FW::Physics::ProxyId;
+using FW::Physics::ProxyPair;
+
+/** Mostly small boxes, and a few that are much larger than the rest. */
+static std::vector<FW::BoundingBox_Quad> makeBoxes(std::size_t count,
+                                                   unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-200.0f, 200.0f);
+    std::uniform_real_distribution<float> size(1.0f, 10.0f);
+
+    std::vector<FW::BoundingBox_Quad> boxes;
+    for (std::size_t i = 0; i < count; i++) {
+        float scale = i % 50 == 0 ? 20.0f : 1.0f;
+        boxes.push_back(makeBox(position(rng),
+                                position(rng),
+                                size(rng) * scale,
+                                size(rng)));
+    }
+    return boxes;
+}
+
+TEST_CASE("AABBTree keeps pairs correct as boxes move and are removed") {
+    FW::Physics::AABBTree tree(1.0f);
+    std::vector<ProxyId> proxies;
+    for (const auto& box : makeBoxes(400, 1)) {
+        proxies.push_back(tree.insert(box));
+    }
+
+    std::vector<ProxyPair> pairs;
+    tree.findPairs(pairs);
+    sortPairs(pairs);
+    std::vector<ProxyPair> expected = bruteForcePairs(tree, proxies);
+    sortPairs(expected);
+    REQUIRE(!expected.empty());
+    CHECK(pairs == expected);
+
+    // Nudge every box, staying inside or just leaving its fat box, then
+    // move some far away, remove a third and add more
+    std::vector<FW::BoundingBox_Quad> far = makeBoxes(400, 2);
+    for (std::size_t i = 0; i < proxies.size(); i++) {
+        FW::BoundingBox_Quad box = tree.getBox(proxies[i]);
+        if (i % 4 == 0) {
+            box = far[i];
+        } else {
+            box.setPosition({ box.minX + 0.4f * (i % 4), box.minY, 0.0f });
+        }
+        tree.move(proxies[i], box);
+    }
+    std::vector<ProxyId> kept;
+    for (std::size_t i = 0; i < proxies.size(); i++) {
+        if (i % 3 == 0) {
+            tree.remove(proxies[i]);
+        } else {
+            kept.push_back(proxies[i]);
+        }
+    }
+    for (const auto& box : makeBoxes(50, 3)) {
+        kept.push_back(tree.insert(box));
+    }
+
+    CHECK(tree.getProxyCount() == kept.size());
+    CHECK(tree.getReinsertCount() > 0);
+    CHECK(tree.getReinsertCount() < proxies.size());
+
+    tree.findPairs(pairs);
+    sortPairs(pairs);
+    expected = bruteForcePairs(tree, kept);
+    sortPairs(expected);
+    CHECK(std::adjacent_find(pairs.begin(), pairs.end()) == pairs.end());
+    CHECK(pairs == expected);
+}
+
+TEST_CASE("AABBTree leaf tests give the same pairs with every kernel") {
+    using FW::Physics::BoxArray;
+    using FW::Physics::OverlapKernel;
+
+    // A grid of small boxes, partly under a few large ones. Each large box
+    // has far more than a batch of candidates, and a few small ones touch.
+    FW::Physics::AABBTree tree(0.5f);
+    std::vector<ProxyId> proxies;
+    for (int x = 0; x < 20; x++) {
+        for (int y = 0; y < 20; y++) {
+            proxies.push_back(tree.insert(
+              makeBox(x * 3.0f, y * 3.0f, x % 4 == 0 ? 4.0f : 1.0f, 1.0f)));
+        }
+    }
+    FW::BoundingBox_Quad large = makeBox(10.0f, 10.0f, 25.0f, 25.0f);
+    for (int i = 0; i < 3; i++) {
+        proxies.push_back(
+          tree.insert(makeBox(i * 15.0f, i * 10.0f, 25.0f, 25.0f)));
+    }
+
+    std::vector<ProxyPair> expected = bruteForcePairs(tree, proxies);
+    sortPairs(expected);
+    std::vector<ProxyId> expectedQuery;
+    for (ProxyId proxy : proxies) {
+        if (FW::isOverlapping(large, tree.getBox(proxy))) {
+            expectedQuery.push_back(proxy);
+        }
+    }
+    std::sort(expectedQuery.begin(), expectedQuery.end());
+    REQUIRE(expectedQuery.size() > BoxArray::batchSize);
+
+    OverlapKernel selected = BoxArray::getKernel();
+    for (OverlapKernel kernel :
+         { OverlapKernel::Scalar, OverlapKernel::SSE, OverlapKernel::AVX2 }) {
+        if (!BoxArray::setKernel(kernel)) {
+            continue;
+        }
+
+        std::vector<ProxyPair> pairs;
+        tree.findPairs(pairs);
+        sortPairs(pairs);
+        CHECK(pairs == expected);
+
+        std::vector<ProxyId> result;
+        tree.query(large, result);
+        std::sort(result.begin(), result.end());
+        CHECK(result == expectedQuery);
+    }
+    BoxArray::setKernel(selected);
+}
+
+TEST_CASE("AABBTree stays balanced when boxes are inserted in order") {
+    FW::Physics::AABBTree tree;
+
+    // Without rotations, boxes along a line would build a tree as deep as
+    // there are boxes
+    constexpr int count = 1024;
+    for (int i = 0; i < count; i++) {
+        tree.insert(makeBox(i * 10.0f, 0.0f, 1.0f, 1.0f));
+    }
+    CHECK(tree.getHeight() <= 20);
+
+    tree.clear();
+    CHECK(tree.getProxyCount() == 0);
+    CHECK(tree.getHeight() == 0);
+}
+
+TEST_CASE("Broadphase queries agree between the tree and the spatial hash") {
+    FW::Physics::AABBTree tree;
+    FW::Physics::SpatialHash hash(10.0f);
+    FW::Physics::Broadphase* broadphases[] = { &tree, &hash };
+
+    for (FW::Physics::Broadphase* broadphase : broadphases) {
+        ProxyId wide = broadphase->insert(makeBox(-50.0f, 0.0f, 100.0f, 5.0f));
+        ProxyId small = broadphase->insert(makeBox(2.0f, 2.0f, 1.0f, 1.0f));
+        ProxyId distant =
+          broadphase->insert(makeBox(100.0f, 100.0f, 1.0f, 1.0f));
+
+        std::vector<ProxyId> result;
+        broadphase->query(makeBox(-20.0f, 1.0f, 30.0f, 3.0f), result);
+        std::sort(result.begin(), result.end());
+        CHECK(result == std::vector<ProxyId>{ wide, small });
+
+        result.clear();
+        broadphase->queryPoint({ 2.5f, 2.5f, 0.5f }, result);
+        std::sort(result.begin(), result.end());
+        CHECK(result == std::vector<ProxyId>{ wide, small });
+
+        // From the left, through the wide box and into the small one, ending
+        // short of the distant box
+        std::vector<FW::Physics::RayHit> hits;
+        broadphase->raycast(
+          { -100.0f, 2.5f, 0.5f }, { 100.0f, 2.5f, 0.5f }, hits);
+        REQUIRE(hits.size() == 2);
+        CHECK(hits[0].proxy == wide);
+        CHECK(hits[0].fraction == doctest::Approx(0.25f));
+        CHECK(hits[1].proxy == small);
+        CHECK(hits[1].fraction == doctest::Approx(0.51f));
+
+        // Diagonally up to the distant box only
+        broadphase->raycast(
+          { 90.0f, 90.0f, 0.5f }, { 110.0f, 110.0f, 0.5f }, hits);
+        REQUIRE(hits.size() == 1);
+        CHECK(hits[0].proxy == distant);
+        CHECK(hits[0].fraction == doctest::Approx(0.5f));
+    }
+}
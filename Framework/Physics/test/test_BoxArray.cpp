@@ -0,0 +1,134 @@
+#include "doctest/doctest.h"
+
+#include "BoxArray.h"
+#include "SpatialHash.h"
+
+#include <algorithm>
+#include <random>
+
+using FW::Physics::BoxArray;
+using FW::Physics::OverlapKernel;
+using FW::Physics::ProxyPair;
+
+/** Boxes on a coarse grid, so many of them share an edge or a corner. */
+static std::vector<FW::BoundingBox_Quad> makeBoxes(std::size_t count,
+                                                   unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> position(-40, 40);
+    std::uniform_int_distribution<int> size(1, 8);
+
+    std::vector<FW::BoundingBox_Quad> boxes(count);
+    for (auto& box : boxes) {
+        box.setScale(static_cast<float>(size(rng)),
+                     static_cast<float>(size(rng)),
+                     static_cast<float>(size(rng)));
+        box.setPosition({ static_cast<float>(position(rng)),
+                          static_cast<float>(position(rng)),
+                          static_cast<float>(position(rng) / 10) });
+    }
+    return boxes;
+}
+
+static std::vector<ProxyPair> bruteForcePairs(
+  const std::vector<FW::BoundingBox_Quad>& boxes) {
+    std::vector<ProxyPair> pairs;
+    for (uint32_t i = 0; i < boxes.size(); i++) {
+        for (uint32_t j = i + 1; j < boxes.size(); j++) {
+            if (FW::isOverlapping(boxes[i], boxes[j])) {
+                pairs.push_back({ i, j });
+            }
+        }
+    }
+    return pairs;
+}
+
+/** Run `test` with every kernel this CPU supports. */
+template<typename Test>
+static void forEachKernel(Test&& test) {
+    OverlapKernel selected = BoxArray::getKernel();
+    for (OverlapKernel kernel :
+         { OverlapKernel::Scalar, OverlapKernel::SSE, OverlapKernel::AVX2 }) {
+        if (!BoxArray::setKernel(kernel)) {
+            continue;
+        }
+        CAPTURE(static_cast<int>(kernel));
+        test();
+    }
+    BoxArray::setKernel(selected);
+}
+
+TEST_CASE("BoxArray kernels agree with FW::isOverlapping()") {
+    CHECK(BoxArray::isKernelSupported(OverlapKernel::Scalar));
+    CHECK(BoxArray::isKernelSupported(BoxArray::getKernel()));
+
+    // Sizes around multiples of the batch size, to reach the padding
+    for (std::size_t count : { 1, 7, 8, 9, 100, 301 }) {
+        std::vector<FW::BoundingBox_Quad> boxes = makeBoxes(count, 1);
+        BoxArray array;
+        for (const auto& box : boxes) {
+            array.add(box);
+        }
+        REQUIRE(array.size() == count);
+
+        std::vector<ProxyPair> expected = bruteForcePairs(boxes);
+        forEachKernel([&] {
+            std::vector<ProxyPair> pairs;
+            array.findPairs(pairs);
+            CHECK(pairs == expected);
+
+            std::vector<uint32_t> result;
+            array.query(boxes[0], result);
+            std::vector<uint32_t> overlapping;
+            for (uint32_t i = 0; i < boxes.size(); i++) {
+                if (FW::isOverlapping(boxes[0], boxes[i])) {
+                    overlapping.push_back(i);
+                }
+            }
+            CHECK(result == overlapping);
+        });
+    }
+}
+
+TEST_CASE("BoxArray::set() replaces a box and clear() empties the array") {
+    BoxArray array;
+    FW::BoundingBox_Quad box;
+    box.setScale(1.0f);
+    box.setPosition({ 0.0f, 0.0f, 0.0f });
+    array.add(box);
+    box.setPosition({ 10.0f, 0.0f, 0.0f });
+    uint32_t moved = array.add(box);
+
+    std::vector<ProxyPair> pairs;
+    array.findPairs(pairs);
+    CHECK(pairs.empty());
+
+    box.setPosition({ 0.5f, 0.5f, 0.5f });
+    array.set(moved, box);
+    array.findPairs(pairs);
+    CHECK(pairs == std::vector<ProxyPair>{ { 0, 1 } });
+
+    array.clear();
+    CHECK(array.size() == 0);
+    array.findPairs(pairs);
+    CHECK(pairs.empty());
+}
+
+TEST_CASE("SpatialHash tests crowded cells in batches") {
+    // One cell holds every box
+    std::vector<FW::BoundingBox_Quad> boxes = makeBoxes(200, 2);
+    FW::Physics::SpatialHash hash(1000.0f);
+    for (const auto& box : boxes) {
+        hash.insert(box);
+    }
+    std::vector<ProxyPair> expected = bruteForcePairs(boxes);
+    REQUIRE(!expected.empty());
+
+    forEachKernel([&] {
+        std::vector<ProxyPair> pairs;
+        hash.findPairs(pairs);
+        std::sort(pairs.begin(), pairs.end(), [](ProxyPair x, ProxyPair y) {
+            return x.a != y.a ? x.a < y.a : x.b < y.b;
+        });
+        CHECK(pairs == expected);
+    });
+}
@@ -0,0 +1,47 @@
+#include "doctest/doctest.h"
+
+#include "Islands.h"
+
+using FW::Physics::BodyPair;
+using FW::Physics::Island;
+using FW::Physics::IslandBuilder;
+
+TEST_CASE("IslandBuilder groups bodies connected by contacts") {
+    // Body 0 is the ground. 1-3 and 4-5 stand on it, 6 floats alone.
+    const float inverseMass[] = { 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+    std::vector<BodyPair> contacts = {
+        { 0, 4 }, { 0, 1 }, { 2, 3 }, { 4, 5 }, { 1, 2 }, { 0, 0 }
+    };
+
+    IslandBuilder builder;
+    builder.build(7, contacts, inverseMass);
+
+    // The ground does not join the stacks, and body 6 has no contacts
+    const std::vector<Island>& islands = builder.getIslands();
+    REQUIRE(islands.size() == 2);
+    CHECK(builder.getBodies() == std::vector<uint32_t>{ 1, 2, 3, 4, 5 });
+
+    CHECK(islands[0].firstBody == 0);
+    CHECK(islands[0].bodyCount == 3);
+    CHECK(islands[1].firstBody == 3);
+    CHECK(islands[1].bodyCount == 2);
+
+    // Each ground contact belongs to the island standing on it, and
+    // contacts keep their order within an island
+    CHECK(builder.getContacts() == std::vector<uint32_t>{ 1, 2, 4, 0, 3 });
+    CHECK(islands[0].firstContact == 0);
+    CHECK(islands[0].contactCount == 3);
+    CHECK(islands[1].firstContact == 3);
+    CHECK(islands[1].contactCount == 2);
+
+    // A moving body joins the two stacks
+    contacts.push_back({ 3, 5 });
+    builder.build(7, contacts, inverseMass);
+    REQUIRE(builder.getIslands().size() == 1);
+    CHECK(builder.getIslands()[0].bodyCount == 5);
+    CHECK(builder.getIslands()[0].contactCount == 6);
+
+    builder.build(7, {}, inverseMass);
+    CHECK(builder.getIslands().empty());
+    CHECK(builder.getBodies().empty());
+}
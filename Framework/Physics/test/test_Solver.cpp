@@ -0,0 +1,171 @@
+#include "doctest/doctest.h"
+
+#include "Component.h"
+#include "JobSystem.h"
+#include "Solver.h"
+
+#include <cmath>
+
+using FW::Physics::BodyId;
+
+TEST_CASE("Solver integrates gravity with semi-implicit Euler") {
+    FW::Physics::Solver solver;
+    solver.addForce(FW::createRef<FW::Physics::GravityForce>(
+      glm::vec3{ 0.0f, -10.0f, 0.0f }));
+
+    FW::TransformationComponent transform;
+    transform.setPosition(1.0f, 100.0f, 0.0f);
+    BodyId heavy = solver.addBody(&transform, 5.0f);
+    BodyId light = solver.addBody(nullptr, 0.1f);
+    BodyId ground = solver.addBody(nullptr, 0.0f);
+    CHECK(solver.getPosition(heavy) == glm::vec3{ 1.0f, 100.0f, 0.0f });
+
+    // After n steps of h, v = -10 n h, and y falls by 10 h² n (n + 1) / 2
+    constexpr int steps = 10;
+    constexpr float delta = 0.1f;
+    for (int i = 0; i < steps; i++) {
+        solver.update(delta);
+    }
+    float fallen = 10.0f * delta * delta * steps * (steps + 1) / 2.0f;
+
+    CHECK(solver.getVelocity(heavy).y == doctest::Approx(-10.0f));
+    CHECK(solver.getPosition(heavy).y == doctest::Approx(100.0f - fallen));
+    // Gravity does not depend on mass
+    CHECK(solver.getPosition(light).y == doctest::Approx(-fallen));
+    CHECK(solver.getPosition(ground) == glm::vec3{ 0.0f });
+
+    // The transform follows the body
+    CHECK(transform.getPosition().x == doctest::Approx(1.0f));
+    CHECK(transform.getPosition().y == doctest::Approx(100.0f - fallen));
+}
+
+TEST_CASE("Solver applies forces for one update") {
+    FW::Physics::Solver solver;
+    BodyId body = solver.addBody(nullptr, 2.0f);
+
+    // a = F / m = 4, applied for one second
+    solver.applyForce(body, { 6.0f, 0.0f, 0.0f });
+    solver.applyForce(body, { 2.0f, 0.0f, 0.0f });
+    solver.update(1.0f);
+    CHECK(solver.getVelocity(body).x == doctest::Approx(4.0f));
+    CHECK(solver.getPosition(body).x == doctest::Approx(4.0f));
+
+    // The force is used up, and the body keeps its velocity
+    solver.update(1.0f);
+    CHECK(solver.getVelocity(body).x == doctest::Approx(4.0f));
+    CHECK(solver.getPosition(body).x == doctest::Approx(8.0f));
+
+    // Static bodies ignore forces, but can still be given a velocity
+    solver.setMass(body, 0.0f);
+    solver.applyForce(body, { 100.0f, 0.0f, 0.0f });
+    solver.setVelocity(body, { 0.0f, 1.0f, 0.0f });
+    solver.update(1.0f);
+    CHECK(solver.getPosition(body) == glm::vec3{ 8.0f, 1.0f, 0.0f });
+}
+
+TEST_CASE("Solver keeps handles valid when bodies are removed") {
+    FW::Physics::Solver solver;
+    std::vector<BodyId> bodies;
+    for (int i = 0; i < 5; i++) {
+        BodyId body = solver.addBody(nullptr);
+        solver.setPosition(body, { static_cast<float>(i), 0.0f, 0.0f });
+        bodies.push_back(body);
+    }
+
+    solver.removeBody(bodies[1]);
+    solver.removeBody(bodies[4]);
+    CHECK(solver.getBodyCount() == 3);
+    CHECK(solver.getPosition(bodies[0]).x == 0.0f);
+    CHECK(solver.getPosition(bodies[2]).x == 2.0f);
+    CHECK(solver.getPosition(bodies[3]).x == 3.0f);
+
+    // Removed handles are reused
+    BodyId added = solver.addBody(nullptr);
+    CHECK((added == bodies[1] || added == bodies[4]));
+    CHECK(solver.getPosition(added) == glm::vec3{ 0.0f });
+    CHECK(solver.getPosition(bodies[3]).x == 3.0f);
+}
+
+TEST_CASE("Solver rests boxes on static bodies") {
+    FW::Physics::Solver solver;
+    solver.addForce(FW::createRef<FW::Physics::GravityForce>(
+      glm::vec3{ 0.0f, -10.0f, 0.0f }));
+
+    BodyId ground = solver.addBody(nullptr, 0.0f);
+    solver.setPosition(ground, { -10.0f, -1.0f, 0.0f });
+    solver.setBodySize(ground, { 20.0f, 1.0f, 1.0f });
+
+    FW::TransformationComponent transform;
+    transform.setPosition(0.0f, 0.5f, 0.0f);
+    BodyId box = solver.addBody(&transform, 1.0f);
+    solver.setBodySize(box, glm::vec3{ 1.0f });
+    BodyId top = solver.addBody(nullptr, 1.0f);
+    solver.setPosition(top, { 0.5f, 3.0f, 0.0f });
+    solver.setBodySize(top, glm::vec3{ 1.0f });
+
+    for (int i = 0; i < 120; i++) {
+        solver.update(1.0f / 60.0f);
+    }
+
+    // The box lands on the ground, and the other box on top of it
+    CHECK(solver.getPosition(box).y == doctest::Approx(0.0f).epsilon(1e-3));
+    CHECK(solver.getPosition(top).y == doctest::Approx(1.0f).epsilon(1e-3));
+    // Each pass over the stack leaves a little of the weight of the top box
+    // pressing on the lower one, much less than one step of gravity
+    CHECK(std::abs(solver.getVelocity(box).y) < 10.0f / 60.0f / 10.0f);
+    CHECK(solver.getPosition(ground) == glm::vec3{ -10.0f, -1.0f, 0.0f });
+    CHECK(transform.getPosition().y == doctest::Approx(0.0f).epsilon(1e-3));
+
+    CHECK(solver.getIslandCount() == 1);
+    REQUIRE(solver.getContacts().size() == 2);
+    for (const auto& contact : solver.getContacts()) {
+        CHECK(contact.normal == glm::vec3{ 0.0f, 1.0f, 0.0f });
+    }
+
+    // Without a size, the box falls through
+    solver.setBodySize(box, glm::vec3{ 0.0f });
+    solver.update(1.0f / 60.0f);
+    CHECK(solver.getPosition(box).y < 0.0f);
+}
+
+TEST_CASE("Solver gives the same result on any number of threads") {
+    // Clusters of boxes falling onto one shared ground
+    auto run = [](FW::JobSystem* jobs) {
+        FW::Physics::Solver solver;
+        solver.addForce(FW::createRef<FW::Physics::GravityForce>());
+        BodyId ground = solver.addBody(nullptr, 0.0f);
+        solver.setPosition(ground, { -1000.0f, -1.0f, 0.0f });
+        solver.setBodySize(ground, { 2000.0f, 1.0f, 1.0f });
+
+        for (int cluster = 0; cluster < 64; cluster++) {
+            for (int i = 0; i < 6; i++) {
+                BodyId body = solver.addBody(nullptr, 1.0f + i % 3);
+                float x = cluster * 8.0f + (i % 2) * 0.6f;
+                solver.setPosition(body, { x, i * 0.9f, 0.0f });
+                solver.setVelocity(body, { (i % 2) - 0.5f, 0.0f, 0.0f });
+                solver.setBodySize(body, glm::vec3{ 1.0f });
+            }
+        }
+
+        for (int i = 0; i < 60; i++) {
+            if (jobs) {
+                solver.update(1.0f / 60.0f, *jobs);
+            } else {
+                solver.update(1.0f / 60.0f);
+            }
+        }
+        CHECK(solver.getIslandCount() > 1);
+        return solver.getBodies();
+    };
+
+    FW::Physics::BodyStates serial = run(nullptr);
+    for (uint32_t workers : { 0u, 3u }) {
+        CAPTURE(workers);
+        FW::JobSystem jobs(workers);
+        FW::Physics::BodyStates parallel = run(&jobs);
+        CHECK(parallel.positionX == serial.positionX);
+        CHECK(parallel.positionY == serial.positionY);
+        CHECK(parallel.velocityX == serial.velocityX);
+        CHECK(parallel.velocityY == serial.velocityY);
+    }
+}
@@ -0,0 +1,95 @@
+#include "doctest/doctest.h"
+
+#include "BroadphaseTestUtils.h"
+#include "SpatialHash.h"
+
+#include <algorithm>
+#include <random>
+
+using FW::Physics::ProxyId;
+using FW::Physics::ProxyPair;
+
+/** Random boxes, some of them spanning several cells and some negative. */
+static std::vector<FW::BoundingBox_Quad> makeBoxes(std::size_t count,
+                                                   unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-200.0f, 200.0f);
+    std::uniform_real_distribution<float> size(1.0f, 40.0f);
+
+    std::vector<FW::BoundingBox_Quad> boxes;
+    for (std::size_t i = 0; i < count; i++) {
+        boxes.push_back(
+          makeBox(position(rng), position(rng), size(rng), size(rng)));
+    }
+    return boxes;
+}
+
+TEST_CASE("SpatialHash finds the same pairs as brute force, once each") {
+    FW::Physics::SpatialHash hash(16.0f);
+    std::vector<ProxyId> proxies;
+    for (const auto& box : makeBoxes(500, 1)) {
+        proxies.push_back(hash.insert(box));
+    }
+
+    std::vector<ProxyPair> pairs;
+    hash.findPairs(pairs);
+    sortPairs(pairs);
+    std::vector<ProxyPair> expected = bruteForcePairs(hash, proxies);
+    sortPairs(expected);
+
+    REQUIRE(!expected.empty());
+    CHECK(std::adjacent_find(pairs.begin(), pairs.end()) == pairs.end());
+    CHECK(pairs == expected);
+}
+
+TEST_CASE("SpatialHash keeps pairs correct as boxes move and are removed") {
+    FW::Physics::SpatialHash hash(16.0f);
+    std::vector<ProxyId> proxies;
+    for (const auto& box : makeBoxes(300, 2)) {
+        proxies.push_back(hash.insert(box));
+    }
+
+    // Move every box to a new random place, remove a third and add more
+    std::vector<FW::BoundingBox_Quad> moved = makeBoxes(300, 3);
+    for (std::size_t i = 0; i < proxies.size(); i++) {
+        hash.move(proxies[i], moved[i]);
+    }
+    std::vector<ProxyId> kept;
+    for (std::size_t i = 0; i < proxies.size(); i++) {
+        if (i % 3 == 0) {
+            hash.remove(proxies[i]);
+        } else {
+            kept.push_back(proxies[i]);
+        }
+    }
+    for (const auto& box : makeBoxes(50, 4)) {
+        kept.push_back(hash.insert(box));
+    }
+
+    CHECK(hash.getProxyCount() == kept.size());
+    // Removed handles are reused first
+    CHECK(*std::max_element(kept.begin(), kept.end()) < 300);
+
+    std::vector<ProxyPair> pairs;
+    hash.findPairs(pairs);
+    sortPairs(pairs);
+    std::vector<ProxyPair> expected = bruteForcePairs(hash, kept);
+    sortPairs(expected);
+    CHECK(pairs == expected);
+}
+
+TEST_CASE("SpatialHash::query() returns each overlapping box once") {
+    FW::Physics::SpatialHash hash(10.0f);
+    ProxyId wide = hash.insert(makeBox(-50.0f, 0.0f, 100.0f, 5.0f));
+    ProxyId small = hash.insert(makeBox(2.0f, 2.0f, 1.0f, 1.0f));
+    hash.insert(makeBox(100.0f, 100.0f, 1.0f, 1.0f));
+
+    std::vector<ProxyId> result;
+    hash.query(makeBox(-20.0f, 1.0f, 30.0f, 3.0f), result);
+    std::sort(result.begin(), result.end());
+    CHECK(result == std::vector<ProxyId>{ wide, small });
+
+    result.clear();
+    hash.query(makeBox(500.0f, 500.0f, 1.0f, 1.0f), result);
+    CHECK(result.empty());
+}
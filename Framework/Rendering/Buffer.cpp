@@ -1,4 +1,5 @@
 #include "Buffer.h"
+#include "RenderState.h"
 #include "Log.h"
 
 namespace FW {
@@ -24,17 +25,17 @@ namespace FW {
 
     void VertexArray::bind() const
     {
-        glBindVertexArray(vertexArrayID);
+        RenderState::get().bindVertexArray(vertexArrayID);
     }
 
     void VertexArray::unbind() const
     {
-        glBindVertexArray(0);
+        RenderState::get().bindVertexArray(0);
     }
 
     void VertexArray::addVertexBuffer(ref<VertexBuffer> vertexBuffer) {
 
-        glBindVertexArray(vertexArrayID);
+        bind();
         vertexBuffer->bind();
 
         // Set vertex attributes
@@ -56,7 +57,7 @@ namespace FW {
     }
 
     void VertexArray::setIndexBuffer(ref<IndexBuffer> indexBuffer) {
-        glBindVertexArray(vertexArrayID);
+        bind();
         indexBuffer->bind();
         this->indexBuffer = indexBuffer;
     }
@@ -115,7 +116,7 @@ namespace FW {
         glGenBuffers(1, &indexBufferID);
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBufferID);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                     count * sizeof(GLsizeiptr),
+                     count * sizeof(GLuint),
                      indices,
                      GL_STATIC_DRAW);
 
@@ -144,6 +145,36 @@ namespace FW {
     }
 #pragma endregion
 
+#pragma region Uniform Buffer
+    UniformBuffer::UniformBuffer(GLsizeiptr size, GLuint binding)
+      : binding(binding)
+    {
+        glGenBuffers(1, &uniformBufferID);
+        glBindBuffer(GL_UNIFORM_BUFFER, uniformBufferID);
+        glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, binding, uniformBufferID);
+    }
+
+    UniformBuffer::~UniformBuffer()
+    {
+        glDeleteBuffers(1, &uniformBufferID);
+    }
+
+    void UniformBuffer::bufferSubData(GLintptr offset,
+                                      GLsizeiptr size,
+                                      const void* data) const
+    {
+        glBindBuffer(GL_UNIFORM_BUFFER, uniformBufferID);
+        glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+    }
+
+    std::shared_ptr<UniformBuffer> UniformBuffer::create(GLsizeiptr size,
+                                                         GLuint binding)
+    {
+        return std::make_shared<UniformBuffer>(size, binding);
+    }
+#pragma endregion
+
 #pragma region Framebuffer
     Framebuffer::Framebuffer()
     {
@@ -153,12 +184,16 @@ namespace FW {
     Framebuffer::~Framebuffer()
     {
         glDeleteFramebuffers(1, &fbo);
+        RenderState::get().forgetTexture(colorAttachment);
+        RenderState::get().forgetTexture(depthAttachment);
         glDeleteTextures(1, &colorAttachment);
         glDeleteTextures(1, &depthAttachment);
     }
 
     void Framebuffer::resize(const glm::vec2& new_size) {
         glDeleteFramebuffers(1, &fbo);
+        RenderState::get().forgetTexture(colorAttachment);
+        RenderState::get().forgetTexture(depthAttachment);
         glDeleteTextures(1, &colorAttachment);
         glDeleteTextures(1, &depthAttachment);
 
@@ -172,7 +207,7 @@ namespace FW {
         glBindFramebuffer(GL_FRAMEBUFFER, fbo);
 
         glGenTextures(1, &colorAttachment);
-        glBindTexture(GL_TEXTURE_2D, colorAttachment);
+        RenderState::get().bindTexture(GL_TEXTURE_2D, colorAttachment, 0);
 
         glTexImage2D(GL_TEXTURE_2D,
                      0,
@@ -195,7 +230,7 @@ namespace FW {
 
         // Depth
         glCreateTextures(GL_TEXTURE_2D, 1, &depthAttachment);
-        glBindTexture(GL_TEXTURE_2D, depthAttachment);
+        RenderState::get().bindTexture(GL_TEXTURE_2D, depthAttachment, 0);
         glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH24_STENCIL8, size.x, size.y);
 
         glFramebufferTexture2D(GL_FRAMEBUFFER,
@@ -262,7 +297,7 @@ namespace FW {
 
     void Framebuffer::bindTexture() const
     {
-        glBindTexture(GL_TEXTURE_2D, colorAttachment);
+        RenderState::get().bindTexture(GL_TEXTURE_2D, colorAttachment, 0);
     }
 #pragma endregion
 }
@@ -17,6 +17,7 @@ namespace FW {
     class VertexArray;
     class VertexBuffer;
     class IndexBuffer;
+    class UniformBuffer;
 
 
 #pragma region Buffer Layout
@@ -305,6 +306,44 @@ namespace FW {
     };
 #pragma endregion
 
+#pragma region Uniform Buffer
+    /**
+     * Uniform Buffer Object in OpenGL.
+     *
+     * A Uniform Buffer Object holds a block of uniforms that is shared by
+     * every shader reading from the same binding point, so the data is
+     * uploaded once instead of once per shader.
+     */
+    class UniformBuffer {
+    public:
+        /**
+         * Create a buffer of `size` bytes and attach it to `binding`.
+         *
+         * The shaders declare the block with
+         * `layout(std140, binding = <binding>) uniform ...`.
+         */
+        UniformBuffer(GLsizeiptr size, GLuint binding);
+        virtual ~UniformBuffer();
+
+        UniformBuffer(const UniformBuffer&) = delete;
+        UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+        /** Fill a segment of the buffer. */
+        void bufferSubData(GLintptr offset,
+                           GLsizeiptr size,
+                           const void* data) const;
+
+        GLuint getBinding() const { return binding; }
+
+        static std::shared_ptr<UniformBuffer> create(GLsizeiptr size,
+                                                     GLuint binding);
+
+    private:
+        GLuint uniformBufferID = 0;
+        GLuint binding = 0;
+    };
+#pragma endregion
+
 #pragma region Framebuffer
     class Framebuffer
     {
@@ -1,9 +1,89 @@
 #include "Camera.h"
+#include "Buffer.h"
+#include "assertions.h"
 
 #include "glm/gtc/matrix_transform.hpp"
 #include "pch.h"
 
+#include <optional>
+
+static_assert(sizeof(FW::Camera::UniformData) == 160,
+              "Camera::UniformData must match the std140 block layout");
+
 namespace FW {
+    /** Shared by all cameras, lives as long as the RenderCommand context. */
+    static scope<UniformBuffer> uniformBuffer;
+    /** Contents of `uniformBuffer`, to skip redundant uploads. */
+    static std::optional<Camera::UniformData> uploaded;
+
+    static void uploadUniformData(const Camera::UniformData& data)
+    {
+        ASSERT(uniformBuffer,
+               "Camera: RenderCommand::init() must be called before binding "
+               "the uniform buffer");
+        if (uploaded == data) {
+            return;
+        }
+
+        uniformBuffer->bufferSubData(0, sizeof(Camera::UniformData), &data);
+        uploaded = data;
+    }
+
+    void Camera::createUniformBuffer()
+    {
+        uniformBuffer =
+          createScope<UniformBuffer>(sizeof(UniformData), uniformBufferBinding);
+        uploaded.reset();
+    }
+
+    void Camera::destroyUniformBuffer()
+    {
+        uniformBuffer = nullptr;
+        uploaded.reset();
+    }
+
+    void Camera::bindUniformBuffer()
+    {
+        glm::vec2 clipPlanes = getClipPlanes();
+        uploadUniformData({ projectionMatrix,
+                            viewMatrix,
+                            position,
+                            clipPlanes.x,
+                            clipPlanes.y,
+                            {} });
+    }
+
+    void Camera::bindIdentityUniformBuffer()
+    {
+        uploadUniformData({ glm::mat4(1.0f),
+                            glm::mat4(1.0f),
+                            glm::vec3(0.0f),
+                            0.0f,
+                            0.0f,
+                            {} });
+    }
+
+    void Camera::updateShader(const Shader* shader)
+    {
+        bindUniformBuffer();
+        if (!shader) {
+            return;
+        }
+        shader->bind();
+
+        // Shaders written before the uniform block existed
+        if (shader->getUniformLocation("u_projection") < 0) {
+            return;
+        }
+
+        glm::vec2 clipPlanes = getClipPlanes();
+        shader->setParam("u_projection", projectionMatrix);
+        shader->setParam("u_view", viewMatrix);
+        shader->setParam("u_cameraPosition", position);
+        shader->setParam("u_nearClip", clipPlanes.x);
+        shader->setParam("u_farClip", clipPlanes.y);
+    }
+
 	void Camera::moveForward(const float speed)
 	{
 		// From ChatGPT
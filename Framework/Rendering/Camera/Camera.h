@@ -8,6 +8,7 @@
 #pragma once
 
 #include "glm/glm.hpp"
+#include "Frustum.h"
 #include "Shader.h"
 
 namespace FW {
@@ -32,9 +33,75 @@ namespace FW {
             return projectionMatrix;
         }
 
+        /** Get the volume seen by the camera, to skip what is outside it. */
+        Frustum getViewFrustum() const {
+            return Frustum(projectionMatrix * viewMatrix);
+        }
+
+        /**
+         * Make the camera current for `shader`.
+         *
+         * Shaders that declare the `Camera` uniform block read the shared
+         * uniform buffer, see bindUniformBuffer(). The individual uniforms
+         * are only uploaded to shaders that still declare them.
+         */
         virtual void update(const ref<Shader>& shader) = 0;
         virtual void update(const Shader* shader) = 0;
 
+        /**
+         * Layout of the `Camera` uniform block, following std140:
+         *
+         * @code
+         * layout(std140, binding = 0) uniform Camera {
+         *     mat4 u_projection;
+         *     mat4 u_view;
+         *     vec3 u_cameraPosition;
+         *     float u_nearClip;
+         *     float u_farClip;
+         * };
+         * @endcode
+         */
+        struct UniformData {
+            glm::mat4 projection;
+            glm::mat4 view;
+            glm::vec3 position;
+            float nearClip;
+            float farClip;
+            float padding[3];
+
+            bool operator==(const UniformData&) const = default;
+        };
+
+        /** Binding point of the `Camera` uniform block. */
+        static constexpr GLuint uniformBufferBinding = 0;
+
+        /**
+         * Write this camera to the uniform buffer shared by all shaders.
+         *
+         * The buffer is only written when it holds another camera or this
+         * camera has changed since the last upload, so calling this once per
+         * drawn object is cheap.
+         */
+        void bindUniformBuffer();
+
+        /**
+         * Write identity view and projection matrices to the uniform buffer,
+         * for drawing in clip space when there is no camera.
+         */
+        static void bindIdentityUniformBuffer();
+
+        /**
+         * Create the uniform buffer in the current GL context. Called by
+         * RenderCommand::init().
+         */
+        static void createUniformBuffer();
+
+        /**
+         * Release the uniform buffer before its GL context is destroyed.
+         * Called by RenderCommand::destroy().
+         */
+        static void destroyUniformBuffer();
+
         // -------------
         // Camera Movement
         // -------------
@@ -92,6 +159,13 @@ namespace FW {
          */
         virtual void computeProjectionMatrix() = 0;
 
+    protected:
+        /** Near and far clip planes, in that order. */
+        virtual glm::vec2 getClipPlanes() const = 0;
+
+        /** Shared implementation of update(). */
+        void updateShader(const Shader* shader);
+
     private:
         /**
          * @brief Computes the camera's front vector and view matrix
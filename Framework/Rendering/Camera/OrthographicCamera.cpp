@@ -23,22 +23,12 @@ namespace FW {
     }
 
     void OrthographicCamera::update(const ref<Shader>& shader) {
-        shader->bind();
-        shader->setMat4("u_projection", getProjectionMatrix());
-        shader->setMat4("u_view", getViewMatrix());
-        shader->setFloat3("u_cameraPosition", getPosition());
-        shader->setFloat("u_nearClip", frustum.near);
-        shader->setFloat("u_farClip", frustum.far);
+        updateShader(shader.get());
     }
     
     
     void OrthographicCamera::update(const Shader* shader) {
-        shader->bind();
-        shader->setMat4("u_projection", getProjectionMatrix());
-        shader->setMat4("u_view", getViewMatrix());
-        shader->setFloat3("u_cameraPosition", getPosition());
-        shader->setFloat("u_nearClip", frustum.near);
-        shader->setFloat("u_farClip", frustum.far);
+        updateShader(shader);
     }
 
     void OrthographicCamera::setCentraliseScreenCoordinates(bool b) {
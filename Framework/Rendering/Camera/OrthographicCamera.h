@@ -60,6 +60,11 @@ namespace FW {
          */
         void setCentraliseScreenCoordinates(bool b);
 
+    protected:
+        glm::vec2 getClipPlanes() const override {
+            return { frustum.near, frustum.far };
+        }
+
     private:
         void computeViewMatrix() override;
         bool centraliseScreenCoordinates = false;
@@ -63,21 +63,11 @@ namespace FW {
     }
 
     void PerspectiveCamera::update(const ref<Shader>& shader) {
-        shader->bind();
-        shader->setMat4("u_projection", getProjectionMatrix());
-        shader->setMat4("u_view", getViewMatrix());
-        shader->setFloat3("u_cameraPosition", getPosition());
-        shader->setFloat("u_nearClip", frustum.nearClip);
-        shader->setFloat("u_farClip", frustum.farClip);
+        updateShader(shader.get());
     }
 
     void PerspectiveCamera::update(const Shader* shader) {
-        shader->bind();
-        shader->setMat4("u_projection", getProjectionMatrix());
-        shader->setMat4("u_view", getViewMatrix());
-        shader->setFloat3("u_cameraPosition", getPosition());
-        shader->setFloat("u_nearClip", frustum.nearClip);
-        shader->setFloat("u_farClip", frustum.farClip);
+        updateShader(shader);
     }
 
     void PerspectiveCamera::updateViewportSize(const glm::vec2& size) {
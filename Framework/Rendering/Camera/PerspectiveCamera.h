@@ -80,6 +80,10 @@ namespace FW {
     protected:
         void computeViewMatrix() override;
 
+        glm::vec2 getClipPlanes() const override {
+            return { frustum.nearClip, frustum.farClip };
+        }
+
     protected:
         glm::vec3 lookAt, upVector;
         Frustum frustum;
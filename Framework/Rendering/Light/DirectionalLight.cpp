@@ -1,5 +1,3 @@
-#include <sstream>
-
 #include "DirectionalLight.h"
 
 namespace FW {
@@ -7,12 +5,12 @@ namespace FW {
 
     void DirectionalLight::draw(const ref<Shader>& shader)
     {
-        std::stringstream ss;
-        ss << "u_directionalLight[" << numOfDirectionalLights - 1 << "]";
-        shader->setFloat3(ss.str() + ".ambient", ambient);
-        shader->setFloat3(ss.str() + ".diffuse", diffuse);
-        shader->setFloat3(ss.str() + ".specular", specular);
-        shader->setFloat3(ss.str() + ".direction", direction);
-        shader->setInt("numOfDirectionalLights", numOfDirectionalLights);
+        const std::string prefix =
+          "u_directionalLight[" + std::to_string(numOfDirectionalLights - 1) + "]";
+        shader->setParam(prefix + ".ambient", ambient);
+        shader->setParam(prefix + ".diffuse", diffuse);
+        shader->setParam(prefix + ".specular", specular);
+        shader->setParam(prefix + ".direction", direction);
+        shader->setParam("numOfDirectionalLights", numOfDirectionalLights);
     }
 } // FW
@@ -1,5 +1,3 @@
-#include <sstream>
-
 #include "PointLight.h"
 
 #include "Log.h"
@@ -9,21 +7,21 @@ namespace FW {
 
     void PointLight::draw(const ref<Shader>& shader)
     {
-        std::stringstream ss;
-        ss << "u_pointLight[" << numOfPointLights - 1 << "]";
+        const std::string prefix =
+          "u_pointLight[" + std::to_string(numOfPointLights - 1) + "]";
 
-        shader->setFloat3(ss.str() + ".ambient", ambient);
-        shader->setFloat3(ss.str() + ".diffuse", diffuse);
-        shader->setFloat3(ss.str() + ".specular", specular);
+        shader->setParam(prefix + ".ambient", ambient);
+        shader->setParam(prefix + ".diffuse", diffuse);
+        shader->setParam(prefix + ".specular", specular);
 
-        shader->setFloat3(ss.str() + ".position", position);
+        shader->setParam(prefix + ".position", position);
 
-        shader->setFloat(ss.str() + ".constant", constant);
-        shader->setFloat(ss.str() + ".linear", linear);
-        shader->setFloat(ss.str() + ".quadratic", quadratic);
+        shader->setParam(prefix + ".constant", constant);
+        shader->setParam(prefix + ".linear", linear);
+        shader->setParam(prefix + ".quadratic", quadratic);
 
-        shader->setInt("numOfPointLights", numOfPointLights);
+        shader->setParam("numOfPointLights", numOfPointLights);
 
-        shader->setFloat(ss.str() + ".brightness", brightness);
+        shader->setParam(prefix + ".brightness", brightness);
     }
 } // Framework
@@ -66,18 +66,18 @@ namespace FW {
         // are testing against.
         auto oldDepthTestingFunc = RenderCommand::getCurrentDepthFunc();
         RenderCommand::setCurrentDepthFunc(GL_LEQUAL);
-        glDepthMask(GL_FALSE);
-        glFrontFace(GL_CCW);
-        glCullFace(GL_BACK);
+        RenderState::get().setDepthMask(false);
+        RenderState::get().setFrontFace(GL_CCW);
+        RenderState::get().setCullMode(GL_BACK);
 
         // Upload all required uniforms
         shader->setMat4("u_model", modelMatrix);
         TextureManager::bind(textureId, 0);
         RenderCommand::drawIndex(*vertexArray);
 
-        glCullFace(GL_FRONT);
-        glFrontFace(GL_CW);
-        glDepthMask(GL_TRUE);
+        RenderState::get().setCullMode(GL_FRONT);
+        RenderState::get().setFrontFace(GL_CW);
+        RenderState::get().setDepthMask(true);
         RenderCommand::setCurrentDepthFunc(oldDepthTestingFunc);
     }
 
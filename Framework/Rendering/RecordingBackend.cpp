@@ -0,0 +1,778 @@
+#include "RecordingBackend.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <sstream>
+#include <string_view>
+
+namespace FW {
+    RecordingBackend* RecordingBackend::active = nullptr;
+
+    /** Replacement for entry points whose effect is not recorded. */
+    template<typename Function>
+    struct NoOp;
+
+    template<typename Result, typename... Args>
+    struct NoOp<Result(APIENTRYP)(Args...)> {
+        static Result APIENTRY call(Args...) { return Result(); }
+    };
+
+    /** Bytes per pixel of client pixel data. */
+    static uint64_t getPixelSize(GLenum format, GLenum type)
+    {
+        uint64_t channels = 4;
+        switch (format) {
+            case GL_RED:
+            case GL_DEPTH_COMPONENT:
+            case GL_DEPTH_STENCIL:
+                channels = 1;
+                break;
+            case GL_RG:
+                channels = 2;
+                break;
+            case GL_RGB:
+            case GL_BGR:
+                channels = 3;
+                break;
+        }
+
+        switch (type) {
+            case GL_UNSIGNED_BYTE:
+            case GL_BYTE:
+                return channels;
+            case GL_UNSIGNED_SHORT:
+            case GL_SHORT:
+            case GL_HALF_FLOAT:
+                return channels * 2;
+            default:
+                return channels * 4;
+        }
+    }
+
+    struct RecordingBackend::Hooks {
+        using Type = Command::Type;
+
+        static GLuint createName() { return active->nextName++; }
+
+        static void APIENTRY genNames(GLsizei n, GLuint* names)
+        {
+            for (GLsizei i = 0; i < n; i++) {
+                names[i] = createName();
+            }
+        }
+
+        static void APIENTRY createTextures(GLenum, GLsizei n, GLuint* names)
+        {
+            genNames(n, names);
+        }
+
+        static GLuint APIENTRY createProgram() { return createName(); }
+        static GLuint APIENTRY createShader(GLenum) { return createName(); }
+
+        // --------
+        // Shaders
+        // --------
+        static void APIENTRY shaderSource(GLuint shader,
+                                          GLsizei count,
+                                          const GLchar* const* strings,
+                                          const GLint* lengths)
+        {
+            std::string& source = active->shaderSources[shader];
+            source.clear();
+            for (GLsizei i = 0; i < count; i++) {
+                if (lengths && lengths[i] >= 0) {
+                    source.append(strings[i], lengths[i]);
+                } else {
+                    source.append(strings[i]);
+                }
+            }
+        }
+
+        static void APIENTRY attachShader(GLuint program, GLuint shader)
+        {
+            active->reflect(program, shader);
+        }
+
+        static void APIENTRY deleteShader(GLuint shader)
+        {
+            active->shaderSources.erase(shader);
+        }
+
+        static void APIENTRY deleteProgram(GLuint program)
+        {
+            active->programs.erase(program);
+        }
+
+        static void APIENTRY getShaderiv(GLuint, GLenum name, GLint* value)
+        {
+            *value = name == GL_COMPILE_STATUS ? GL_TRUE : 0;
+        }
+
+        static void APIENTRY getProgramiv(GLuint program,
+                                          GLenum name,
+                                          GLint* value)
+        {
+            const Program& state = active->programs[program];
+            switch (name) {
+                case GL_LINK_STATUS:
+                    *value = GL_TRUE;
+                    break;
+                case GL_ACTIVE_UNIFORMS:
+                    *value = (GLint)state.uniforms.size();
+                    break;
+                case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+                    *value = 0;
+                    for (const auto& uniform : state.uniforms) {
+                        // Room for "[0]" and the terminator
+                        *value =
+                          std::max(*value, (GLint)uniform.name.size() + 4);
+                    }
+                    break;
+                default:
+                    *value = 0;
+            }
+        }
+
+        static void APIENTRY getActiveUniform(GLuint program,
+                                              GLuint index,
+                                              GLsizei bufferSize,
+                                              GLsizei* length,
+                                              GLint* size,
+                                              GLenum* type,
+                                              GLchar* name)
+        {
+            const auto& uniforms = active->programs[program].uniforms;
+            if (index >= uniforms.size()) {
+                *length = 0;
+                return;
+            }
+
+            const Uniform& uniform = uniforms[index];
+            std::string reported =
+              uniform.size > 1 ? uniform.name + "[0]" : uniform.name;
+            *length = std::min<GLsizei>((GLsizei)reported.size(),
+                                        std::max(bufferSize - 1, 0));
+            std::copy_n(reported.data(), *length, name);
+            if (bufferSize > 0) {
+                name[*length] = '\0';
+            }
+            *size = uniform.size;
+            *type = uniform.type;
+        }
+
+        static GLint APIENTRY getUniformLocation(GLuint program,
+                                                 const GLchar* name)
+        {
+            auto it = active->programs.find(program);
+            if (it == active->programs.end()) {
+                return -1;
+            }
+
+            // Array elements are written as "name[element]"
+            std::string_view base = name;
+            GLint element = 0;
+            if (base.ends_with(']')) {
+                size_t open = base.rfind('[');
+                if (open == std::string_view::npos) {
+                    return -1;
+                }
+                std::from_chars(base.data() + open + 1,
+                                base.data() + base.size() - 1,
+                                element);
+                base = base.substr(0, open);
+            }
+
+            for (const auto& uniform : it->second.uniforms) {
+                if (uniform.name == base && element < uniform.size) {
+                    return uniform.location + element;
+                }
+            }
+            return -1;
+        }
+
+        // --------
+        // Queries
+        // --------
+        static void APIENTRY getIntegerv(GLenum name, GLint* value)
+        {
+            *value = name == GL_MAX_TEXTURE_IMAGE_UNITS ? 16 : 0;
+        }
+
+        static const GLubyte* APIENTRY getString(GLenum name)
+        {
+            const char* value = "";
+            switch (name) {
+                case GL_VENDOR:
+                    value = "YAGI";
+                    break;
+                case GL_RENDERER:
+                    value = "Recording backend";
+                    break;
+                case GL_VERSION:
+                    value = "4.6";
+                    break;
+            }
+            return reinterpret_cast<const GLubyte*>(value);
+        }
+
+        static GLenum APIENTRY checkFramebufferStatus(GLenum)
+        {
+            return GL_FRAMEBUFFER_COMPLETE;
+        }
+
+        // --------
+        // Drawing
+        // --------
+        static void APIENTRY drawElements(GLenum,
+                                          GLsizei count,
+                                          GLenum,
+                                          const void*)
+        {
+            active->record(
+              Type::Draw, "glDrawElements", active->vertexArray, count);
+        }
+
+        static void APIENTRY drawArrays(GLenum, GLint, GLsizei count)
+        {
+            active->record(
+              Type::Draw, "glDrawArrays", active->vertexArray, count);
+        }
+
+        static void APIENTRY clear(GLbitfield mask)
+        {
+            active->record(Type::Clear, "glClear", 0, mask);
+        }
+
+        // --------
+        // State
+        // --------
+        static void APIENTRY useProgram(GLuint program)
+        {
+            active->program = program;
+            active->record(Type::StateChange, "glUseProgram", program);
+        }
+
+        static void APIENTRY bindVertexArray(GLuint vertexArray)
+        {
+            active->vertexArray = vertexArray;
+            active->record(Type::StateChange, "glBindVertexArray", vertexArray);
+        }
+
+        static void APIENTRY activeTexture(GLenum unit)
+        {
+            active->activeTexture = unit;
+            active->record(Type::StateChange, "glActiveTexture", 0, unit);
+        }
+
+        static uint64_t getTextureKey(GLenum target)
+        {
+            if (target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X &&
+                target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z) {
+                target = GL_TEXTURE_CUBE_MAP;
+            }
+            return (uint64_t)active->activeTexture << 32 | target;
+        }
+
+        static void APIENTRY bindTexture(GLenum target, GLuint texture)
+        {
+            active->textureBindings[getTextureKey(target)] = texture;
+            active->record(Type::StateChange, "glBindTexture", texture, target);
+        }
+
+        static void APIENTRY bindBuffer(GLenum target, GLuint buffer)
+        {
+            active->bufferBindings[target] = buffer;
+            active->record(Type::StateChange, "glBindBuffer", buffer, target);
+        }
+
+        static void APIENTRY bindBufferBase(GLenum,
+                                            GLuint index,
+                                            GLuint buffer)
+        {
+            active->record(
+              Type::StateChange, "glBindBufferBase", buffer, index);
+        }
+
+        static void APIENTRY bindFramebuffer(GLenum, GLuint framebuffer)
+        {
+            active->record(
+              Type::StateChange, "glBindFramebuffer", framebuffer);
+        }
+
+        static void APIENTRY enable(GLenum capability)
+        {
+            active->record(Type::StateChange, "glEnable", 0, capability);
+        }
+
+        static void APIENTRY disable(GLenum capability)
+        {
+            active->record(Type::StateChange, "glDisable", 0, capability);
+        }
+
+        static void APIENTRY blendFunc(GLenum source, GLenum destination)
+        {
+            active->record(Type::StateChange,
+                           "glBlendFunc",
+                           0,
+                           (uint64_t)source << 32 | destination);
+        }
+
+        static void APIENTRY depthMask(GLboolean flag)
+        {
+            active->record(Type::StateChange, "glDepthMask", 0, flag);
+        }
+
+        static void APIENTRY depthFunc(GLenum func)
+        {
+            active->record(Type::StateChange, "glDepthFunc", 0, func);
+        }
+
+        static void APIENTRY cullFace(GLenum face)
+        {
+            active->record(Type::StateChange, "glCullFace", 0, face);
+        }
+
+        static void APIENTRY frontFace(GLenum mode)
+        {
+            active->record(Type::StateChange, "glFrontFace", 0, mode);
+        }
+
+        static void APIENTRY polygonMode(GLenum, GLenum mode)
+        {
+            active->record(Type::StateChange, "glPolygonMode", 0, mode);
+        }
+
+        static void APIENTRY viewport(GLint,
+                                      GLint,
+                                      GLsizei width,
+                                      GLsizei height)
+        {
+            active->record(Type::StateChange,
+                           "glViewport",
+                           0,
+                           (uint64_t)width << 32 | (uint32_t)height);
+        }
+
+        static void APIENTRY clearColor(GLfloat, GLfloat, GLfloat, GLfloat)
+        {
+            active->record(Type::StateChange, "glClearColor");
+        }
+
+        // --------
+        // Uploads
+        // --------
+        static void APIENTRY bufferData(GLenum target,
+                                        GLsizeiptr size,
+                                        const void* data,
+                                        GLenum)
+        {
+            if (data) {
+                active->record(Type::BufferUpload,
+                               "glBufferData",
+                               active->bufferBindings[target],
+                               size);
+            }
+        }
+
+        static void APIENTRY bufferSubData(GLenum target,
+                                           GLintptr,
+                                           GLsizeiptr size,
+                                           const void*)
+        {
+            active->record(Type::BufferUpload,
+                           "glBufferSubData",
+                           active->bufferBindings[target],
+                           size);
+        }
+
+        static void APIENTRY namedBufferData(GLuint buffer,
+                                             GLsizeiptr size,
+                                             const void* data,
+                                             GLenum)
+        {
+            if (data) {
+                active->record(
+                  Type::BufferUpload, "glNamedBufferData", buffer, size);
+            }
+        }
+
+        static void* APIENTRY mapNamedBufferRange(GLuint buffer,
+                                                  GLintptr,
+                                                  GLsizeiptr length,
+                                                  GLbitfield)
+        {
+            // Whatever is written to the mapping is uploaded on unmap
+            active->mappedBuffer.resize(length);
+            active->record(
+              Type::BufferUpload, "glMapNamedBufferRange", buffer, length);
+            return active->mappedBuffer.data();
+        }
+
+        static GLboolean APIENTRY unmapNamedBuffer(GLuint) { return GL_TRUE; }
+
+        /** True if pixels come from client memory or an unpack buffer. */
+        static bool hasPixels(const void* pixels)
+        {
+            return pixels || active->bufferBindings[GL_PIXEL_UNPACK_BUFFER];
+        }
+
+        static void APIENTRY texImage2D(GLenum target,
+                                        GLint,
+                                        GLint,
+                                        GLsizei width,
+                                        GLsizei height,
+                                        GLint,
+                                        GLenum format,
+                                        GLenum type,
+                                        const void* pixels)
+        {
+            if (hasPixels(pixels)) {
+                active->record(Type::TextureUpload,
+                               "glTexImage2D",
+                               active->textureBindings[getTextureKey(target)],
+                               (uint64_t)width * height *
+                                 getPixelSize(format, type));
+            }
+        }
+
+        static void APIENTRY textureSubImage2D(GLuint texture,
+                                               GLint,
+                                               GLint,
+                                               GLint,
+                                               GLsizei width,
+                                               GLsizei height,
+                                               GLenum format,
+                                               GLenum type,
+                                               const void* pixels)
+        {
+            if (hasPixels(pixels)) {
+                active->record(Type::TextureUpload,
+                               "glTextureSubImage2D",
+                               texture,
+                               (uint64_t)width * height *
+                                 getPixelSize(format, type));
+            }
+        }
+
+        // --------
+        // Uniforms
+        // --------
+        static void uniform(const char* function,
+                            GLuint program,
+                            GLint location)
+        {
+            active->record(Type::Uniform, function, program, location);
+        }
+
+        static void APIENTRY uniform1i(GLint location, GLint)
+        {
+            uniform("glUniform1i", active->program, location);
+        }
+
+        static void APIENTRY uniform1f(GLint location, GLfloat)
+        {
+            uniform("glUniform1f", active->program, location);
+        }
+
+        static void APIENTRY uniform2f(GLint location, GLfloat, GLfloat)
+        {
+            uniform("glUniform2f", active->program, location);
+        }
+
+        static void APIENTRY uniform3f(GLint location,
+                                       GLfloat,
+                                       GLfloat,
+                                       GLfloat)
+        {
+            uniform("glUniform3f", active->program, location);
+        }
+
+        static void APIENTRY uniform4f(GLint location,
+                                       GLfloat,
+                                       GLfloat,
+                                       GLfloat,
+                                       GLfloat)
+        {
+            uniform("glUniform4f", active->program, location);
+        }
+
+        static void APIENTRY uniformMatrix4fv(GLint location,
+                                              GLsizei,
+                                              GLboolean,
+                                              const GLfloat*)
+        {
+            uniform("glUniformMatrix4fv", active->program, location);
+        }
+
+        static void APIENTRY programUniform1i(GLuint program,
+                                              GLint location,
+                                              GLint)
+        {
+            uniform("glProgramUniform1i", program, location);
+        }
+
+        static void APIENTRY programUniform1f(GLuint program,
+                                              GLint location,
+                                              GLfloat)
+        {
+            uniform("glProgramUniform1f", program, location);
+        }
+
+        static void APIENTRY programUniform2f(GLuint program,
+                                              GLint location,
+                                              GLfloat,
+                                              GLfloat)
+        {
+            uniform("glProgramUniform2f", program, location);
+        }
+
+        static void APIENTRY programUniform3f(GLuint program,
+                                              GLint location,
+                                              GLfloat,
+                                              GLfloat,
+                                              GLfloat)
+        {
+            uniform("glProgramUniform3f", program, location);
+        }
+
+        static void APIENTRY programUniform4f(GLuint program,
+                                              GLint location,
+                                              GLfloat,
+                                              GLfloat,
+                                              GLfloat,
+                                              GLfloat)
+        {
+            uniform("glProgramUniform4f", program, location);
+        }
+
+        static void APIENTRY programUniformMatrix4fv(GLuint program,
+                                                     GLint location,
+                                                     GLsizei,
+                                                     GLboolean,
+                                                     const GLfloat*)
+        {
+            uniform("glProgramUniformMatrix4fv", program, location);
+        }
+    };
+
+    RecordingBackend::~RecordingBackend()
+    {
+        if (active == this) {
+            deactivate();
+        }
+    }
+
+    void RecordingBackend::clear()
+    {
+        commands.clear();
+        statistics = {};
+    }
+
+    void RecordingBackend::record(Command::Type type,
+                                  const char* function,
+                                  uint32_t object,
+                                  uint64_t value)
+    {
+        switch (type) {
+            case Command::Type::Draw:
+                statistics.drawCalls++;
+                statistics.indices += value;
+                break;
+            case Command::Type::Clear:
+                statistics.clears++;
+                break;
+            case Command::Type::StateChange:
+                statistics.stateChanges++;
+                break;
+            case Command::Type::BufferUpload:
+                statistics.bufferUploads++;
+                statistics.bufferBytes += value;
+                break;
+            case Command::Type::TextureUpload:
+                statistics.textureUploads++;
+                statistics.textureBytes += value;
+                break;
+            case Command::Type::Uniform:
+                statistics.uniformUploads++;
+                break;
+        }
+
+        if (logCommands) {
+            commands.push_back({ type, function, object, value });
+        }
+    }
+
+    void RecordingBackend::reflect(GLuint program, GLuint shader)
+    {
+        static const std::unordered_map<std::string_view, GLenum> types = {
+            { "float", GL_FLOAT },          { "vec2", GL_FLOAT_VEC2 },
+            { "vec3", GL_FLOAT_VEC3 },      { "vec4", GL_FLOAT_VEC4 },
+            { "mat3", GL_FLOAT_MAT3 },      { "mat4", GL_FLOAT_MAT4 },
+            { "int", GL_INT },              { "uint", GL_UNSIGNED_INT },
+            { "bool", GL_BOOL },            { "sampler2D", GL_SAMPLER_2D },
+            { "samplerCube", GL_SAMPLER_CUBE },
+        };
+
+        Program& state = programs[program];
+        std::istringstream source(shaderSources[shader]);
+        std::string line;
+        while (std::getline(source, line)) {
+            line = line.substr(0, line.find("//"));
+
+            // Declarations look like "uniform <type> <name>[size] = ...;"
+            std::istringstream words(line);
+            std::string word;
+            while (words >> word && word != "uniform") {}
+            std::string type, name;
+            if (!(words >> type >> name)) {
+                continue;
+            }
+
+            auto known = types.find(type);
+            if (known == types.end()) { // Blocks and structs
+                continue;
+            }
+
+            auto end = std::find_if(name.begin(), name.end(), [](char c) {
+                return !std::isalnum((unsigned char)c) && c != '_';
+            });
+            GLint size = 1;
+            if (end != name.end() && *end == '[') {
+                std::from_chars(&*end + 1, name.data() + name.size(), size);
+            }
+            name.erase(end, name.end());
+
+            bool declared = std::any_of(
+              state.uniforms.begin(),
+              state.uniforms.end(),
+              [&](const Uniform& uniform) { return uniform.name == name; });
+            if (name.empty() || declared) {
+                continue;
+            }
+
+            state.uniforms.push_back(
+              { name, known->second, std::max(size, 1), state.nextLocation });
+            state.nextLocation += std::max(size, 1);
+        }
+    }
+
+    void RecordingBackend::activate()
+    {
+        active = this;
+
+// Entry points that are accepted but not recorded
+#define FW_NO_OP(entryPoint)                                                   \
+    install(entryPoint, &NoOp<decltype(entryPoint)>::call)
+
+        // Objects
+        install(glad_glGenBuffers, &Hooks::genNames);
+        install(glad_glCreateBuffers, &Hooks::genNames);
+        install(glad_glGenVertexArrays, &Hooks::genNames);
+        install(glad_glGenTextures, &Hooks::genNames);
+        install(glad_glCreateTextures, &Hooks::createTextures);
+        install(glad_glGenFramebuffers, &Hooks::genNames);
+        install(glad_glCreateProgram, &Hooks::createProgram);
+        install(glad_glCreateShader, &Hooks::createShader);
+        FW_NO_OP(glad_glDeleteBuffers);
+        FW_NO_OP(glad_glDeleteVertexArrays);
+        FW_NO_OP(glad_glDeleteTextures);
+        FW_NO_OP(glad_glDeleteFramebuffers);
+
+        // Shaders
+        install(glad_glShaderSource, &Hooks::shaderSource);
+        install(glad_glAttachShader, &Hooks::attachShader);
+        install(glad_glDeleteShader, &Hooks::deleteShader);
+        install(glad_glDeleteProgram, &Hooks::deleteProgram);
+        install(glad_glGetShaderiv, &Hooks::getShaderiv);
+        install(glad_glGetProgramiv, &Hooks::getProgramiv);
+        install(glad_glGetActiveUniform, &Hooks::getActiveUniform);
+        install(glad_glGetUniformLocation, &Hooks::getUniformLocation);
+        FW_NO_OP(glad_glCompileShader);
+        FW_NO_OP(glad_glLinkProgram);
+        FW_NO_OP(glad_glGetShaderInfoLog);
+        FW_NO_OP(glad_glGetProgramInfoLog);
+        FW_NO_OP(glad_glGetProgramBinary);
+        FW_NO_OP(glad_glProgramBinary);
+        FW_NO_OP(glad_glProgramParameteri);
+
+        // Queries
+        install(glad_glGetIntegerv, &Hooks::getIntegerv);
+        install(glad_glGetString, &Hooks::getString);
+        install(glad_glCheckFramebufferStatus, &Hooks::checkFramebufferStatus);
+        FW_NO_OP(glad_glDebugMessageCallback);
+        FW_NO_OP(glad_glDebugMessageControl);
+
+        // Drawing
+        install(glad_glDrawElements, &Hooks::drawElements);
+        install(glad_glDrawArrays, &Hooks::drawArrays);
+        install(glad_glClear, &Hooks::clear);
+
+        // State
+        install(glad_glUseProgram, &Hooks::useProgram);
+        install(glad_glBindVertexArray, &Hooks::bindVertexArray);
+        install(glad_glActiveTexture, &Hooks::activeTexture);
+        install(glad_glBindTexture, &Hooks::bindTexture);
+        install(glad_glBindBuffer, &Hooks::bindBuffer);
+        install(glad_glBindBufferBase, &Hooks::bindBufferBase);
+        install(glad_glBindFramebuffer, &Hooks::bindFramebuffer);
+        install(glad_glEnable, &Hooks::enable);
+        install(glad_glDisable, &Hooks::disable);
+        install(glad_glBlendFunc, &Hooks::blendFunc);
+        install(glad_glDepthMask, &Hooks::depthMask);
+        install(glad_glDepthFunc, &Hooks::depthFunc);
+        install(glad_glCullFace, &Hooks::cullFace);
+        install(glad_glFrontFace, &Hooks::frontFace);
+        install(glad_glPolygonMode, &Hooks::polygonMode);
+        install(glad_glViewport, &Hooks::viewport);
+        install(glad_glClearColor, &Hooks::clearColor);
+        FW_NO_OP(glad_glEnableVertexAttribArray);
+        FW_NO_OP(glad_glVertexAttribPointer);
+        FW_NO_OP(glad_glPixelStorei);
+        FW_NO_OP(glad_glFramebufferTexture2D);
+
+        // Uploads
+        install(glad_glBufferData, &Hooks::bufferData);
+        install(glad_glBufferSubData, &Hooks::bufferSubData);
+        install(glad_glNamedBufferData, &Hooks::namedBufferData);
+        install(glad_glMapNamedBufferRange, &Hooks::mapNamedBufferRange);
+        install(glad_glUnmapNamedBuffer, &Hooks::unmapNamedBuffer);
+        install(glad_glTexImage2D, &Hooks::texImage2D);
+        install(glad_glTextureSubImage2D, &Hooks::textureSubImage2D);
+        FW_NO_OP(glad_glTexStorage2D);
+        FW_NO_OP(glad_glTextureStorage2D);
+        FW_NO_OP(glad_glTexParameteri);
+        FW_NO_OP(glad_glTextureParameteri);
+        FW_NO_OP(glad_glGenerateMipmap);
+        FW_NO_OP(glad_glGenerateTextureMipmap);
+
+        // Uniforms
+        install(glad_glUniform1i, &Hooks::uniform1i);
+        install(glad_glUniform1f, &Hooks::uniform1f);
+        install(glad_glUniform2f, &Hooks::uniform2f);
+        install(glad_glUniform3f, &Hooks::uniform3f);
+        install(glad_glUniform4f, &Hooks::uniform4f);
+        install(glad_glUniformMatrix4fv, &Hooks::uniformMatrix4fv);
+        install(glad_glProgramUniform1i, &Hooks::programUniform1i);
+        install(glad_glProgramUniform1f, &Hooks::programUniform1f);
+        install(glad_glProgramUniform2f, &Hooks::programUniform2f);
+        install(glad_glProgramUniform3f, &Hooks::programUniform3f);
+        install(glad_glProgramUniform4f, &Hooks::programUniform4f);
+        install(glad_glProgramUniformMatrix4fv,
+                &Hooks::programUniformMatrix4fv);
+
+#undef FW_NO_OP
+    }
+
+    void RecordingBackend::deactivate()
+    {
+        for (auto it = restorers.rbegin(); it != restorers.rend(); ++it) {
+            (*it)();
+        }
+        restorers.clear();
+
+        if (active == this) {
+            active = nullptr;
+        }
+    }
+} // namespace FW
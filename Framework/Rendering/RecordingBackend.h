@@ -0,0 +1,153 @@
+#pragma once
+
+#include "RenderBackend.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/glad.h>
+
+namespace FW {
+    /**
+     * Render backend that records what would have been sent to the GPU.
+     *
+     * @details No OpenGL context is needed, so the CPU side of rendering can
+     * be benchmarked and tested on machines without a GPU. Draw calls, state
+     * changes, buffer and texture uploads and uniform uploads are appended to
+     * a command log. Everything else the Framework calls is accepted and
+     * ignored.
+     *
+     * @details Object names are handed out from a single counter starting at
+     * 1, so the same sequence of calls always produces the same log. Shaders
+     * always compile and link. Their uniforms are read from the `uniform`
+     * declarations in the source, so uniform lookups behave as they would
+     * with a driver, except for members of structs.
+     *
+     * @example
+     * @code
+     * RenderBackend::set(createScope<RecordingBackend>());
+     * renderSystem.draw(scene->getRoot());
+     *
+     * auto& backend = static_cast<RecordingBackend&>(RenderBackend::get());
+     * CHECK(backend.getStatistics().drawCalls == 1);
+     * @endcode
+     */
+    class RecordingBackend : public RenderBackend {
+    public:
+        struct Command {
+            enum class Type : uint8_t {
+                Draw,
+                Clear,
+                StateChange,
+                BufferUpload,
+                TextureUpload,
+                Uniform,
+            };
+
+            Type type;
+            /** Name of the OpenGL function, e.g. "glDrawElements". */
+            const char* function;
+            /** Program, buffer, texture or vertex array. 0 if none. */
+            uint32_t object = 0;
+            /** Indices drawn, bytes uploaded, uniform location or new state. */
+            uint64_t value = 0;
+
+            bool operator==(const Command&) const = default;
+        };
+
+        /** Totals over the recorded commands. */
+        struct Statistics {
+            uint32_t drawCalls = 0;
+            uint64_t indices = 0;
+            uint32_t clears = 0;
+            uint32_t stateChanges = 0;
+            uint32_t bufferUploads = 0;
+            uint64_t bufferBytes = 0;
+            uint32_t textureUploads = 0;
+            uint64_t textureBytes = 0;
+            uint32_t uniformUploads = 0;
+        };
+
+    public:
+        RecordingBackend() = default;
+        ~RecordingBackend() override;
+
+        const char* getName() const override { return "Recording"; }
+
+        const std::vector<Command>& getCommands() const { return commands; }
+        const Statistics& getStatistics() const { return statistics; }
+
+        /** Forget the recorded commands and statistics. */
+        void clear();
+
+        /**
+         * Keep only the statistics. Benchmarks that run many frames should
+         * turn the log off, so it does not grow without bounds.
+         */
+        void setLogCommands(bool enable) { logCommands = enable; }
+
+    protected:
+        void activate() override;
+        void deactivate() override;
+
+    private:
+        /** The replacement entry points. */
+        struct Hooks;
+        friend struct Hooks;
+
+        struct Uniform {
+            std::string name;
+            GLenum type;
+            GLint size;
+            GLint location;
+        };
+
+        struct Program {
+            std::vector<Uniform> uniforms;
+            GLint nextLocation = 0;
+        };
+
+        void record(Command::Type type,
+                    const char* function,
+                    uint32_t object = 0,
+                    uint64_t value = 0);
+
+        /** Add the uniforms declared in `shader`'s source to `program`. */
+        void reflect(GLuint program, GLuint shader);
+
+        /** Point `entryPoint` at `replacement` until deactivate(). */
+        template<typename Function>
+        void install(Function& entryPoint, Function replacement) {
+            Function original = entryPoint;
+            restorers.push_back(
+              [&entryPoint, original] { entryPoint = original; });
+            entryPoint = replacement;
+        }
+
+    private:
+        /** The backend the hooks record into. */
+        static RecordingBackend* active;
+
+        std::vector<Command> commands;
+        Statistics statistics;
+        bool logCommands = true;
+
+        std::vector<std::function<void()>> restorers;
+
+        GLuint nextName = 1;
+        GLuint program = 0;
+        GLuint vertexArray = 0;
+        GLenum activeTexture = GL_TEXTURE0;
+        std::unordered_map<GLenum, GLuint> bufferBindings;
+        /// Keyed by texture unit in the upper and target in the lower half.
+        std::unordered_map<uint64_t, GLuint> textureBindings;
+        std::unordered_map<GLuint, std::string> shaderSources;
+        std::unordered_map<GLuint, Program> programs;
+
+        /// Storage handed out by glMapNamedBufferRange().
+        std::vector<unsigned char> mappedBuffer;
+    };
+} // namespace FW
@@ -0,0 +1,32 @@
+#include "RenderBackend.h"
+#include "RenderState.h"
+#include "Log.h"
+
+namespace FW {
+    RenderBackend* RenderBackend::current = nullptr;
+
+    RenderBackend& RenderBackend::get()
+    {
+        if (!current) {
+            current = new OpenGLBackend();
+        }
+        return *current;
+    }
+
+    void RenderBackend::set(scope<RenderBackend> backend)
+    {
+        if (!backend) {
+            backend = createScope<OpenGLBackend>();
+        }
+
+        if (current) {
+            current->deactivate();
+            delete current;
+        }
+        current = backend.release();
+        current->activate();
+
+        RenderState::get().reset();
+        INFO("Render backend: {}", current->getName());
+    }
+} // namespace FW
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "pch.h"
+
+namespace FW {
+    /**
+     * Where the rendering code's OpenGL calls end up.
+     *
+     * @details All of the Framework calls OpenGL through the entry points
+     * loaded by glad. The \ref OpenGLBackend "OpenGLBackend" leaves them
+     * pointing at the driver. Other backends replace them while they are
+     * current, which covers RenderCommand, RenderState, buffers, shaders and
+     * textures alike without touching their code.
+     *
+     * @details Switching backends forgets the state shadowed by \ref
+     * RenderState "RenderState", since it belonged to the previous backend.
+     * Resources created under one backend must not be used under another.
+     *
+     * @details Like the other GL singletons, the current backend is never
+     * destroyed, as static resources may still release GL objects during
+     * shutdown.
+     */
+    class RenderBackend {
+    public:
+        virtual ~RenderBackend() = default;
+
+        /** Human readable name, for logs. */
+        virtual const char* getName() const = 0;
+
+        /** The current backend. OpenGL unless another one was set. */
+        static RenderBackend& get();
+
+        /** Make `backend` current, and deactivate the previous one. */
+        static void set(scope<RenderBackend> backend);
+
+    protected:
+        /** Called when the backend becomes current. */
+        virtual void activate() {}
+
+        /** Called when another backend replaces this one. */
+        virtual void deactivate() {}
+
+    private:
+        static RenderBackend* current;
+    };
+
+    /** Calls the OpenGL driver. Needs a current context. */
+    class OpenGLBackend : public RenderBackend {
+    public:
+        const char* getName() const override { return "OpenGL"; }
+    };
+} // namespace FW
@@ -4,6 +4,7 @@
 
 // Framework
 #include "RenderCommands.h"
+#include "Camera/Camera.h"
 #include "GeometricTools.h"
 #include "Log.h"
 
@@ -40,10 +41,13 @@ namespace RenderCommand {
         quadContext->vertexBuffer->setLayout(entityAttribLayout);
         quadContext->vertexArray->setIndexBuffer(quadContext->indexBuffer);
         quadContext->vertexArray->addVertexBuffer(quadContext->vertexBuffer);
+
+        FW::Camera::createUniformBuffer();
     }
 
     void destroy()
     {
+        FW::Camera::destroyUniformBuffer();
         quadContext = nullptr;
     }
 
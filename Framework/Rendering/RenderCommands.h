@@ -4,6 +4,8 @@
 
 // Framework
 #include "Buffer.h"
+#include "RenderBackend.h"
+#include "RenderState.h"
 
 namespace RenderCommand {
     /**
@@ -40,6 +42,21 @@ namespace RenderCommand {
      */
     void init();
 
+    /**
+     * Choose where OpenGL calls go, such as the \ref FW::RecordingBackend
+     * "RecordingBackend" for running without a GPU. Call before creating any
+     * GL resources, including init().
+     */
+    inline void setBackend(FW::scope<FW::RenderBackend> backend)
+    {
+        FW::RenderBackend::set(std::move(backend));
+    }
+
+    inline FW::RenderBackend& getBackend()
+    {
+        return FW::RenderBackend::get();
+    }
+
     /**
      * This must be called <u>once</u> only during the application's lifetime.
      * @details It is recommended to call this function after the game loop has
@@ -101,11 +118,9 @@ namespace RenderCommand {
      */
     inline void setDepthMask(GLboolean flag)
     {
-        glDepthMask(flag);
+        FW::RenderState::get().setDepthMask(flag == GL_TRUE);
     }
 
-    static GLenum currentlyUsedDepthFunc = GL_LESS;
-
     /**
      * Get the current depth testing function.
      *
@@ -124,7 +139,7 @@ namespace RenderCommand {
      */
     inline GLenum getCurrentDepthFunc()
     {
-        return currentlyUsedDepthFunc;
+        return FW::RenderState::get().getDepthFunc();
     }
 
     /**
@@ -144,6 +159,6 @@ namespace RenderCommand {
      */
     inline void setCurrentDepthFunc(GLenum func)
     {
-        currentlyUsedDepthFunc = func;
+        FW::RenderState::get().setDepthFunc(func);
     }
 }
@@ -0,0 +1,123 @@
+#include "RenderState.h"
+
+namespace FW {
+    void RenderState::reset() {
+        program = 0;
+        vertexArray = 0;
+        activeTextureUnit = 0;
+        textures.fill({});
+
+        blend = false;
+        blendSource = GL_ONE;
+        blendDestination = GL_ZERO;
+        depthTest = false;
+        depthMask = true;
+        depthFunc = GL_LESS;
+        cullFace = false;
+        cullMode = GL_BACK;
+        frontFace = GL_CCW;
+    }
+
+    void RenderState::useProgram(GLuint program) {
+        if (change(this->program, program)) {
+            glUseProgram(program);
+        }
+    }
+
+    void RenderState::bindVertexArray(GLuint vertexArray) {
+        if (change(this->vertexArray, vertexArray)) {
+            glBindVertexArray(vertexArray);
+        }
+    }
+
+    void RenderState::bindTexture(GLenum target,
+                                  GLuint texture,
+                                  uint32_t unit) {
+        if (unit >= maxTextureUnits) {
+            glActiveTexture(GL_TEXTURE0 + unit);
+            glBindTexture(target, texture);
+            activeTextureUnit = unit;
+            statistics.issued++;
+            return;
+        }
+
+        if (!change(textures[unit], TextureBinding{ target, texture })) {
+            return;
+        }
+
+        if (activeTextureUnit != unit) {
+            glActiveTexture(GL_TEXTURE0 + unit);
+            activeTextureUnit = unit;
+        }
+        glBindTexture(target, texture);
+    }
+
+    void RenderState::forgetTexture(GLuint texture) {
+        for (auto& binding : textures) {
+            if (binding.texture == texture) {
+                binding.texture = 0;
+            }
+        }
+    }
+
+    void RenderState::setBlend(bool enable) {
+        setCapability(GL_BLEND, blend, enable);
+    }
+
+    void RenderState::setBlendFunc(GLenum source, GLenum destination) {
+        if (blendSource == source && blendDestination == destination) {
+            statistics.skipped++;
+            return;
+        }
+        blendSource = source;
+        blendDestination = destination;
+        statistics.issued++;
+        glBlendFunc(source, destination);
+    }
+
+    void RenderState::setDepthTest(bool enable) {
+        setCapability(GL_DEPTH_TEST, depthTest, enable);
+    }
+
+    void RenderState::setDepthMask(bool enable) {
+        if (change(depthMask, enable)) {
+            glDepthMask(enable ? GL_TRUE : GL_FALSE);
+        }
+    }
+
+    void RenderState::setDepthFunc(GLenum func) {
+        if (change(depthFunc, func)) {
+            glDepthFunc(func);
+        }
+    }
+
+    void RenderState::setCullFace(bool enable) {
+        setCapability(GL_CULL_FACE, cullFace, enable);
+    }
+
+    void RenderState::setCullMode(GLenum face) {
+        if (change(cullMode, face)) {
+            glCullFace(face);
+        }
+    }
+
+    void RenderState::setFrontFace(GLenum mode) {
+        if (change(frontFace, mode)) {
+            glFrontFace(mode);
+        }
+    }
+
+    void RenderState::setCapability(GLenum capability,
+                                     bool& current,
+                                     bool enable) {
+        if (!change(current, enable)) {
+            return;
+        }
+
+        if (enable) {
+            glEnable(capability);
+        } else {
+            glDisable(capability);
+        }
+    }
+} // namespace FW
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "pch.h"
+
+#include <array>
+#include <cstdint>
+
+#include <glad/glad.h>
+
+namespace FW {
+    /**
+     * Shadow copy of the OpenGL state that changes between draw calls.
+     *
+     * Every setter compares the request with the state it last set and only
+     * calls OpenGL if they differ. This only holds as long as all code binds
+     * through the tracker, so code that changes the state behind its back
+     * must call reset() afterwards.
+     *
+     * Like the other GL singletons, the instance is never destroyed, as
+     * resources held by static objects may still release their bindings
+     * during shutdown.
+     */
+    class RenderState {
+    public:
+        /** Issued and skipped state changes since resetStatistics(). */
+        struct Statistics {
+            uint32_t issued = 0;
+            uint32_t skipped = 0;
+        };
+
+        /** Highest texture unit that is tracked. Higher ones always bind. */
+        static constexpr uint32_t maxTextureUnits = 32;
+
+        static RenderState& get() {
+            static RenderState* s = new RenderState();
+            return *s;
+        }
+
+        RenderState(const RenderState&) = delete;
+        RenderState& operator=(const RenderState&) = delete;
+
+        /**
+         * Forget the shadowed state and assume the defaults of a new OpenGL
+         * context.
+         */
+        void reset();
+
+        void useProgram(GLuint program);
+        void bindVertexArray(GLuint vertexArray);
+        void bindTexture(GLenum target, GLuint texture, uint32_t unit);
+
+        /** Forget any unit `texture` is bound to, as OpenGL does on delete. */
+        void forgetTexture(GLuint texture);
+
+        void setBlend(bool enable);
+        void setBlendFunc(GLenum source, GLenum destination);
+        void setDepthTest(bool enable);
+        void setDepthMask(bool enable);
+        void setDepthFunc(GLenum func);
+        void setCullFace(bool enable);
+        void setCullMode(GLenum face);
+        void setFrontFace(GLenum mode);
+
+        GLuint getProgram() const { return program; }
+        GLuint getVertexArray() const { return vertexArray; }
+        GLenum getDepthFunc() const { return depthFunc; }
+
+        const Statistics& getStatistics() const { return statistics; }
+        void resetStatistics() { statistics = {}; }
+
+    private:
+        RenderState() = default;
+        ~RenderState() = default;
+
+        /**
+         * Returns true and counts an issued change if `current` differs from
+         * `value`, in which case `current` is updated.
+         */
+        template<typename T>
+        bool change(T& current, T value) {
+            if (current == value) {
+                statistics.skipped++;
+                return false;
+            }
+            current = value;
+            statistics.issued++;
+            return true;
+        }
+
+        void setCapability(GLenum capability, bool& current, bool enable);
+
+    private:
+        struct TextureBinding {
+            GLenum target = GL_TEXTURE_2D;
+            GLuint texture = 0;
+
+            bool operator==(const TextureBinding&) const = default;
+        };
+
+        GLuint program = 0;
+        GLuint vertexArray = 0;
+        uint32_t activeTextureUnit = 0;
+        std::array<TextureBinding, maxTextureUnits> textures{};
+
+        bool blend = false;
+        GLenum blendSource = GL_ONE;
+        GLenum blendDestination = GL_ZERO;
+        bool depthTest = false;
+        bool depthMask = true;
+        GLenum depthFunc = GL_LESS;
+        bool cullFace = false;
+        GLenum cullMode = GL_BACK;
+        GLenum frontFace = GL_CCW;
+
+        Statistics statistics;
+    };
+} // namespace FW
@@ -10,6 +10,7 @@
 
 // Framework
 #include "Shader.h"
+#include "RenderState.h"
 #include "assertions.h"
 #include "Log.h"
 
@@ -21,28 +22,51 @@ static void outputShaderLocationLog(const int location, const std::string& name)
 
 namespace FW {
     Shader::Shader(const std::string& vertexSrc, const std::string& fragmentSrc)
+      : Shader(linkProgram(readFile(vertexSrc), readFile(fragmentSrc)))
     {
-        vertexShader = compileShader(GL_VERTEX_SHADER, readFile(vertexSrc));
-        fragmentShader =
-          compileShader(GL_FRAGMENT_SHADER, readFile(fragmentSrc));
+    }
+
+    Shader::Shader(GLuint program)
+      : shaderProgram(program)
+    {
+        if (shaderProgram) {
+            reflectUniforms();
+        }
+    }
+
+    GLuint Shader::linkProgram(const std::string& vertexSource,
+                               const std::string& fragmentSource,
+                               bool retrievable)
+    {
+        GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
+        GLuint fragmentShader =
+          compileShader(GL_FRAGMENT_SHADER, fragmentSource);
+
+        GLuint program = glCreateProgram();
+        if (retrievable) {
+            glProgramParameteri(
+              program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+        glAttachShader(program, vertexShader);
+        glAttachShader(program, fragmentShader);
+        glLinkProgram(program);
 
-        shaderProgram = glCreateProgram();
-        glAttachShader(shaderProgram, vertexShader);
-        glAttachShader(shaderProgram, fragmentShader);
-        glLinkProgram(shaderProgram);
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
 
         // Output shader program error log
         int success;
         char infoLog[512];
 
-        glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-        if (success) { // Successfully compiled and link shader program
-            glDeleteShader(vertexShader);
-            glDeleteShader(fragmentShader);
-        } else { // Failed to compile and link shader program
-            glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (!success) { // Failed to compile and link shader program
+            glGetProgramInfoLog(program, 512, NULL, infoLog);
+            glDeleteProgram(program);
             FATAL("ERROR::SHADER::PROGRAM::LINKING_FAILED {}", infoLog);
+            return 0;
         }
+
+        return program;
     }
 
     Shader::~Shader()
@@ -54,12 +78,178 @@ namespace FW {
 
     void Shader::bind() const
     {
-        glUseProgram(shaderProgram);
+        RenderState::get().useProgram(shaderProgram);
     }
 
     void Shader::unbind() const
     {
-        glUseProgram(0);
+        RenderState::get().useProgram(0);
+    }
+
+    void Shader::reflectUniforms()
+    {
+        uniforms.clear();
+
+        GLint count = 0;
+        GLint maxNameLength = 0;
+        glGetProgramiv(shaderProgram, GL_ACTIVE_UNIFORMS, &count);
+        glGetProgramiv(
+          shaderProgram, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+        std::string name(maxNameLength, '\0');
+        for (GLint i = 0; i < count; i++) {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(shaderProgram,
+                               i,
+                               maxNameLength,
+                               &length,
+                               &size,
+                               &type,
+                               name.data());
+
+            std::string uniformName(name.data(), length);
+            GLint location =
+              glGetUniformLocation(shaderProgram, uniformName.c_str());
+            if (location < 0) { // Uniform block member
+                continue;
+            }
+
+            // Arrays are reported once as "name[0]". Register every element
+            // so they can be looked up by index as well.
+            if (uniformName.ends_with("[0]")) {
+                std::string base =
+                  uniformName.substr(0, uniformName.size() - 3);
+                uniforms[base] = { location, type };
+
+                for (GLint element = 1; element < size; element++) {
+                    std::string elementName =
+                      base + "[" + std::to_string(element) + "]";
+                    uniforms[elementName] = {
+                        glGetUniformLocation(shaderProgram,
+                                             elementName.c_str()),
+                        type
+                    };
+                }
+            }
+
+            uniforms[std::move(uniformName)] = { location, type };
+        }
+    }
+
+    GLint Shader::getUniformLocation(std::string_view name) const
+    {
+        auto it = uniforms.find(name);
+        GLint location = it != uniforms.end() ? it->second.location : -1;
+        OUTPUT_SHADER_LOCATION_LOG(location, std::string(name));
+        return location;
+    }
+
+    /** True for uniform types that are set with glUniform1i(). */
+    static bool isIntegerUniform(GLenum type)
+    {
+        switch (type) {
+            case GL_INT:
+            case GL_BOOL:
+            case GL_SAMPLER_1D:
+            case GL_SAMPLER_2D:
+            case GL_SAMPLER_3D:
+            case GL_SAMPLER_CUBE:
+            case GL_SAMPLER_1D_SHADOW:
+            case GL_SAMPLER_2D_SHADOW:
+            case GL_SAMPLER_1D_ARRAY:
+            case GL_SAMPLER_2D_ARRAY:
+            case GL_SAMPLER_1D_ARRAY_SHADOW:
+            case GL_SAMPLER_2D_ARRAY_SHADOW:
+            case GL_SAMPLER_2D_MULTISAMPLE:
+            case GL_SAMPLER_2D_MULTISAMPLE_ARRAY:
+            case GL_SAMPLER_CUBE_SHADOW:
+            case GL_SAMPLER_BUFFER:
+            case GL_SAMPLER_2D_RECT:
+            case GL_SAMPLER_2D_RECT_SHADOW:
+            case GL_SAMPLER_CUBE_MAP_ARRAY:
+            case GL_SAMPLER_CUBE_MAP_ARRAY_SHADOW:
+            case GL_INT_SAMPLER_1D:
+            case GL_INT_SAMPLER_2D:
+            case GL_INT_SAMPLER_3D:
+            case GL_INT_SAMPLER_CUBE:
+            case GL_INT_SAMPLER_1D_ARRAY:
+            case GL_INT_SAMPLER_2D_ARRAY:
+            case GL_INT_SAMPLER_2D_MULTISAMPLE:
+            case GL_INT_SAMPLER_2D_MULTISAMPLE_ARRAY:
+            case GL_INT_SAMPLER_BUFFER:
+            case GL_INT_SAMPLER_2D_RECT:
+            case GL_INT_SAMPLER_CUBE_MAP_ARRAY:
+            case GL_UNSIGNED_INT_SAMPLER_1D:
+            case GL_UNSIGNED_INT_SAMPLER_2D:
+            case GL_UNSIGNED_INT_SAMPLER_3D:
+            case GL_UNSIGNED_INT_SAMPLER_CUBE:
+            case GL_UNSIGNED_INT_SAMPLER_1D_ARRAY:
+            case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY:
+            case GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE:
+            case GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE_ARRAY:
+            case GL_UNSIGNED_INT_SAMPLER_BUFFER:
+            case GL_UNSIGNED_INT_SAMPLER_2D_RECT:
+            case GL_UNSIGNED_INT_SAMPLER_CUBE_MAP_ARRAY:
+            case GL_IMAGE_1D:
+            case GL_IMAGE_2D:
+            case GL_IMAGE_3D:
+            case GL_IMAGE_2D_RECT:
+            case GL_IMAGE_CUBE:
+            case GL_IMAGE_BUFFER:
+            case GL_IMAGE_1D_ARRAY:
+            case GL_IMAGE_2D_ARRAY:
+            case GL_IMAGE_CUBE_MAP_ARRAY:
+            case GL_IMAGE_2D_MULTISAMPLE:
+            case GL_IMAGE_2D_MULTISAMPLE_ARRAY:
+            case GL_INT_IMAGE_1D:
+            case GL_INT_IMAGE_2D:
+            case GL_INT_IMAGE_3D:
+            case GL_INT_IMAGE_2D_RECT:
+            case GL_INT_IMAGE_CUBE:
+            case GL_INT_IMAGE_BUFFER:
+            case GL_INT_IMAGE_1D_ARRAY:
+            case GL_INT_IMAGE_2D_ARRAY:
+            case GL_INT_IMAGE_CUBE_MAP_ARRAY:
+            case GL_INT_IMAGE_2D_MULTISAMPLE:
+            case GL_INT_IMAGE_2D_MULTISAMPLE_ARRAY:
+            case GL_UNSIGNED_INT_IMAGE_1D:
+            case GL_UNSIGNED_INT_IMAGE_2D:
+            case GL_UNSIGNED_INT_IMAGE_3D:
+            case GL_UNSIGNED_INT_IMAGE_2D_RECT:
+            case GL_UNSIGNED_INT_IMAGE_CUBE:
+            case GL_UNSIGNED_INT_IMAGE_BUFFER:
+            case GL_UNSIGNED_INT_IMAGE_1D_ARRAY:
+            case GL_UNSIGNED_INT_IMAGE_2D_ARRAY:
+            case GL_UNSIGNED_INT_IMAGE_CUBE_MAP_ARRAY:
+            case GL_UNSIGNED_INT_IMAGE_2D_MULTISAMPLE:
+            case GL_UNSIGNED_INT_IMAGE_2D_MULTISAMPLE_ARRAY:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    GLint Shader::findUniform(std::string_view name, GLenum type) const
+    {
+        auto it = uniforms.find(name);
+        if (it == uniforms.end()) {
+            OUTPUT_SHADER_LOCATION_LOG(-1, std::string(name));
+            return -1;
+        }
+
+        // Booleans, samplers and images are uploaded as integers. Any other
+        // type must match exactly.
+        const bool matches =
+          it->second.type == type ||
+          (type == GL_INT && isIntegerUniform(it->second.type));
+        if (!matches) {
+            WARN("Uniform {} does not have the requested type", name);
+            return -1;
+        }
+
+        return it->second.location;
     }
 
     GLuint Shader::compileShader(GLenum shaderType,
@@ -122,97 +312,112 @@ namespace FW {
 
     void Shader::setInt(const std::string& name, const int value) const
     {
-        int location = glGetUniformLocation(shaderProgram, name.c_str());
-        OUTPUT_SHADER_LOCATION_LOG(location, name);
+        GLint location = getUniformLocation(name);
         glUniform1i(location, value);
     }
 
     void Shader::setFloat(const std::string& name, const float value) const
     {
-        int location = glGetUniformLocation(shaderProgram, name.c_str());
-        OUTPUT_SHADER_LOCATION_LOG(location, name);
+        GLint location = getUniformLocation(name);
         glUniform1f(location, value);
     }
 
     void Shader::setFloat2(const std::string& name,
                            const glm::vec2& vector) const
     {
-        int location = glGetUniformLocation(shaderProgram, name.c_str());
-        OUTPUT_SHADER_LOCATION_LOG(location, name);
+        GLint location = getUniformLocation(name);
         glUniform2f(location, vector.x, vector.y);
     }
 
     void Shader::setFloat3(const std::string& name,
                            const glm::vec3& vector) const
     {
-        int location = glGetUniformLocation(shaderProgram, name.c_str());
-        OUTPUT_SHADER_LOCATION_LOG(location, name);
+        GLint location = getUniformLocation(name);
         glUniform3f(location, vector.x, vector.y, vector.z);
     }
 
     void Shader::setFloat4(const std::string& name,
                            const glm::vec4& vector) const {
-        int location = glGetUniformLocation(shaderProgram, name.c_str());
-        OUTPUT_SHADER_LOCATION_LOG(location, name);
+        GLint location = getUniformLocation(name);
         glUniform4f(location, vector.x, vector.y, vector.z, vector.w);
     }
 
     void Shader::setMat4(const std::string& name,
                          const glm::mat4& matrix) const {
-        int location = glGetUniformLocation(shaderProgram, name.c_str());
-        OUTPUT_SHADER_LOCATION_LOG(location, name);
+        GLint location = getUniformLocation(name);
         glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
     }
 
     void Shader::setParam(const std::string& name, const int value) const {
-        bind();
-        int location = glGetUniformLocation(shaderProgram, name.c_str());
-        OUTPUT_SHADER_LOCATION_LOG(location, name);
-        glUniform1i(location, value);
+        setParam(UniformHandle<int>{ getUniformLocation(name) }, value);
     }
 
     void Shader::setParam(const std::string& name, const float value) const {
-        bind();
-        int location = glGetUniformLocation(shaderProgram, name.c_str());
-        OUTPUT_SHADER_LOCATION_LOG(location, name);
-        glUniform1f(location, value);
+        setParam(UniformHandle<float>{ getUniformLocation(name) }, value);
     }
 
     void Shader::setParam(const std::string& name,
                           const glm::vec2& vector) const {
-        bind();
-        int location = glGetUniformLocation(shaderProgram, name.c_str());
-        OUTPUT_SHADER_LOCATION_LOG(location, name);
-        glUniform2f(location, vector.x, vector.y);
+        setParam(UniformHandle<glm::vec2>{ getUniformLocation(name) }, vector);
     }
 
     void Shader::setParam(const std::string& name,
                           const glm::vec3& vector) const {
-        bind();
-        int location = glGetUniformLocation(shaderProgram, name.c_str());
-        OUTPUT_SHADER_LOCATION_LOG(location, name);
-        glUniform3f(location, vector.x, vector.y, vector.z);
+        setParam(UniformHandle<glm::vec3>{ getUniformLocation(name) }, vector);
     }
 
     void Shader::setParam(const std::string& name,
                           const glm::vec4& vector) const {
-        bind();
-        int location = glGetUniformLocation(shaderProgram, name.c_str());
-        OUTPUT_SHADER_LOCATION_LOG(location, name);
-        glUniform4f(location, vector.x, vector.y, vector.z, vector.w);
+        setParam(UniformHandle<glm::vec4>{ getUniformLocation(name) }, vector);
     }
 
     void Shader::setParam(const std::string& name,
                           const glm::mat4& matrix) const {
-        bind();
-        int location = glGetUniformLocation(shaderProgram, name.c_str());
-        OUTPUT_SHADER_LOCATION_LOG(location, name);
-        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+        setParam(UniformHandle<glm::mat4>{ getUniformLocation(name) }, matrix);
+    }
+
+    void Shader::setParam(UniformHandle<int> handle, const int value) const {
+        glProgramUniform1i(shaderProgram, handle.location, value);
+    }
+
+    void Shader::setParam(UniformHandle<float> handle,
+                          const float value) const {
+        glProgramUniform1f(shaderProgram, handle.location, value);
+    }
+
+    void Shader::setParam(UniformHandle<glm::vec2> handle,
+                          const glm::vec2& vector) const {
+        glProgramUniform2f(shaderProgram, handle.location, vector.x, vector.y);
+    }
+
+    void Shader::setParam(UniformHandle<glm::vec3> handle,
+                          const glm::vec3& vector) const {
+        glProgramUniform3f(
+          shaderProgram, handle.location, vector.x, vector.y, vector.z);
+    }
+
+    void Shader::setParam(UniformHandle<glm::vec4> handle,
+                          const glm::vec4& vector) const {
+        glProgramUniform4f(shaderProgram,
+                           handle.location,
+                           vector.x,
+                           vector.y,
+                           vector.z,
+                           vector.w);
+    }
+
+    void Shader::setParam(UniformHandle<glm::mat4> handle,
+                          const glm::mat4& matrix) const {
+        glProgramUniformMatrix4fv(shaderProgram,
+                                  handle.location,
+                                  1,
+                                  GL_FALSE,
+                                  glm::value_ptr(matrix));
     }
 
     void Shader::setVisualizeMode(RenderCommand::VisualizeMode mode) const
     {
-        int location = glGetUniformLocation(shaderProgram, "u_visualizeMode");
+        GLint location = getUniformLocation("u_visualizeMode");
         glUniform1i(location, (int)mode);
     }
 } // namespace Framework
@@ -2,6 +2,8 @@
 
 #include "pch.h"
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <variant>
 #include <glm/glm.hpp>
 #include <glad/glad.h>
@@ -21,6 +23,21 @@ namespace FW {
     using UniformType =
       std::variant<int, float, glm::vec2, glm::vec3, glm::vec4, glm::mat4>;
 
+    /**
+     * Resolved location of a uniform of type `T`.
+     *
+     * Get one with Shader::getUniform() once, then pass it to
+     * Shader::setParam() every frame instead of the uniform's name. A handle
+     * is only meaningful for the shader that created it, and stays invalid if
+     * the uniform does not exist or is of a different type.
+     */
+    template<typename T>
+    struct UniformHandle {
+        GLint location = -1;
+
+        bool isValid() const { return location >= 0; }
+    };
+
     /**
      * Shader class for OpenGL.
      *
@@ -48,6 +65,13 @@ namespace FW {
          * @example vertexSrc = R"(#version core 330 int main(){})"
          */
         Shader(const std::string& vertexSrc, const std::string& fragmentSrc);
+
+        /**
+         * Take ownership of an already linked program, such as one created
+         * with linkProgram() or restored from a program binary.
+         */
+        explicit Shader(GLuint program);
+
         virtual ~Shader();
         Shader() = default;
 
@@ -57,6 +81,7 @@ namespace FW {
         /** Copy constructor */
         Shader(Shader&& other) noexcept {
             shaderProgram = other.shaderProgram;
+            uniforms = std::move(other.uniforms);
             other.shaderProgram = 0;
         }
 
@@ -68,6 +93,7 @@ namespace FW {
                     glDeleteProgram(shaderProgram);
                 }
                 shaderProgram = other.shaderProgram; // take ownership
+                uniforms = std::move(other.uniforms);
                 other.shaderProgram = 0;             // leave other safe
             }
             return *this;
@@ -104,6 +130,38 @@ namespace FW {
 
         void setParam(const std::string& name, const glm::mat4& matrix) const;
 
+        void setParam(UniformHandle<int> handle, const int value) const;
+        void setParam(UniformHandle<float> handle, const float value) const;
+        void setParam(UniformHandle<glm::vec2> handle,
+                      const glm::vec2& vector) const;
+        void setParam(UniformHandle<glm::vec3> handle,
+                      const glm::vec3& vector) const;
+        void setParam(UniformHandle<glm::vec4> handle,
+                      const glm::vec4& vector) const;
+        void setParam(UniformHandle<glm::mat4> handle,
+                      const glm::mat4& matrix) const;
+
+        /**
+         * Resolve a uniform once so it can be set without a name lookup.
+         *
+         * @tparam T One of the types in UniformType. Samplers and booleans
+         * are resolved as `int`.
+         * @return An invalid handle if the uniform is not active in the
+         * program or its type does not match `T`.
+         */
+        template<typename T>
+        UniformHandle<T> getUniform(std::string_view name) const {
+            return { findUniform(name, uniformGLType<T>()) };
+        }
+
+        /**
+         * Get the location of an active uniform, or -1 if there is none.
+         *
+         * Locations are reflected once when the program is linked, so this
+         * is a hash lookup and does not query the driver.
+         */
+        GLint getUniformLocation(std::string_view name) const;
+
         /**
          * Shorthand to create a shared pointer to a Shader object.
          * @param vertexSrc Vertex source code.
@@ -125,19 +183,70 @@ namespace FW {
          */
         void setVisualizeMode(RenderCommand::VisualizeMode mode) const;
 
-    private:
-        /** Compile a shader */
-        GLuint compileShader(GLenum shaderType, const std::string& shaderSrc);
+        /**
+         * Compile and link a program from GLSL source code.
+         *
+         * @param retrievable Hint to the driver that the program's binary
+         * will be read back with glGetProgramBinary().
+         * @return The program, or 0 if it failed to compile or link.
+         */
+        static GLuint linkProgram(const std::string& vertexSource,
+                                  const std::string& fragmentSource,
+                                  bool retrievable = false);
 
         /** Read shader source code from file on disk */
-        std::string readFile(const std::string& filepath);
+        static std::string readFile(const std::string& filepath);
 
     private:
-        /** Vertex shader ID */
-        GLuint vertexShader = 0;
+        /** Record the location and type of every active uniform. */
+        void reflectUniforms();
+
+        GLint findUniform(std::string_view name, GLenum type) const;
+
+        template<typename T>
+        static constexpr GLenum uniformGLType() {
+            if constexpr (std::is_same_v<T, int>) {
+                return GL_INT;
+            } else if constexpr (std::is_same_v<T, float>) {
+                return GL_FLOAT;
+            } else if constexpr (std::is_same_v<T, glm::vec2>) {
+                return GL_FLOAT_VEC2;
+            } else if constexpr (std::is_same_v<T, glm::vec3>) {
+                return GL_FLOAT_VEC3;
+            } else if constexpr (std::is_same_v<T, glm::vec4>) {
+                return GL_FLOAT_VEC4;
+            } else {
+                static_assert(std::is_same_v<T, glm::mat4>,
+                              "Unsupported uniform type");
+                return GL_FLOAT_MAT4;
+            }
+        }
+
+        /** Compile a shader */
+        static GLuint compileShader(GLenum shaderType,
+                                    const std::string& shaderSrc);
+
+    private:
+        struct UniformInfo {
+            GLint location;
+            GLenum type;
+        };
+
+        /** Hash that lets `uniforms` be searched with a string_view. */
+        struct UniformNameHash {
+            using is_transparent = void;
+            std::size_t operator()(std::string_view name) const {
+                return std::hash<std::string_view>{}(name);
+            }
+        };
 
-        /** Fragment shader ID */
-        GLuint fragmentShader = 0;
+        /**
+         * Active uniforms by name. Array elements are stored both as
+         * `name[i]` and, for the first element, as `name`.
+         */
+        std::unordered_map<std::string, UniformInfo, UniformNameHash,
+                           std::equal_to<>>
+          uniforms;
 
     public:
         /** Shader program ID */
@@ -27,6 +27,18 @@ namespace FW {
         vertexBuffer->setLayout(entityAttribLayout);
         vertexArray->setIndexBuffer(indexBuffer);
         vertexArray->addVertexBuffer(vertexBuffer);
+
+        // Positions are the first three floats of each vertex
+        const std::size_t stride = entityAttribLayout.getStride() / sizeof(float);
+        if (vertices.size() >= 3) {
+            localBounds.min = { vertices[0], vertices[1], vertices[2] };
+            localBounds.max = localBounds.min;
+        }
+        for (std::size_t i = 0; i + 2 < vertices.size(); i += stride) {
+            glm::vec3 position{ vertices[i], vertices[i + 1], vertices[i + 2] };
+            localBounds.min = glm::min(localBounds.min, position);
+            localBounds.max = glm::max(localBounds.max, position);
+        }
     }
 
     void PrimitiveCube::init() {
@@ -4,6 +4,8 @@
 
 #include <glad/glad.h>
 
+#include "Frustum.h"
+
 namespace FW {
     class VertexArray;
     class VertexBuffer;
@@ -31,6 +33,9 @@ namespace FW {
         ref<VertexBuffer> getVertexBuffer() const { return vertexBuffer; }
         ref<IndexBuffer> getIndexBuffer() const { return indexBuffer; }
 
+        /** Box around the vertices, in model space. */
+        const AABB& getLocalBounds() const { return localBounds; }
+
     protected:
         /**
          * Once a child class is instantiated and has filled the vertices and
@@ -56,6 +61,9 @@ namespace FW {
 
         std::vector<float> vertices;
         std::vector<uint32_t> indices;
+
+        /** Computed by createBuffers(). */
+        AABB localBounds;
     };
 
     class PrimitiveQuad : public Shape {
@@ -0,0 +1,132 @@
+#include "SpriteBatch.h"
+
+#include "GeometricTools.h"
+#include "RenderCommands.h"
+#include "TextureManager.h"
+
+namespace FW {
+    SpriteBatch::SpriteBatch(uint32_t maxQuads)
+      : maxQuads(maxQuads) {
+        vertices.reserve(maxQuads * 4);
+
+        // Take corners and UVs from the sprite quad, so both paths match.
+        // Each vertex has 12 floats: position, colour, UV and normal.
+        const auto& sprite = UnitSpriteVertices;
+        for (int i = 0; i < 4; i++) {
+            const float* v = &sprite[i * 12];
+            quadPositions[i] = glm::vec4{ v[0], v[1], v[2], 1.0f };
+            quadTexCoords[i] = glm::vec2{ v[7], v[8] };
+        }
+
+        std::vector<uint32_t> indices(maxQuads * 6);
+        for (uint32_t quad = 0; quad < maxQuads; quad++) {
+            for (int i = 0; i < 6; i++) {
+                indices[quad * 6 + i] = quad * 4 + UnitGridIndices2D[i];
+            }
+        }
+
+        vertexArray = createRef<VertexArray>();
+        vertexArray->bind();
+
+        vertexBuffer = createRef<VertexBuffer>(
+          nullptr, maxQuads * 4 * sizeof(Vertex), GL_DYNAMIC_DRAW);
+        vertexBuffer->setLayout({
+          { ShaderDataType::Float3, "a_position" },
+          { ShaderDataType::Float4, "a_color" },
+          { ShaderDataType::Float2, "a_texCoord" },
+          { ShaderDataType::Float, "a_texIndex" },
+        });
+
+        indexBuffer = createRef<IndexBuffer>(indices.data(), indices.size());
+
+        vertexArray->setIndexBuffer(indexBuffer);
+        vertexArray->addVertexBuffer(vertexBuffer);
+        vertexArray->unbind();
+
+        GLint units = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &units);
+        availableTextureSlots =
+          std::min<uint32_t>(maxTextureSlots, std::max(units, 1));
+    }
+
+    void SpriteBatch::begin(const Shader* shader) {
+        this->shader = shader;
+        quadCount = 0;
+        textureSlotCount = 0;
+        vertices.clear();
+    }
+
+    void SpriteBatch::submit(const glm::mat4& model,
+                             const glm::vec4& color,
+                             uint32_t textureID,
+                             const glm::vec4& uvRect) {
+        if (quadCount == maxQuads) {
+            flush();
+        }
+
+        uint32_t slot = 0;
+        while (slot < textureSlotCount && textureSlots[slot] != textureID) {
+            slot++;
+        }
+        if (slot == textureSlotCount) {
+            if (textureSlotCount == availableTextureSlots) {
+                flush();
+                slot = 0;
+            }
+            textureSlots[slot] = textureID;
+            textureSlotCount = slot + 1;
+        }
+
+        for (int i = 0; i < 4; i++) {
+            glm::vec2 texCoord = glm::mix(glm::vec2(uvRect.x, uvRect.y),
+                                          glm::vec2(uvRect.z, uvRect.w),
+                                          quadTexCoords[i]);
+            vertices.push_back(Vertex{ glm::vec3(model * quadPositions[i]),
+                                       color,
+                                       texCoord,
+                                       static_cast<float>(slot) });
+        }
+        quadCount++;
+    }
+
+    void SpriteBatch::end() {
+        flush();
+        shader = nullptr;
+    }
+
+    void SpriteBatch::flush() {
+        if (quadCount == 0 || !shader) {
+            return;
+        }
+
+        vertexBuffer->bufferSubData(
+          0, vertices.size() * sizeof(Vertex), vertices.data());
+
+        shader->bind();
+
+        // Samplers are program state, so they only need to be assigned once
+        // per shader.
+        if (samplerShader != shader) {
+            for (int slot = 0; slot < (int)maxTextureSlots; slot++) {
+                shader->setParam(
+                  "u_textures[" + std::to_string(slot) + "]", slot);
+            }
+            samplerShader = shader;
+        }
+
+        for (uint32_t slot = 0; slot < textureSlotCount; slot++) {
+            TextureManager::bind(textureSlots[slot], slot);
+        }
+
+        vertexArray->bind();
+        glDrawElements(
+          GL_TRIANGLES, (GLsizei)(quadCount * 6), GL_UNSIGNED_INT, nullptr);
+
+        statistics.drawCalls++;
+        statistics.quadCount += quadCount;
+
+        quadCount = 0;
+        textureSlotCount = 0;
+        vertices.clear();
+    }
+} // namespace FW
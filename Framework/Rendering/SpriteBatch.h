@@ -0,0 +1,122 @@
+#pragma once
+
+#include "pch.h"
+
+#include <array>
+
+// External
+#include <glm/glm.hpp>
+
+// Framework
+#include "Buffer.h"
+#include "Shader.h"
+
+namespace FW {
+    /**
+     * Batched renderer for textured quads.
+     *
+     * Instead of one draw call per sprite, quads are transformed on the CPU
+     * and appended to a large streaming vertex buffer. Up to
+     * `maxTextureSlots` different textures can be used in one batch; each
+     * vertex stores which slot to sample. The batch is flushed in one draw
+     * call when it is full, when it runs out of texture slots or on end().
+     *
+     * The quad geometry is the same unit quad as \ref PrimitiveQuad
+     * "PrimitiveQuad", so batched and unbatched sprites look the same.
+     *
+     * @example
+     * @code
+     * spriteBatch.begin(shader);
+     * for (auto& sprite : sprites) {
+     *     spriteBatch.submit(sprite.model, sprite.color, sprite.texture);
+     * }
+     * spriteBatch.end();
+     * @endcode
+     */
+    class SpriteBatch {
+    public:
+        /** Number of samplers declared in the batch fragment shader. */
+        static constexpr uint32_t maxTextureSlots = 16;
+
+        struct Statistics {
+            uint32_t drawCalls = 0;
+            uint32_t quadCount = 0;
+        };
+
+    public:
+        /**
+         * Create the batch and its GPU buffers. Requires an OpenGL context.
+         *
+         * @param maxQuads How many quads fit in one draw call.
+         */
+        explicit SpriteBatch(uint32_t maxQuads = 10000);
+
+        SpriteBatch(const SpriteBatch&) = delete;
+        SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+        /**
+         * Start a new batch.
+         *
+         * @param shader The batch shader. It must read world space positions
+         * and declare `u_textures[maxTextureSlots]`.
+         */
+        void begin(const Shader* shader);
+
+        /**
+         * Append a unit quad transformed by `model`.
+         *
+         * @param textureID The texture to sample. 0 is the default white
+         * texture.
+         * @param uvRect The part of the texture to sample: min UV in xy, max
+         * UV in zw. Used for atlas regions.
+         */
+        void submit(const glm::mat4& model,
+                    const glm::vec4& color,
+                    uint32_t textureID,
+                    const glm::vec4& uvRect = { 0.0f, 0.0f, 1.0f, 1.0f });
+
+        /** Draw everything submitted since begin(). */
+        void end();
+
+        /** Return true if quads have been submitted but not drawn yet. */
+        bool isPending() const { return quadCount > 0; }
+
+        const Statistics& getStatistics() const { return statistics; }
+        void resetStatistics() { statistics = Statistics{}; }
+
+    private:
+        void flush();
+
+    private:
+        struct Vertex {
+            glm::vec3 position;
+            glm::vec4 color;
+            glm::vec2 texCoord;
+            float texIndex;
+        };
+
+        uint32_t maxQuads;
+        uint32_t quadCount = 0;
+
+        /// CPU staging area, uploaded in one call per flush.
+        std::vector<Vertex> vertices;
+
+        std::array<uint32_t, maxTextureSlots> textureSlots{};
+        uint32_t textureSlotCount = 0;
+        uint32_t availableTextureSlots = maxTextureSlots;
+
+        /// Corners and UVs of the unit quad.
+        std::array<glm::vec4, 4> quadPositions;
+        std::array<glm::vec2, 4> quadTexCoords;
+
+        const Shader* shader = nullptr;
+        /// Shader whose `u_textures` samplers have been assigned.
+        const Shader* samplerShader = nullptr;
+
+        ref<VertexArray> vertexArray;
+        ref<VertexBuffer> vertexBuffer;
+        ref<IndexBuffer> indexBuffer;
+
+        Statistics statistics;
+    };
+} // namespace FW
@@ -1,4 +1,6 @@
 // C++ libraries
+#include <algorithm>
+#include <bit>
 #include <cstdint>
 
 // External
@@ -6,6 +8,8 @@
 
 // Framework
 #include "Texture.h"
+#include "TextureCache.h"
+#include "RenderState.h"
 #include "assertions.h"
 #include "Shader.h"
 #include "Log.h"
@@ -27,9 +31,38 @@ rgbToHex(const glm::vec3& color)
            (static_cast<uint32_t>(green) << 8) | static_cast<uint32_t>(blue);
 }
 
+/** Get the OpenGL formats of 8-bit images with `channels` channels. */
+static bool
+getFormats(int channels, GLenum& internalFormat, GLenum& dataFormat)
+{
+    // We only support image formats with RGB or RGBA channels
+    if (channels == 4) {
+        internalFormat = GL_RGBA8;
+        dataFormat = GL_RGBA;
+    } else if (channels == 3) {
+        internalFormat = GL_RGB8;
+        dataFormat = GL_RGB;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/** Size in bytes of mip `level` of an image. */
+static size_t
+getLevelSize(int width, int height, int channels, uint32_t level)
+{
+    return (size_t)std::max(1, width >> level) * std::max(1, height >> level) *
+           channels;
+}
+
 namespace FW {
+    size_t Texture::totalResidentSize = 0;
+
     Texture::~Texture()
     {
+        totalResidentSize -= residentSize;
+        RenderState::get().forgetTexture(textureID);
         glDeleteTextures(1, &textureID);
     }
 
@@ -84,6 +117,7 @@ namespace FW {
                             GL_UNSIGNED_BYTE,
                             (void*)&invertedData);
 
+        setResidentSize((size_t)width * height * 3);
         return textureID;
     }
 
@@ -94,69 +128,312 @@ namespace FW {
         return createTexture(name_, rgbToHex(color), size);
     }
 
+    uint32_t Texture::createTexture(const std::string& name_,
+                                    const Image& image)
+    {
+        createPendingTexture2D(name_, "");
+        // Atlas pages are built at runtime. Their regions would bleed into
+        // each other in small mips.
+        upload2D(image, 0, false);
+        return textureID;
+    }
+
+    void Texture::ImageDeleter::operator()(unsigned char* pixels) const
+    {
+        stbi_image_free(pixels);
+    }
+
+    Texture::Image Texture::decodeImage(const std::string& filepath)
+    {
+        if (TextureCache::isEnabled()) {
+            return TextureCache::load(filepath);
+        }
+        return decodeFile(filepath);
+    }
+
+    Texture::Image Texture::decodeFile(const std::string& filepath)
+    {
+        // stbi_image's y-axis in the uv-coordinate space is inverse to ours.
+        // The flag is global, so it is set once before any thread decodes
+        // and never touched again.
+        static const bool flipOnLoad = [] {
+            stbi_set_flip_vertically_on_load(1);
+            return true;
+        }();
+        (void)flipOnLoad;
+
+        Image image;
+        if (!stbi_info(filepath.c_str(),
+                       &image.width,
+                       &image.height,
+                       &image.channels)) {
+            return image;
+        }
+
+        // Only RGB and RGBA can be uploaded, so grey is expanded
+        image.channels = image.channels == 1 ? 3
+                         : image.channels == 2 ? 4
+                                               : image.channels;
+        image.pixels.reset(stbi_load(filepath.c_str(),
+                                     &image.width,
+                                     &image.height,
+                                     nullptr,
+                                     image.channels));
+        if (image.pixels) {
+            image.levels.emplace_back(image.pixels.get(),
+                                      (size_t)image.width * image.height *
+                                        image.channels);
+        }
+        return image;
+    }
+
     uint32_t Texture::loadTexture2D(const std::string& name_,
                                     const std::string& filepath_)
+    {
+        Image image = decodeImage(filepath_);
+
+        // Failed to load the image. The program will crash.
+        if (!image.isValid()) {
+            framework_assert("Failed to load texture: " + filepath_);
+        }
+
+        // Callers of the blocking load expect every level right away, so
+        // only textures loaded asynchronously are streamed
+        createPendingTexture2D(name_, filepath_);
+        upload2D(image);
+        return textureID;
+    }
+
+    void Texture::createPendingTexture2D(const std::string& name_,
+                                         const std::string& filepath_)
     {
         // Set member variables
         filepath = filepath_;
         name = name_;
         type = TextureType::Texture2D;
         textureTarget = GL_TEXTURE_2D;
+        ready = false;
 
-        int width, height, channels;
-
-        // stbi_image's y-axis in the uv-coordinate space is inverse to ours.
-        stbi_set_flip_vertically_on_load(1);
-        unsigned char* pixels =
-          stbi_load(filepath.c_str(), &width, &height, &channels, 0);
-
-        // Failed to load the image. The program will crash.
-        if (!pixels) {
-            framework_assert("Failed to load texture: " + filepath);
-        }
+        // The name is reserved now so it can be handed out before the
+        // pixels arrive. Storage is allocated by upload2D().
+        glCreateTextures(GL_TEXTURE_2D, 1, &textureID);
+    }
 
-        // We only support image formats with RGB or RGBA channels
+    bool Texture::upload2D(const Image& image,
+                           GLuint unpackBuffer,
+                           bool generateMipmaps)
+    {
         GLenum internalFormat, dataFormat;
-        if (channels == 4) {
-            internalFormat = GL_RGBA8;
-            dataFormat = GL_RGBA;
-        } else if (channels == 3) {
-            internalFormat = GL_RGB8;
-            dataFormat = GL_RGB;
-        } else {
+        if (!getFormats(image.channels, internalFormat, dataFormat)) {
             std::string msg = "Failed to load texture \'" + name +
                               "\', at path \'" + filepath + "\'. It contains " +
-                              std::to_string(channels) +
+                              std::to_string(image.channels) +
                               " channels. We only supports 3 and 4 channels.";
             framework_assert(msg);
+            return false;
         }
 
+        // Without mips, large textures alias badly when minified
+        auto uploadedLevels = (GLsizei)image.levels.size();
+        bool generate = generateMipmaps && uploadedLevels == 1;
+        GLsizei levelCount =
+          generate ? std::bit_width((unsigned)std::max(image.width,
+                                                       image.height))
+                   : uploadedLevels;
+
         // Allocate space to the texture
-        glCreateTextures(GL_TEXTURE_2D, 1, &textureID);
-        glTextureStorage2D(textureID, 1, internalFormat, width, height);
+        glTextureStorage2D(
+          textureID, levelCount, internalFormat, image.width, image.height);
 
         // Set texture parameters
-        glTextureParameteri(textureID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTextureParameteri(textureID,
+                            GL_TEXTURE_MIN_FILTER,
+                            levelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR
+                                           : GL_LINEAR);
         glTextureParameteri(textureID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
         glTextureParameteri(textureID, GL_TEXTURE_WRAP_S, GL_REPEAT);
         glTextureParameteri(textureID, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
-        // Upload the texture to the GPU
-        glTextureSubImage2D(textureID,
-                            0,
-                            0,
-                            0,
-                            width,
-                            height,
-                            dataFormat,
-                            GL_UNSIGNED_BYTE,
-                            pixels);
+        // Rows of RGB images are not padded to four bytes
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-        // Free image data. They are no longer needed.
-        stbi_image_free(pixels);
+        // Upload the texture to the GPU. With an unpack buffer bound, the
+        // pixels are read from it instead, at the level's offset.
+        if (unpackBuffer) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, unpackBuffer);
+        }
+        size_t offset = 0;
+        for (GLsizei level = 0; level < uploadedLevels; level++) {
+            const unsigned char* pixels =
+              unpackBuffer ? reinterpret_cast<const unsigned char*>(offset)
+                           : image.levels[level].data();
+            glTextureSubImage2D(textureID,
+                                level,
+                                0,
+                                0,
+                                std::max(1, image.width >> level),
+                                std::max(1, image.height >> level),
+                                dataFormat,
+                                GL_UNSIGNED_BYTE,
+                                pixels);
+            offset += image.levels[level].size();
+        }
+        if (unpackBuffer) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
 
-        return textureID;
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        if (generate) {
+            glGenerateTextureMipmap(textureID);
+        }
+
+        size_t size = 0;
+        for (GLsizei level = 0; level < levelCount; level++) {
+            size +=
+              getLevelSize(image.width, image.height, image.channels, level);
+        }
+        setResidentSize(size);
+
+        ready = true;
+        return true;
+    }
+
+    bool Texture::isStreamable(const Image& image)
+    {
+        return image.levels.size() > 1 && image.mapping.isOpen();
+    }
+
+    bool Texture::uploadStreamed(Image image)
+    {
+        GLenum internalFormat, dataFormat;
+        if (!getFormats(image.channels, internalFormat, dataFormat)) {
+            WARN("Texture::uploadStreamed: '{}' has {} channels, but only 3 "
+                 "and 4 are supported",
+                 name,
+                 image.channels);
+            return false;
+        }
+
+        streamSource = std::move(image);
+        auto levelCount = (uint32_t)streamSource.levels.size();
+
+        // The first level small enough to always keep
+        persistentLevel = 0;
+        while (persistentLevel + 1 < levelCount &&
+               std::max(streamSource.width >> persistentLevel,
+                        streamSource.height >> persistentLevel) >
+                 streamingBaseSize) {
+            persistentLevel++;
+        }
+
+        // Immutable storage could not give levels back, so the levels are
+        // specified one by one
+        RenderState::get().bindTexture(GL_TEXTURE_2D, textureID, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        size_t size = 0;
+        for (uint32_t level = persistentLevel; level < levelCount; level++) {
+            glTexImage2D(GL_TEXTURE_2D,
+                         level,
+                         internalFormat,
+                         std::max(1, streamSource.width >> level),
+                         std::max(1, streamSource.height >> level),
+                         0,
+                         dataFormat,
+                         GL_UNSIGNED_BYTE,
+                         streamSource.levels[level].data());
+            size += streamSource.levels[level].size();
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        setResidentSize(size);
+
+        // Sampling starts at the largest resident level
+        residentLevel = persistentLevel;
+        glTextureParameteri(textureID, GL_TEXTURE_BASE_LEVEL, residentLevel);
+        glTextureParameteri(textureID, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+
+        glTextureParameteri(
+          textureID, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTextureParameteri(textureID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        glTextureParameteri(textureID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTextureParameteri(textureID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+        ready = true;
+        return true;
+    }
+
+    bool Texture::streamIn()
+    {
+        if (!isStreamed() || residentLevel == 0) {
+            return false;
+        }
+
+        GLenum internalFormat, dataFormat;
+        getFormats(streamSource.channels, internalFormat, dataFormat);
+
+        uint32_t level = residentLevel - 1;
+        RenderState::get().bindTexture(GL_TEXTURE_2D, textureID, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D,
+                     level,
+                     internalFormat,
+                     std::max(1, streamSource.width >> level),
+                     std::max(1, streamSource.height >> level),
+                     0,
+                     dataFormat,
+                     GL_UNSIGNED_BYTE,
+                     streamSource.levels[level].data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        residentLevel = level;
+        setResidentSize(residentSize + streamSource.levels[level].size());
+        glTextureParameteri(textureID, GL_TEXTURE_BASE_LEVEL, residentLevel);
+        return true;
+    }
+
+    bool Texture::streamOut()
+    {
+        if (!isStreamed() || residentLevel >= persistentLevel) {
+            return false;
+        }
+
+        GLenum internalFormat, dataFormat;
+        getFormats(streamSource.channels, internalFormat, dataFormat);
+
+        // Stop sampling the level before giving its memory back
+        uint32_t level = residentLevel;
+        residentLevel++;
+        glTextureParameteri(textureID, GL_TEXTURE_BASE_LEVEL, residentLevel);
+
+        RenderState::get().bindTexture(GL_TEXTURE_2D, textureID, 0);
+        glTexImage2D(GL_TEXTURE_2D,
+                     level,
+                     internalFormat,
+                     0,
+                     0,
+                     0,
+                     dataFormat,
+                     GL_UNSIGNED_BYTE,
+                     nullptr);
+
+        setResidentSize(residentSize - streamSource.levels[level].size());
+        return true;
+    }
+
+    void Texture::setResidentSize(size_t size)
+    {
+        totalResidentSize = totalResidentSize - residentSize + size;
+        residentSize = size;
+    }
+
+    size_t Texture::getNextLevelSize() const
+    {
+        if (!isStreamed() || residentLevel == 0) {
+            return 0;
+        }
+        return streamSource.levels[residentLevel - 1].size();
     }
 
     uint32_t Texture::loadCubeMap(const std::string& name_,
@@ -170,45 +447,63 @@ namespace FW {
 
     uint32_t Texture::loadCubeMap(const std::string& name_,
                                   const std::vector<std::string>& filePaths)
+    {
+        std::vector<Image> faces;
+        for (const auto& path : filePaths) {
+            faces.push_back(decodeImage(path));
+        }
+
+        createPendingCubeMap(name_);
+        uploadCubeMap(faces, filePaths);
+        return textureID;
+    }
+
+    void Texture::createPendingCubeMap(const std::string& name_)
     {
         // Set member variables
         type = TextureType::CubeMap;
         textureTarget = GL_TEXTURE_CUBE_MAP;
         name = name_;
+        ready = false;
 
-        // Allocate data to the texture
         glGenTextures(1, &textureID);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
-
-        // Iterate over all file paths
-        for (uint32_t i = 0; i < filePaths.size(); i++) {
-            int width, height, nrChannels;
+    }
 
-            // Load image data
-            unsigned char* data =
-              stbi_load(filePaths[i].c_str(), &width, &height, &nrChannels, 0);
+    void Texture::uploadCubeMap(const std::vector<Image>& faces,
+                                const std::vector<std::string>& filePaths)
+    {
+        RenderState::get().bindTexture(GL_TEXTURE_CUBE_MAP, textureID, 0);
 
+        // Iterate over all faces
+        size_t size = 0;
+        for (uint32_t i = 0; i < faces.size(); i++) {
             // Upload data to the GPU
-            if (data) {
+            if (faces[i].isValid()) {
+                // Mips add a third on top of the base level
+                size += faces[i].levels[0].size() * 4 / 3;
+                GLenum format = faces[i].channels == 4 ? GL_RGBA : GL_RGB;
                 glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i,
                              0,
-                             GL_RGB,
-                             width,
-                             height,
+                             format,
+                             faces[i].width,
+                             faces[i].height,
                              0,
-                             GL_RGB,
+                             format,
                              GL_UNSIGNED_BYTE,
-                             data);
+                             faces[i].getPixels());
             } else {
                 framework_assert(
                   std::string("CubeMap failed ton load at path \'") +
                   filePaths[i] + "\'");
             }
-            stbi_image_free(data);
         }
 
+        glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+        setResidentSize(size);
+
         // Set texture parameters
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(
+          GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glTexParameteri(
           GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -217,7 +512,7 @@ namespace FW {
         glTexParameteri(
           GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
-        return textureID;
+        ready = true;
     }
 
     void Texture::bind(int textureSlot) const
@@ -227,7 +522,6 @@ namespace FW {
             return;
         }
 
-        glActiveTexture(GL_TEXTURE0 + textureSlot);
-        glBindTexture(textureTarget, textureID);
+        RenderState::get().bindTexture(textureTarget, textureID, textureSlot);
     }
 }
@@ -1,6 +1,8 @@
 #pragma once
 
 // C++ libraries
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -8,6 +10,9 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+// Framework
+#include "MappedFile.h"
+
 namespace FW {
     class Shader;
 
@@ -43,6 +48,7 @@ namespace FW {
      * non-existing texture will yield a warning.
      * @details <b><i>Format support:</i></b><br>
      * Currently, the Texture only supports RGB and RGBA 8-bit channels.
+     * Grey images are expanded to RGB or RGBA when they are decoded.
      *
      */
     class Texture
@@ -58,6 +64,47 @@ namespace FW {
             WhiteTexture
         };
 
+        /** Frees pixels allocated by stb_image. */
+        struct ImageDeleter {
+            void operator()(unsigned char* pixels) const;
+        };
+
+        /**
+         * Pixels decoded from an image file, not yet uploaded.
+         *
+         * @details The pixels are owned either by stb_image or by a mapped
+         * \ref TextureCache "TextureCache" file. Images from the cache also
+         * carry their mip chain.
+         */
+        struct Image {
+            int width = 0;
+            int height = 0;
+            /// 3 or 4. Grey images are expanded when decoded.
+            int channels = 0;
+            /// Level 0 first, each half the size of the one before. Empty if
+            /// the file could not be decoded.
+            std::vector<std::span<const unsigned char>> levels;
+
+            std::unique_ptr<unsigned char, ImageDeleter> pixels;
+            MappedFile mapping;
+
+            [[nodiscard]] bool isValid() const { return !levels.empty(); }
+
+            /** Pixels of level 0. */
+            [[nodiscard]] const unsigned char* getPixels() const {
+                return levels.empty() ? nullptr : levels[0].data();
+            }
+
+            /** Size of all levels in bytes. */
+            [[nodiscard]] size_t getSize() const {
+                size_t size = 0;
+                for (const auto& level : levels) {
+                    size += level.size();
+                }
+                return size;
+            }
+        };
+
     public:
         /**
          * Create a new texture and set a uniform colour by hexadecimal values.
@@ -85,6 +132,16 @@ namespace FW {
                                glm::vec3 color = glm::vec3(0.0f),
                                glm::vec2 size = glm::vec2(1.0f));
 
+        /**
+         * Create a new texture from pixels generated at runtime.
+         *
+         * @param name The texture's name. Used to identify it when binding.
+         * @param image The pixels to upload. Every level is uploaded.
+         * @return Texture ID that also can be used to identify the texture
+         * with.
+         */
+        uint32_t createTexture(const std::string& name, const Image& image);
+
         /**
          * Load a texture from disk.
          *
@@ -92,6 +149,7 @@ namespace FW {
          * texture. The primary usage for this texture is mapping data to
          * geometry surfaces.<br>
          * In the GLSL shader, the texture is sampled with <i>sampler2D</i>.
+         * Its whole mip chain is uploaded before this returns.
          *
          * @param name The texture's name. This is used when binding with the
          * TextureManager.
@@ -134,6 +192,104 @@ namespace FW {
         uint32_t loadCubeMap(const std::string& name,
                              const std::vector<std::string>& filePaths);
 
+        /**
+         * Decode an image file on the CPU.
+         *
+         * @details This does not touch OpenGL, so it may be called from any
+         * thread. The result is uploaded with upload2D() or uploadCubeMap().
+         * The \ref TextureCache "TextureCache" is consulted first, if enabled.
+         */
+        static Image decodeImage(const std::string& filepath);
+
+        /** Decode an image file with stb_image, bypassing the cache. */
+        static Image decodeFile(const std::string& filepath);
+
+        /**
+         * Reserve the texture's ID without allocating its storage.
+         *
+         * @details The texture is not ready until upload2D() is called, and
+         * binding it before that samples an incomplete texture.
+         */
+        void createPendingTexture2D(const std::string& name,
+                                    const std::string& filepath);
+
+        /**
+         * Allocate storage for a texture created with
+         * createPendingTexture2D() and upload `image` to it.
+         *
+         * @details Every level of `image` is uploaded. If it only has one,
+         * the rest of the mip chain is generated by the driver, unless
+         * `generateMipmaps` is false. The texture is sampled with trilinear
+         * filtering whenever it has mips.
+         *
+         * @param unpackBuffer If not 0, the pixels are read from this pixel
+         * unpack buffer instead of from `image`. The levels are expected
+         * back to back, in the same order.
+         * @return False if the image's format is not supported.
+         */
+        bool upload2D(const Image& image,
+                      GLuint unpackBuffer = 0,
+                      bool generateMipmaps = true);
+
+        /**
+         * Upload the low mips of `image` and keep it to stream in the rest
+         * later.
+         *
+         * @details Levels no larger than `streamingBaseSize` are uploaded
+         * right away and always stay resident. Larger levels are uploaded
+         * one at a time by streamIn() and dropped again by streamOut(). The
+         * texture uses mutable storage, so dropping a level frees its memory
+         * without changing the texture's ID.
+         *
+         * @details Only the TextureLoader streams textures, since whoever
+         * loads asynchronously already calls TextureManager::processUploads()
+         * every frame, which is what refines them.
+         *
+         * @return False if the image's format is not supported.
+         */
+        bool uploadStreamed(Image image);
+
+        /**
+         * True for images that can be streamed: they carry a mip chain that
+         * is cheap to keep, because it is mapped from the \ref TextureCache
+         * "TextureCache".
+         */
+        static bool isStreamable(const Image& image);
+
+        /**
+         * Upload the next larger level of a streamed texture.
+         *
+         * @return False if the texture is not streamed or fully resident.
+         */
+        bool streamIn();
+
+        /**
+         * Drop the largest resident level of a streamed texture.
+         *
+         * @return False if only the levels that always stay resident are
+         * left.
+         */
+        bool streamOut();
+
+        /** True if the texture was uploaded with uploadStreamed(). */
+        [[nodiscard]] bool isStreamed() const { return streamSource.isValid(); }
+
+        /** Size in bytes of the level streamIn() would upload next. */
+        [[nodiscard]] size_t getNextLevelSize() const;
+
+        /** Size in bytes of the texture's resident levels. */
+        [[nodiscard]] size_t getResidentSize() const { return residentSize; }
+
+        /** Cube map counterpart of createPendingTexture2D(). */
+        void createPendingCubeMap(const std::string& name);
+
+        /** Upload the six faces of a cube map, ordered as in loadCubeMap(). */
+        void uploadCubeMap(const std::vector<Image>& faces,
+                           const std::vector<std::string>& filePaths);
+
+        /** True once the texture's pixels have been uploaded. */
+        [[nodiscard]] bool isReady() const { return ready; }
+
         /**
          * Bind the texture.
          *
@@ -176,6 +332,9 @@ namespace FW {
          */
         virtual ~Texture();
 
+        Texture(const Texture&) = delete;
+        Texture& operator=(const Texture&) = delete;
+
     private:
         /** Gives the TextureManager access to Texture's private members */
         friend class TextureManager;
@@ -195,5 +354,33 @@ namespace FW {
 
         /** Specifies the target when binding the texture. */
         GLenum textureTarget = 0;
+
+        /** Textures being loaded in the background are not ready yet. */
+        bool ready = true;
+
+        /** Bytes of texture memory in use, estimated from the levels. */
+        size_t residentSize = 0;
+
+        /** Sum of `residentSize` over all textures. */
+        static size_t totalResidentSize;
+
+        /** Change `residentSize`, keeping `totalResidentSize` up to date. */
+        void setResidentSize(size_t size);
+
+        /** The full mip chain of streamed textures. */
+        Image streamSource;
+
+        /** Largest resident level of a streamed texture. */
+        uint32_t residentLevel = 0;
+
+        /** Levels from this one on are never dropped. */
+        uint32_t persistentLevel = 0;
+
+        /** Last frame the TextureManager bound this texture in. */
+        uint64_t lastUsedFrame = 0;
+
+    public:
+        /** Streamed levels up to this width and height are always resident. */
+        static constexpr int streamingBaseSize = 128;
     };
 }
@@ -0,0 +1,166 @@
+#include "TextureAtlas.h"
+#include "TextureManager.h"
+#include "SkylinePacker.h"
+#include "Log.h"
+
+#include <algorithm>
+
+namespace FW {
+    /** Width and height of the blocks created by addColor(). */
+    static constexpr int colorBlockSize = 4;
+
+    TextureAtlas::TextureAtlas(std::string name, int pageSize, int padding)
+      : name(std::move(name)),
+        pageSize(pageSize),
+        padding(padding) {}
+
+    void TextureAtlas::add(const std::string& name,
+                           const std::string& filepath) {
+        entries.push_back({ name, filepath, 0 });
+    }
+
+    void TextureAtlas::addColor(const std::string& name, uint32_t hexColor) {
+        entries.push_back({ name, "", hexColor });
+    }
+
+    bool TextureAtlas::build() {
+        for (uint32_t page : pages) {
+            TextureManager::deleteTexture((int)page);
+        }
+        pages.clear();
+        regions.clear();
+
+        // Decode everything up front, so images can be packed tallest first
+        struct Source {
+            const Entry* entry;
+            Texture::Image image;
+            int width;
+            int height;
+        };
+        std::vector<Source> sources;
+        bool success = true;
+
+        for (const auto& entry : entries) {
+            if (entry.filepath.empty()) {
+                sources.push_back(
+                  { &entry, {}, colorBlockSize, colorBlockSize });
+                continue;
+            }
+
+            Texture::Image image = Texture::decodeImage(entry.filepath);
+            if (!image.isValid()) {
+                WARN("TextureAtlas::build: Failed to load '{}' at path '{}'",
+                     entry.name,
+                     entry.filepath);
+                success = false;
+                continue;
+            }
+            int width = image.width;
+            int height = image.height;
+            sources.push_back({ &entry, std::move(image), width, height });
+        }
+
+        std::stable_sort(
+          sources.begin(), sources.end(), [](const auto& a, const auto& b) {
+              return a.height > b.height;
+          });
+
+        struct Page {
+            SkylinePacker packer;
+            std::vector<unsigned char> pixels;
+        };
+        std::vector<Page> packedPages;
+        std::vector<std::pair<std::string, size_t>> pageOfRegion;
+
+        for (const auto& source : sources) {
+            int width = source.width + 2 * padding;
+            int height = source.height + 2 * padding;
+            if (width > pageSize || height > pageSize) {
+                WARN("TextureAtlas::build: '{}' is {}x{}, which does not fit "
+                     "on a {}x{} page",
+                     source.entry->name,
+                     source.width,
+                     source.height,
+                     pageSize,
+                     pageSize);
+                success = false;
+                continue;
+            }
+
+            std::optional<SkylinePacker::Rect> rect;
+            size_t pageIndex = 0;
+            for (; pageIndex < packedPages.size() && !rect; pageIndex++) {
+                rect = packedPages[pageIndex].packer.insert(width, height);
+            }
+            if (rect) {
+                pageIndex--;
+            } else {
+                packedPages.push_back(
+                  { SkylinePacker(pageSize, pageSize),
+                    std::vector<unsigned char>((size_t)pageSize * pageSize *
+                                               4) });
+                rect = packedPages.back().packer.insert(width, height);
+            }
+
+            // Copy the image, clamping to its edges inside the padding
+            unsigned char* target = packedPages[pageIndex].pixels.data();
+            const Texture::Image& image = source.image;
+            uint32_t color = source.entry->color;
+            for (int y = 0; y < height; y++) {
+                int sourceY = std::clamp(y - padding, 0, source.height - 1);
+                for (int x = 0; x < width; x++) {
+                    int sourceX = std::clamp(x - padding, 0, source.width - 1);
+                    unsigned char* pixel =
+                      target +
+                      ((size_t)(rect->y + y) * pageSize + rect->x + x) * 4;
+
+                    if (!image.isValid()) {
+                        pixel[0] = (color >> 16) & 0xff;
+                        pixel[1] = (color >> 8) & 0xff;
+                        pixel[2] = color & 0xff;
+                        pixel[3] = 0xff;
+                        continue;
+                    }
+
+                    const unsigned char* sourcePixel =
+                      image.getPixels() +
+                      ((size_t)sourceY * image.width + sourceX) *
+                        image.channels;
+                    pixel[0] = sourcePixel[0];
+                    pixel[1] = sourcePixel[1];
+                    pixel[2] = sourcePixel[2];
+                    pixel[3] = image.channels == 4 ? sourcePixel[3] : 0xff;
+                }
+            }
+
+            float size = (float)pageSize;
+            AtlasRegion& region = regions[source.entry->name];
+            region.uvRect = { (rect->x + padding) / size,
+                              (rect->y + padding) / size,
+                              (rect->x + padding + source.width) / size,
+                              (rect->y + padding + source.height) / size };
+            pageOfRegion.emplace_back(source.entry->name, pageIndex);
+        }
+
+        for (size_t i = 0; i < packedPages.size(); i++) {
+            Texture::Image image;
+            image.width = pageSize;
+            image.height = pageSize;
+            image.channels = 4;
+            image.levels.emplace_back(packedPages[i].pixels);
+            pages.push_back(TextureManager::createTexture(
+              name + "#" + std::to_string(i), image));
+        }
+
+        for (const auto& [regionName, pageIndex] : pageOfRegion) {
+            regions[regionName].textureID = pages[pageIndex];
+        }
+
+        return success;
+    }
+
+    const AtlasRegion* TextureAtlas::getRegion(const std::string& name) const {
+        auto it = regions.find(name);
+        return it != regions.end() ? &it->second : nullptr;
+    }
+} // namespace FW
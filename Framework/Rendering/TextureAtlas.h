@@ -0,0 +1,99 @@
+#pragma once
+
+#include "pch.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// External
+#include <glm/glm.hpp>
+
+// Framework
+#include "Texture.h"
+
+namespace FW {
+    /** Where an image ended up in a \ref TextureAtlas "TextureAtlas". */
+    struct AtlasRegion {
+        /** The atlas page holding the image. */
+        uint32_t textureID = 0;
+
+        /** Texture coordinates of the image: min in xy, max in zw. */
+        glm::vec4 uvRect{ 0.0f, 0.0f, 1.0f, 1.0f };
+    };
+
+    /**
+     * Packs many small images into a few large textures.
+     *
+     * @details Sprites that sample different textures cannot share a texture
+     * slot in the \ref SpriteBatch "SpriteBatch", and sprites drawn on their
+     * own need a bind each. When their images share an atlas page, they use
+     * the same texture and only differ in which part of it they sample.
+     *
+     * @details Images are packed with a \ref SkylinePacker "SkylinePacker",
+     * tallest first. Each one is surrounded by `padding` pixels copied from
+     * its own edges, so filtering near a border never picks up a neighbour.
+     * Pages are RGBA and registered in the \ref TextureManager
+     * "TextureManager" as `<name>#<page>`.
+     *
+     * @example
+     * @code
+     * TextureAtlas atlas("sprites");
+     * atlas.add("ship", "textures/ship.png");
+     * atlas.addColor("bullet", 0xFFFFFF);
+     * atlas.build();
+     *
+     * sprite->setTexture(*atlas.getRegion("ship"));
+     * @endcode
+     */
+    class TextureAtlas {
+    public:
+        explicit TextureAtlas(std::string name,
+                              int pageSize = 2048,
+                              int padding = 2);
+
+        TextureAtlas(const TextureAtlas&) = delete;
+        TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+        /** Queue an image file to be packed by build(). */
+        void add(const std::string& name, const std::string& filepath);
+
+        /**
+         * Queue a small block of uniform colour, so untextured sprites can
+         * use the atlas too. Tint it with the sprite's colour.
+         */
+        void addColor(const std::string& name, uint32_t hexColor = 0xFFFFFF);
+
+        /**
+         * Decode and pack everything queued, then upload the pages. Pages of
+         * an earlier build are deleted first.
+         *
+         * @return False if an image could not be decoded or does not fit on
+         * a page. Everything else is still packed.
+         */
+        bool build();
+
+        /** Get a packed image, or nullptr if it was not packed. */
+        const AtlasRegion* getRegion(const std::string& name) const;
+
+        /** Texture IDs of the pages, in the order they were created. */
+        const std::vector<uint32_t>& getPages() const { return pages; }
+
+    private:
+        struct Entry {
+            std::string name;
+            /// Empty for colour blocks.
+            std::string filepath;
+            uint32_t color = 0;
+        };
+
+    private:
+        std::string name;
+        int pageSize;
+        int padding;
+
+        std::vector<Entry> entries;
+        std::vector<uint32_t> pages;
+        std::unordered_map<std::string, AtlasRegion> regions;
+    };
+} // namespace FW
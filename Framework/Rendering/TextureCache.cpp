@@ -0,0 +1,261 @@
+#include "TextureCache.h"
+#include "Files.h"
+#include "Hash.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace FW {
+    /** Written at the start of every texture cache file. */
+    struct TextureCacheHeader {
+        std::uint32_t magic = 0x59475458; // "YGTX"
+        std::uint32_t version = TextureCache::formatVersion;
+        std::uint64_t pathHash = 0;
+        /** Modification time and size of the source file. */
+        std::int64_t sourceModified = 0;
+        std::uint64_t sourceSize = 0;
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+        std::uint32_t channels = 0;
+        std::uint32_t levelCount = 0;
+    };
+
+    static std::filesystem::path getDefaultDirectory() {
+        auto dataDir = getDataDir();
+        return dataDir ? dataDir.value() / "texture_cache"
+                       : std::filesystem::temp_directory_path() /
+                           "yagi_texture_cache";
+    }
+
+    bool TextureCache::enabled = true;
+    std::filesystem::path TextureCache::directory = getDefaultDirectory();
+
+    /** Size in bytes of mip `level` of a `width` x `height` image. */
+    static std::size_t getLevelSize(std::uint32_t width,
+                                    std::uint32_t height,
+                                    std::uint32_t channels,
+                                    std::uint32_t level) {
+        return (std::size_t)std::max(1u, width >> level) *
+               std::max(1u, height >> level) * channels;
+    }
+
+    /**
+     * Halve an image with a 2x2 box filter. The last row and column are
+     * repeated when a side is odd.
+     */
+    static std::vector<unsigned char> downsample(const unsigned char* source,
+                                                 int width,
+                                                 int height,
+                                                 int channels) {
+        int targetWidth = std::max(1, width / 2);
+        int targetHeight = std::max(1, height / 2);
+        std::vector<unsigned char> target(
+          (std::size_t)targetWidth * targetHeight * channels);
+
+        for (int y = 0; y < targetHeight; y++) {
+            std::size_t stride = (std::size_t)width * channels;
+            const unsigned char* row0 = source + std::min(2 * y, height - 1) *
+                                                   stride;
+            const unsigned char* row1 =
+              source + std::min(2 * y + 1, height - 1) * stride;
+            unsigned char* out =
+              &target[(std::size_t)y * targetWidth * channels];
+
+            for (int x = 0; x < targetWidth; x++) {
+                int x0 = std::min(2 * x, width - 1) * channels;
+                int x1 = std::min(2 * x + 1, width - 1) * channels;
+                for (int c = 0; c < channels; c++) {
+                    out[x * channels + c] = (unsigned char)(
+                      (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] +
+                       row1[x1 + c] + 2) /
+                      4);
+                }
+            }
+        }
+
+        return target;
+    }
+
+    Texture::Image TextureCache::load(const std::string& filepath) {
+        std::optional<Source> source = getSource(filepath);
+        if (!source) {
+            return Texture::decodeFile(filepath);
+        }
+
+        std::filesystem::path path = getEntryPath(source->pathHash);
+        if (Texture::Image cached = read(path, *source); cached.isValid()) {
+            return cached;
+        }
+
+        // Missing or stale. A stale entry is replaced.
+        Texture::Image decoded = Texture::decodeFile(filepath);
+        if (!decoded.isValid() || !write(path, decoded, *source)) {
+            return decoded;
+        }
+
+        // Map what was just written, so the image carries its mips
+        Texture::Image cached = read(path, *source);
+        return cached.isValid() ? std::move(cached) : std::move(decoded);
+    }
+
+    std::filesystem::path TextureCache::getEntryPath(
+      const std::string& filepath) {
+        std::optional<Source> source = getSource(filepath);
+        return source ? getEntryPath(source->pathHash)
+                      : std::filesystem::path();
+    }
+
+    std::filesystem::path TextureCache::getEntryPath(std::uint64_t pathHash) {
+        std::stringstream filename;
+        filename << std::hex << pathHash << ".tex";
+        return directory / filename.str();
+    }
+
+    Texture::Image TextureCache::read(const std::filesystem::path& path,
+                                      const Source& source) {
+        Texture::Image image;
+
+        MappedFile file(path);
+        TextureCacheHeader header;
+        if (!file.isOpen() || file.size() < sizeof(header)) {
+            return image;
+        }
+
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (header.magic != TextureCacheHeader{}.magic ||
+            header.version != formatVersion ||
+            header.pathHash != source.pathHash ||
+            header.sourceModified != source.modified ||
+            header.sourceSize != source.size ||
+            (header.channels != 3 && header.channels != 4) ||
+            header.levelCount == 0 || header.levelCount > 32) {
+            return image;
+        }
+
+        // A truncated file is treated as a miss and overwritten
+        std::size_t offset = sizeof(header);
+        for (std::uint32_t level = 0; level < header.levelCount; level++) {
+            offset +=
+              getLevelSize(header.width, header.height, header.channels, level);
+        }
+        if (offset != file.size()) {
+            return image;
+        }
+
+        offset = sizeof(header);
+        for (std::uint32_t level = 0; level < header.levelCount; level++) {
+            std::size_t size =
+              getLevelSize(header.width, header.height, header.channels, level);
+            image.levels.emplace_back(
+              reinterpret_cast<const unsigned char*>(file.data() + offset),
+              size);
+            offset += size;
+        }
+
+        image.width = (int)header.width;
+        image.height = (int)header.height;
+        image.channels = (int)header.channels;
+        image.mapping = std::move(file);
+        return image;
+    }
+
+    bool TextureCache::write(const std::filesystem::path& path,
+                             const Texture::Image& image,
+                             const Source& source) {
+        std::error_code error;
+        std::filesystem::create_directories(path.parent_path(), error);
+        if (error) {
+            WARN("Unable to create texture cache directory {}: {}",
+                 path.parent_path().string(),
+                 error.message());
+            return false;
+        }
+
+        TextureCacheHeader header;
+        header.pathHash = source.pathHash;
+        header.sourceModified = source.modified;
+        header.sourceSize = source.size;
+        header.width = (std::uint32_t)image.width;
+        header.height = (std::uint32_t)image.height;
+        header.channels = (std::uint32_t)image.channels;
+
+        // Write to a file of our own and rename it over any stale entry, so
+        // other threads and processes never map a half-written entry. Images
+        // still mapping the stale entry keep it alive until they let go.
+        std::filesystem::path temporary = path;
+        temporary += "." +
+                     std::to_string(std::hash<std::thread::id>{}(
+                       std::this_thread::get_id())) +
+                     ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+            const unsigned char* level = image.getPixels();
+            int width = image.width;
+            int height = image.height;
+            std::vector<unsigned char> mip;
+            while (true) {
+                file.write(reinterpret_cast<const char*>(level),
+                           (std::streamsize)width * height * image.channels);
+                header.levelCount++;
+                if (width == 1 && height == 1) {
+                    break;
+                }
+
+                mip = downsample(level, width, height, image.channels);
+                level = mip.data();
+                width = std::max(1, width / 2);
+                height = std::max(1, height / 2);
+            }
+
+            // The level count is only known now
+            file.seekp(0);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            if (!file) {
+                file.close();
+                std::filesystem::remove(temporary, error);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temporary, path, error);
+        if (error) {
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+        return true;
+    }
+
+    std::optional<TextureCache::Source> TextureCache::getSource(
+      const std::string& filepath) {
+        std::error_code error;
+        std::filesystem::path path =
+          std::filesystem::weakly_canonical(filepath, error);
+        if (error) {
+            return std::nullopt;
+        }
+
+        auto modified = std::filesystem::last_write_time(path, error);
+        if (error) {
+            return std::nullopt;
+        }
+        auto size = std::filesystem::file_size(path, error);
+        if (error) {
+            return std::nullopt;
+        }
+
+        Source source;
+        source.pathHash = hashFNV1a(path.string());
+        source.modified =
+          static_cast<std::int64_t>(modified.time_since_epoch().count());
+        source.size = static_cast<std::uint64_t>(size);
+        return source;
+    }
+} // namespace FW
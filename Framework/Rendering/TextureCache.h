@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include "Texture.h"
+
+namespace FW {
+    /**
+     * On-disk cache of decoded textures.
+     *
+     * @details Decoding a JPG or PNG is by far the slowest part of loading a
+     * texture, and the result is the same on every launch. The first time a
+     * file is loaded, its pixels are decoded, flipped, expanded to RGB or
+     * RGBA and given a full mip chain, then written to the cache. Later
+     * launches map the cache file and upload straight from the mapping.
+     *
+     * @details Each source file has one entry, named after a hash of its
+     * canonical path. The entry records the file's modification time and
+     * size, so editing a texture invalidates it, and the next load
+     * overwrites it in place. The cache never holds more than one entry per
+     * texture.
+     *
+     * @details The cache is enabled by default and lives in the
+     * `texture_cache` directory of the user's data directory, see
+     * getDataDir(), or in the temporary directory if there is none. Call
+     * setEnabled(false) or setDirectory() before loading any texture to turn
+     * it off or move it. Deleting the directory is always safe.
+     *
+     * @details <h1>File format</h1>
+     * A TextureCacheHeader followed by every mip level, largest first, with
+     * rows tightly packed. All values are in native byte order.
+     */
+    class TextureCache {
+    public:
+        /**
+         * Load `filepath` from the cache, decoding and caching it first if
+         * needed. Safe to call from any thread.
+         *
+         * @details If the cache cannot be written, the decoded image is
+         * returned without mips.
+         */
+        static Texture::Image load(const std::string& filepath);
+
+        /** Path of the cache entry for `filepath`, or an empty path if the
+         * file does not exist. */
+        static std::filesystem::path getEntryPath(const std::string& filepath);
+
+        static bool isEnabled() { return enabled; }
+
+        /** Turn the cache on or off. Call before loading any texture. */
+        static void setEnabled(bool enable) { enabled = enable; }
+
+        static const std::filesystem::path& getDirectory() {
+            return directory;
+        }
+
+        /** Move the cache. Call before loading any texture. */
+        static void setDirectory(const std::filesystem::path& path) {
+            directory = path;
+        }
+
+    public:
+        /** Bumped whenever the file format or the decoding changes. */
+        static constexpr std::uint32_t formatVersion = 2;
+
+    private:
+        /** Identifies a version of a source file. */
+        struct Source {
+            /** Hash of the canonical path, which names the entry. */
+            std::uint64_t pathHash = 0;
+            std::int64_t modified = 0;
+            std::uint64_t size = 0;
+        };
+
+        /** Returns nothing if the file cannot be found. */
+        static std::optional<Source> getSource(const std::string& filepath);
+
+        /** Returns an invalid image if the entry is missing or stale. */
+        static Texture::Image read(const std::filesystem::path& path,
+                                   const Source& source);
+
+        static bool write(const std::filesystem::path& path,
+                          const Texture::Image& image,
+                          const Source& source);
+
+        static std::filesystem::path getEntryPath(std::uint64_t pathHash);
+
+    private:
+        static bool enabled;
+        static std::filesystem::path directory;
+    };
+} // namespace FW
@@ -0,0 +1,180 @@
+#include "TextureLoader.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace FW {
+    TextureLoader::~TextureLoader()
+    {
+        // Join before the queues are destroyed. The pixel buffer is left to
+        // the driver, the context is usually gone by now.
+        for (auto& worker : workers) {
+            worker.request_stop();
+        }
+        jobReady.notify_all();
+        workers.clear();
+    }
+
+    void TextureLoader::request(TextureHandle handle,
+                                std::vector<std::string> filePaths)
+    {
+        if (workers.empty()) {
+            startWorkers();
+        }
+
+        ref<PendingTexture> pending = createRef<PendingTexture>();
+        pending->handle = handle;
+        pending->filePaths = std::move(filePaths);
+        pending->images.resize(pending->filePaths.size());
+        pending->remaining = (uint32_t)pending->filePaths.size();
+        pendingCount++;
+
+        {
+            std::lock_guard lock(jobMutex);
+            for (uint32_t i = 0; i < pending->filePaths.size(); i++) {
+                jobs.push_back({ pending, i });
+            }
+        }
+        jobReady.notify_all();
+    }
+
+    uint32_t TextureLoader::processUploads(size_t byteBudget)
+    {
+        uint32_t uploaded = 0;
+        size_t uploadedBytes = 0;
+
+        while (uploaded == 0 || uploadedBytes < byteBudget) {
+            ref<PendingTexture> pending;
+            {
+                std::lock_guard lock(decodedMutex);
+                if (decoded.empty()) {
+                    break;
+                }
+                pending = std::move(decoded.front());
+                decoded.pop_front();
+            }
+
+            for (const auto& image : pending->images) {
+                uploadedBytes += image.getSize();
+            }
+            upload(*pending);
+            pendingCount--;
+            uploaded++;
+        }
+
+        return uploaded;
+    }
+
+    void TextureLoader::finish()
+    {
+        while (pendingCount > 0) {
+            {
+                std::unique_lock lock(decodedMutex);
+                decodedReady.wait(lock, [this] { return !decoded.empty(); });
+            }
+            processUploads(std::numeric_limits<size_t>::max());
+        }
+    }
+
+    void TextureLoader::startWorkers()
+    {
+        // Leave a core for the main thread. hardware_concurrency() may be 0.
+        uint32_t count = std::max(2u, std::thread::hardware_concurrency()) - 1;
+        for (uint32_t i = 0; i < count; i++) {
+            workers.emplace_back(
+              [this](std::stop_token stopToken) { workerLoop(stopToken); });
+        }
+    }
+
+    void TextureLoader::workerLoop(std::stop_token stopToken)
+    {
+        while (true) {
+            Job job;
+            {
+                std::unique_lock lock(jobMutex);
+                if (!jobReady.wait(
+                      lock, stopToken, [this] { return !jobs.empty(); })) {
+                    return;
+                }
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+
+            PendingTexture& pending = *job.texture;
+            pending.images[job.imageIndex] =
+              Texture::decodeImage(pending.filePaths[job.imageIndex]);
+
+            // The last image to finish hands the texture to the GL thread
+            if (pending.remaining.fetch_sub(1) == 1) {
+                {
+                    std::lock_guard lock(decodedMutex);
+                    decoded.push_back(std::move(job.texture));
+                }
+                decodedReady.notify_one();
+            }
+        }
+    }
+
+    void TextureLoader::upload(PendingTexture& pending)
+    {
+        // Deleted while it was decoding
+        Texture* texture = TextureManager::getTexture(pending.handle);
+        if (!texture) {
+            return;
+        }
+
+        // The texture stays pending, so the default texture is bound instead
+        for (uint32_t i = 0; i < pending.images.size(); i++) {
+            if (!pending.images[i].isValid()) {
+                WARN("TextureLoader::upload: Failed to load texture '{}' at "
+                     "path '{}'",
+                     texture->getName(),
+                     pending.filePaths[i]);
+                return;
+            }
+        }
+
+        if (pending.images.size() != 1) {
+            texture->uploadCubeMap(pending.images, pending.filePaths);
+            return;
+        }
+
+        // Streamed textures only upload their low mips now
+        if (Texture::isStreamable(pending.images[0])) {
+            texture->uploadStreamed(std::move(pending.images[0]));
+            return;
+        }
+
+        const Texture::Image& image = pending.images[0];
+        GLuint unpackBuffer = 0;
+        if (usePixelBuffers) {
+            if (!pixelBuffer) {
+                glCreateBuffers(1, &pixelBuffer);
+            }
+
+            // Orphan the previous storage, so the copy below does not wait for
+            // the driver to finish reading the last upload
+            auto size = (GLsizeiptr)image.getSize();
+            glNamedBufferData(pixelBuffer, size, nullptr, GL_STREAM_DRAW);
+            void* mapped = glMapNamedBufferRange(
+              pixelBuffer,
+              0,
+              size,
+              GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+            if (mapped) {
+                auto* destination = static_cast<unsigned char*>(mapped);
+                for (const auto& level : image.levels) {
+                    std::memcpy(destination, level.data(), level.size());
+                    destination += level.size();
+                }
+                if (glUnmapNamedBuffer(pixelBuffer)) {
+                    unpackBuffer = pixelBuffer;
+                }
+            }
+        }
+
+        texture->upload2D(image, unpackBuffer);
+    }
+} // namespace FW
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "pch.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Texture.h"
+#include "TextureManager.h"
+
+namespace FW {
+    /**
+     * Decodes textures on worker threads and uploads them on the GL thread.
+     *
+     * Each image file is decoded as a separate job, so the six faces of a
+     * cube map are decoded in parallel too. Decoded textures wait in a queue
+     * until processUploads() is called on the thread owning the GL context.
+     * That call stops once it has uploaded its byte budget, so a level full
+     * of textures is spread over several frames instead of stalling one.
+     *
+     * Use it through TextureManager::loadTexture2DAsync() and
+     * TextureManager::loadCubeMapAsync() rather than directly.
+     */
+    class TextureLoader {
+    public:
+        static TextureLoader& get() {
+            static TextureLoader s;
+            return s;
+        }
+
+        TextureLoader(const TextureLoader&) = delete;
+        TextureLoader& operator=(const TextureLoader&) = delete;
+
+        /**
+         * Decode `filePaths` in the background and upload them to the pending
+         * texture `handle`. One path loads a 2D texture, six a cube map.
+         *
+         * If the texture is deleted before it is uploaded, the decoded pixels
+         * are dropped.
+         */
+        void request(TextureHandle handle, std::vector<std::string> filePaths);
+
+        /**
+         * Upload decoded textures until `byteBudget` bytes have been
+         * uploaded. At least one texture is uploaded if any is waiting, so
+         * large textures still make progress.
+         *
+         * Must be called from the thread owning the GL context.
+         *
+         * @return The number of textures uploaded.
+         */
+        uint32_t processUploads(size_t byteBudget);
+
+        /** Block until every requested texture has been uploaded. */
+        void finish();
+
+        /** Number of textures requested but not uploaded yet. */
+        uint32_t getPendingCount() const { return pendingCount; }
+
+        /**
+         * Stage uploads through a pixel unpack buffer, letting the driver
+         * copy to the GPU asynchronously. Off by default.
+         */
+        void setUsePixelBuffers(bool enable) { usePixelBuffers = enable; }
+
+    private:
+        TextureLoader() = default;
+        ~TextureLoader();
+
+        /** A texture waiting for its images to be decoded. */
+        struct PendingTexture {
+            TextureHandle handle;
+            std::vector<std::string> filePaths;
+            std::vector<Texture::Image> images;
+            std::atomic<uint32_t> remaining = 0;
+        };
+
+        /** Decode one image of a pending texture. */
+        struct Job {
+            std::shared_ptr<PendingTexture> texture;
+            uint32_t imageIndex = 0;
+        };
+
+        void startWorkers();
+        void workerLoop(std::stop_token stopToken);
+        void upload(PendingTexture& pending);
+
+    private:
+        std::vector<std::jthread> workers;
+
+        std::mutex jobMutex;
+        std::condition_variable_any jobReady;
+        std::deque<Job> jobs;
+
+        /** Fully decoded textures, in the order they finished. */
+        std::mutex decodedMutex;
+        std::condition_variable decodedReady;
+        std::deque<std::shared_ptr<PendingTexture>> decoded;
+
+        std::atomic<uint32_t> pendingCount = 0;
+
+        bool usePixelBuffers = false;
+        GLuint pixelBuffer = 0;
+    };
+} // namespace FW
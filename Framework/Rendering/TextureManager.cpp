@@ -1,44 +1,54 @@
 #include "TextureManager.h"
+#include "TextureLoader.h"
 #include "Log.h"
 #include "Shader.h"
 
+#include <algorithm>
+#include <filesystem>
+
 namespace FW {
     std::vector<ref<Texture>> TextureManager::textures;
+    std::vector<uint32_t> TextureManager::textureSlots;
+    std::vector<TextureManager::Slot> TextureManager::slots;
+    std::vector<uint32_t> TextureManager::freeSlots;
+    std::unordered_map<std::string, TextureHandle> TextureManager::byName;
+    std::unordered_map<std::string, std::deque<TextureHandle>>
+      TextureManager::shadowedNames;
+    std::unordered_map<std::string, TextureHandle> TextureManager::byPath;
+    std::unordered_map<uint32_t, TextureHandle> TextureManager::byID;
     uint32_t TextureManager::invalidTextureID = 0;
+    uint64_t TextureManager::frame = 1;
+    size_t TextureManager::memoryBudget = 0;
 
     void TextureManager::bind(const std::string& name,
                               int textureSlot)
     {
-        // Bind to the first texture with the given name.
-        int index = 0;
-        for (auto& texture : textures) {
-            if (texture->name == name) {
-                texture->bind(textureSlot);
-                return;
-            }
-            index++;
-        }
-
-        textures[0]->bind(textureSlot);
+        bind(getHandle(name), textureSlot);
     }
 
     void TextureManager::bind(uint32_t id, int textureSlot)
     {
-        // Bind to the first texture with the given name.
-        int index = 0;
-        for (auto& texture : textures) {
-            if (texture->textureID == id) {
-                texture->bind(textureSlot);
-                return;
-            }
-            index++;
+        bind(getHandle(id), textureSlot);
+    }
+
+    void TextureManager::bind(TextureHandle handle, int textureSlot)
+    {
+        Texture* texture = getTexture(handle);
+        if (texture && texture->isReady()) {
+            texture->lastUsedFrame = frame;
+            texture->bind(textureSlot);
+        } else {
+            // The shader might expect a texture, and the first one should be
+            // a white texture
+            bindDefault(textureSlot);
         }
+    }
 
-        // The shader might expect a texture, and the first one should be a
-        // white texture
+    void TextureManager::bindDefault(int textureSlot)
+    {
         if (!textures.empty()) {
             textures[0]->bind(textureSlot);
-        } 
+        }
         // else {
         //     WARN("TextureManager::bind(): The first texture should be white, "
         //          "but no texture was found");
@@ -50,10 +60,16 @@ namespace FW {
     {
         // If a texture with the same filepath already exists, then don't load
         // it.
+        std::string path = canonicalPath(filepath);
+        TextureHandle handle = getHandleByCanonicalPath(path);
+        if (Texture* existing = getTexture(handle)) {
+            addName(name, handle);
+            return existing->textureID;
+        }
 
         ref<Texture> t = createRef<Texture>();
         t->loadTexture2D(name, filepath);
-        textures.push_back(t);
+        add(t, path);
         return t->textureID;
     }
 
@@ -81,17 +97,160 @@ namespace FW {
 
         ref<Texture> t = createRef<Texture>();
         t->loadCubeMap(name, filePaths);
-        textures.push_back(t);
+        add(t);
         return t->textureID;
     }
 
+    TextureHandle TextureManager::loadTexture2DAsync(
+      const std::string& name,
+      const std::string& filepath)
+    {
+        std::string path = canonicalPath(filepath);
+        TextureHandle existing = getHandleByCanonicalPath(path);
+        if (getTexture(existing)) {
+            addName(name, existing);
+            return existing;
+        }
+
+        ref<Texture> t = createRef<Texture>();
+        t->createPendingTexture2D(name, filepath);
+        TextureHandle handle = add(t, path);
+        TextureLoader::get().request(handle, { filepath });
+        return handle;
+    }
+
+    void TextureManager::loadTexture2DAsync(
+      const std::initializer_list<TexturePath>& texturePath)
+    {
+        for (const auto& tex : texturePath) {
+            loadTexture2DAsync(tex.name, tex.filePath);
+        }
+    }
+
+    TextureHandle TextureManager::loadCubeMapAsync(
+      const std::string& name,
+      const std::vector<std::string>& filePaths)
+    {
+        if (filePaths.size() != 6) {
+            WARN("TextureManager::loadCubeMapAsync: Failed to load texture "
+                 "\'{}\'. Provided {} file paths, but 6 is required.",
+                 name,
+                 filePaths.size());
+            return {};
+        }
+
+        ref<Texture> t = createRef<Texture>();
+        t->createPendingCubeMap(name);
+        TextureHandle handle = add(t);
+        TextureLoader::get().request(handle, filePaths);
+        return handle;
+    }
+
+    bool TextureManager::isReady(TextureHandle handle)
+    {
+        Texture* texture = getTexture(handle);
+        return texture && texture->isReady();
+    }
+
+    uint32_t TextureManager::processUploads(size_t byteBudget)
+    {
+        uint32_t uploaded = TextureLoader::get().processUploads(byteBudget);
+        updateStreaming(byteBudget);
+        frame++;
+        return uploaded;
+    }
+
+    void TextureManager::setMemoryBudget(size_t bytes)
+    {
+        memoryBudget = bytes;
+    }
+
+    size_t TextureManager::getResidentSize()
+    {
+        return Texture::totalResidentSize;
+    }
+
+    void TextureManager::updateStreaming(size_t byteBudget)
+    {
+        // Streamed textures that can give a level back, least recently used
+        // last. Sorted once, so evicting a level costs O(1).
+        std::vector<Texture*> evictable;
+        if (memoryBudget) {
+            for (const auto& texture : textures) {
+                if (texture->isStreamed() &&
+                    texture->residentLevel < texture->persistentLevel) {
+                    evictable.push_back(texture.get());
+                }
+            }
+            std::ranges::sort(evictable, [](Texture* a, Texture* b) {
+                return a->lastUsedFrame > b->lastUsedFrame;
+            });
+        }
+
+        // The budget may have been lowered, or non-streamed textures loaded
+        while (memoryBudget && getResidentSize() > memoryBudget) {
+            if (!evictLeastRecentlyUsed(evictable,
+                                        std::numeric_limits<uint64_t>::max())) {
+                break;
+            }
+        }
+
+        // Refine what was drawn since the last call, one level at a time
+        size_t streamed = 0;
+        for (const auto& texture : textures) {
+            size_t size = texture->getNextLevelSize();
+            if (size == 0 || texture->lastUsedFrame != frame) {
+                continue;
+            }
+            if (streamed > 0 && streamed + size > byteBudget) {
+                break;
+            }
+
+            // Make room by dropping levels nobody looked at this frame
+            while (memoryBudget && getResidentSize() + size > memoryBudget) {
+                if (!evictLeastRecentlyUsed(evictable, frame)) {
+                    break;
+                }
+            }
+            if (memoryBudget && getResidentSize() + size > memoryBudget) {
+                continue;
+            }
+
+            texture->streamIn();
+            streamed += size;
+        }
+    }
+
+    size_t TextureManager::evictLeastRecentlyUsed(
+      std::vector<Texture*>& evictable,
+      uint64_t frame)
+    {
+        while (!evictable.empty() && evictable.back()->lastUsedFrame < frame) {
+            Texture* texture = evictable.back();
+            size_t before = texture->getResidentSize();
+            bool evicted = texture->streamOut();
+            if (texture->residentLevel >= texture->persistentLevel) {
+                evictable.pop_back();
+            }
+            if (evicted) {
+                return before - texture->getResidentSize();
+            }
+        }
+        return 0;
+    }
+
+    void TextureManager::finishUploads()
+    {
+        TextureLoader::get().finish();
+    }
+
     uint32_t TextureManager::createTexture(const std::string& name,
                                            uint32_t hexColors,
                                            glm::vec2 size)
     {
         ref<Texture> t = createRef<Texture>();
         t->createTexture(name, hexColors, size);
-        textures.push_back(t);
+        add(t);
         return t->textureID;
     }
 
@@ -101,63 +260,209 @@ namespace FW {
     {
         ref<Texture> t = createRef<Texture>();
         t->createTexture(name, rgbColors, size);
-        textures.push_back(t);
+        add(t);
         return t->textureID;
     }
 
 
+    uint32_t TextureManager::createTexture(const std::string& name,
+                                           const Texture::Image& image)
+    {
+        ref<Texture> t = createRef<Texture>();
+        t->createTexture(name, image);
+        add(t);
+        return t->textureID;
+    }
+
     uint32_t TextureManager::getTextureID(const std::string& name)
     {
-        for (const auto& texture : textures) {
-            if (texture->name == name) {
-                return texture->getTextureId();
-            }
+        if (Texture* texture = getTexture(getHandle(name))) {
+            return texture->getTextureId();
         }
 
         return invalidTextureID;
     }
 
     std::string TextureManager::getTextureName(const uint32_t id) {
-        for (const auto& texture : textures) {
-            if (texture->textureID == id) {
-                return texture->name;
-            }
+        if (Texture* texture = getTexture(getHandle(id))) {
+            return texture->name;
         }
 
         return "";
     }
 
+    TextureHandle TextureManager::getHandle(const std::string& name)
+    {
+        auto it = byName.find(name);
+        return it != byName.end() ? it->second : TextureHandle{};
+    }
+
+    TextureHandle TextureManager::getHandle(uint32_t id)
+    {
+        auto it = byID.find(id);
+        return it != byID.end() ? it->second : TextureHandle{};
+    }
 
-    bool TextureManager::deleteTexture(const std::string& name)
+    TextureHandle TextureManager::getHandleByPath(const std::string& filepath)
     {
-        for (int i = 0; i < textures.size(); i++) {
-            if (textures[i]->name == name) {
-                // Name matches and texture was found
-                textures.erase(textures.begin() + i);
-                return true;
-            }
+        return getHandleByCanonicalPath(canonicalPath(filepath));
+    }
+
+    TextureHandle TextureManager::getHandleByCanonicalPath(
+      const std::string& path)
+    {
+        auto it = byPath.find(path);
+        return it != byPath.end() ? it->second : TextureHandle{};
+    }
+
+    Texture* TextureManager::getTexture(TextureHandle handle)
+    {
+        if (handle.isNull() || handle.index >= slots.size() ||
+            slots[handle.index].generation != handle.generation) {
+            return nullptr;
         }
+        return slots[handle.index].texture.get();
+    }
 
-        // No texture matches the name
-        return false;
+    bool TextureManager::deleteTexture(const std::string& name)
+    {
+        return remove(getHandle(name));
     }
 
     bool TextureManager::deleteTexture(const int id)
     {
-        for (int i = 0; i < textures.size(); i++) {
-            if (textures[i]->textureID == id) {
-                // Name matches and texture was found
-                textures.erase(textures.begin() + i);
-                return true;
+        return remove(getHandle((uint32_t)id));
+    }
+
+    void TextureManager::clearTextures()
+    {
+        for (uint32_t i = 0; i < slots.size(); i++) {
+            if (slots[i].texture) {
+                slots[i].texture = nullptr;
+                slots[i].path.clear();
+                slots[i].names.clear();
+                slots[i].generation++;
+                freeSlots.push_back(i);
             }
         }
 
-        // No texture matches the name
-        return false;
+        textures.clear();
+        textureSlots.clear();
+        byName.clear();
+        shadowedNames.clear();
+        byPath.clear();
+        byID.clear();
     }
 
     const std::vector<ref<Texture>>& TextureManager::getTextures()
     {
         return textures;
     }
+
+    TextureHandle TextureManager::add(ref<Texture> texture,
+                                      const std::string& path)
+    {
+        uint32_t index;
+        if (!freeSlots.empty()) {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            index = (uint32_t)slots.size();
+            slots.emplace_back();
+        }
+
+        Slot& slot = slots[index];
+        slot.texture = texture;
+        slot.path = path;
+        slot.position = (uint32_t)textures.size();
+
+        TextureHandle handle{ index, slot.generation };
+        // Names are not unique. Like before, the first texture keeps it.
+        if (!addName(texture->name, handle)) {
+            std::deque<TextureHandle>& waiting = shadowedNames[texture->name];
+            std::erase_if(waiting, [](TextureHandle other) {
+                return !getTexture(other);
+            });
+            waiting.push_back(handle);
+        }
+        byID[texture->textureID] = handle;
+        if (!path.empty()) {
+            byPath[path] = handle;
+        }
+
+        textures.push_back(std::move(texture));
+        textureSlots.push_back(index);
+        return handle;
+    }
+
+    bool TextureManager::remove(TextureHandle handle)
+    {
+        Texture* texture = getTexture(handle);
+        if (!texture) {
+            return false;
+        }
+
+        Slot& slot = slots[handle.index];
+        byID.erase(texture->textureID);
+        if (!slot.path.empty()) {
+            byPath.erase(slot.path);
+        }
+
+        // Swap the last texture into the gap
+        uint32_t position = slot.position;
+        textures[position] = std::move(textures.back());
+        textures.pop_back();
+        textureSlots[position] = textureSlots.back();
+        textureSlots.pop_back();
+        if (position < textures.size()) {
+            slots[textureSlots[position]].position = position;
+        }
+
+        std::vector<std::string> names = std::move(slot.names);
+        slot.names.clear();
+        slot.texture = nullptr;
+        slot.path.clear();
+        slot.generation++;
+        freeSlots.push_back(handle.index);
+
+        // A texture may be known by several names, see loadTexture2D(). Hand
+        // each over to the oldest live texture created with it.
+        for (const std::string& name : names) {
+            byName.erase(name);
+
+            auto shadowed = shadowedNames.find(name);
+            if (shadowed == shadowedNames.end()) {
+                continue;
+            }
+            std::deque<TextureHandle>& waiting = shadowed->second;
+            while (!waiting.empty() && !getTexture(waiting.front())) {
+                waiting.pop_front();
+            }
+            if (!waiting.empty()) {
+                addName(name, waiting.front());
+                waiting.pop_front();
+            }
+            if (waiting.empty()) {
+                shadowedNames.erase(shadowed);
+            }
+        }
+        return true;
+    }
+
+    bool TextureManager::addName(const std::string& name, TextureHandle handle)
+    {
+        if (!byName.try_emplace(name, handle).second) {
+            return false;
+        }
+        slots[handle.index].names.push_back(name);
+        return true;
+    }
+
+    std::string TextureManager::canonicalPath(const std::string& filepath)
+    {
+        std::error_code error;
+        std::filesystem::path path =
+          std::filesystem::weakly_canonical(filepath, error);
+        return error ? filepath : path.string();
+    }
 } // namespace Framework
@@ -2,7 +2,10 @@
 
 #include "pch.h"
 
+#include <cstddef>
+#include <deque>
 #include <limits>
+#include <unordered_map>
 
 // External
 #include <glm/glm.hpp>
@@ -13,6 +16,25 @@
 class Shader;
 
 namespace FW {
+    /**
+     * Stable reference to a texture owned by the \ref TextureManager
+     * "TextureManager".
+     *
+     * Like \ref EntityHandle "EntityHandle", a handle is a slot index plus
+     * the generation of that slot. Deleting the texture bumps the generation,
+     * so stale handles resolve to nothing instead of to whatever texture
+     * reuses the slot. The default handle is never valid.
+     */
+    struct TextureHandle {
+        uint32_t index = 0;
+        uint32_t generation = 0;
+
+        /** True for the default handle, which is never issued. */
+        bool isNull() const { return generation == 0; }
+
+        bool operator==(const TextureHandle&) const = default;
+    };
+
     /**
      * Container for Texture objects.
      *
@@ -26,6 +48,12 @@ namespace FW {
      * <u>clearTextures()</u> function to synchronously delete all textures.
      * Please note that this is <b>NOT</b> thread safe.
      *
+     * @details <h1>Lookups</h1>
+     * Textures are indexed by name, by file path and by ID, so binding and
+     * lookups are hash lookups. Loading a file that is already loaded returns
+     * the existing texture instead of reading it again. Paths are compared in
+     * their canonical form.
+     *
      * @details <h1>Usage</h1>
      * To load a new texture from disk, use one of the <u>load*()</u> methods.
      * To create a new texture programmatically, use one of the <u>create*()</u>
@@ -67,11 +95,14 @@ namespace FW {
 
     public:
         /**
-         * Load a texture from disk.
+         * Load a texture from disk, with every mip level.
          *
          * @param name The texture's name. This name is used to refer to the
          * texture when binding it.
          * @param filepath File path to the texture on disk.
+         * @return The texture's ID. If the file is already loaded, the
+         * existing texture's ID is returned and `name` becomes another name
+         * for it.
          */
         static uint32_t loadTexture2D(const std::string& name,
                                       const std::string& filepath);
@@ -105,6 +136,73 @@ namespace FW {
         static uint32_t loadCubeMap(const std::string& name,
                                     const std::vector<std::string>& filePaths);
 
+        /**
+         * Load a texture from disk without blocking.
+         *
+         * @details The file is decoded on a worker thread and uploaded by a
+         * later call to processUploads(). The handle and the texture's ID are
+         * valid right away, but the default texture is bound in its place
+         * until isReady() returns true. Files that are already loaded, or
+         * being loaded, are not read again.
+         *
+         * @details Images with a mip chain in the \ref TextureCache
+         * "TextureCache" are streamed: only the levels up to
+         * Texture::streamingBaseSize are uploaded at first, and
+         * processUploads() adds larger ones while the texture is drawn.
+         * loadTexture2D() always uploads every level.
+         *
+         * @param name The texture's name.
+         * @param filepath File path to the texture on disk.
+         * @return Handle of the pending texture.
+         */
+        static TextureHandle loadTexture2DAsync(const std::string& name,
+                                                const std::string& filepath);
+
+        /** Load a list of textures from disk without blocking. */
+        static void loadTexture2DAsync(
+          const std::initializer_list<TexturePath>& texturePath);
+
+        /** Non-blocking counterpart of loadCubeMap(). */
+        static TextureHandle loadCubeMapAsync(
+          const std::string& name,
+          const std::vector<std::string>& filePaths);
+
+        /** True if the texture exists and its pixels have been uploaded. */
+        static bool isReady(TextureHandle handle);
+
+        /**
+         * Upload textures decoded in the background and stream mip levels.
+         *
+         * @details Call this once per frame from the thread owning the GL
+         * context. Uploads stop after `byteBudget` bytes, so large batches of
+         * textures are spread over several frames. At least one texture is
+         * uploaded per call if any is waiting.
+         *
+         * @details Streamed textures that were bound since the last call get
+         * their next larger mip level, within the same byte budget. If that
+         * would exceed the memory budget, the largest level of the least
+         * recently bound texture is dropped first.
+         *
+         * @return The number of textures uploaded.
+         */
+        static uint32_t processUploads(size_t byteBudget = defaultUploadBudget);
+
+        /**
+         * Limit the texture memory used by streamed textures. Textures that
+         * are not streamed count against the budget, but are never evicted.
+         *
+         * @param bytes The budget in bytes, or 0 for no limit.
+         */
+        static void setMemoryBudget(size_t bytes);
+
+        static size_t getMemoryBudget() { return memoryBudget; }
+
+        /** Estimated texture memory in use, in bytes. */
+        static size_t getResidentSize();
+
+        /** Block until every texture loaded asynchronously is uploaded. */
+        static void finishUploads();
+
         /**
          * Create a new texture in memory.
          *
@@ -139,6 +237,17 @@ namespace FW {
                                       glm::vec3 rgbColors,
                                       glm::vec2 size);
 
+        /**
+         * Create a new texture from pixels generated at runtime, like the
+         * pages of a \ref TextureAtlas "TextureAtlas".
+         *
+         * @param name The texture's name. This is used when binding.
+         * @param image The pixels to upload.
+         * @return Texture ID.
+         */
+        static uint32_t createTexture(const std::string& name,
+                                      const Texture::Image& image);
+
         /**
          * Get the texture's ID by name.
          * @param name The texture's name
@@ -148,6 +257,21 @@ namespace FW {
 
         static std::string getTextureName(const uint32_t id);
 
+        /** Get the handle of the texture called `name`, or a null handle. */
+        static TextureHandle getHandle(const std::string& name);
+
+        /** Get the handle of the texture with ID `id`, or a null handle. */
+        static TextureHandle getHandle(uint32_t id);
+
+        /**
+         * Get the handle of the texture loaded from `filepath`, or a null
+         * handle if that file has not been loaded.
+         */
+        static TextureHandle getHandleByPath(const std::string& filepath);
+
+        /** Resolve a handle. Returns nullptr if the texture was deleted. */
+        static Texture* getTexture(TextureHandle handle);
+
         /**
          * Bind the texture by its name.
          *
@@ -170,6 +294,14 @@ namespace FW {
          */
         static void bind(uint32_t id, int textureSlot);
 
+        /**
+         * Bind the texture by its handle.
+         *
+         * @details If the handle is stale or the texture is still loading,
+         * the default texture is bound.
+         */
+        static void bind(TextureHandle handle, int textureSlot);
+
         /**
          * Delete and clear all textures.
          *
@@ -177,7 +309,7 @@ namespace FW {
          * be loaded or created, or the GLFW application can safely be
          * terminated.
          */
-        static void clearTextures() { textures.clear(); }
+        static void clearTextures();
 
         /**
          * Delete a texture.
@@ -209,11 +341,89 @@ namespace FW {
 
         static const int getInvalidTextureID() { return invalidTextureID; }
 
+    public:
+        /** Bytes processUploads() uploads per call by default. */
+        static constexpr size_t defaultUploadBudget = 8 * 1024 * 1024;
+
+    private:
+        struct Slot {
+            ref<Texture> texture;
+            uint32_t generation = 1;
+            /// Canonical path the texture was loaded from, if any.
+            std::string path;
+            /// Names that resolve to this slot in `byName`.
+            std::vector<std::string> names;
+            /// Index of the texture in `textures`.
+            uint32_t position = 0;
+        };
+
+        /** Take ownership of `texture` and index it. */
+        static TextureHandle add(ref<Texture> texture,
+                                 const std::string& path = "");
+
+        static bool remove(TextureHandle handle);
+
+        /**
+         * Let `name` resolve to `handle`, unless another texture has it.
+         *
+         * @return False if the name was taken.
+         */
+        static bool addName(const std::string& name, TextureHandle handle);
+
+        /** Bind the first texture, which is expected to be white. */
+        static void bindDefault(int textureSlot);
+
+        /**
+         * Resolve `filepath` against the file system. This costs several
+         * system calls, so do it once per lookup.
+         */
+        static std::string canonicalPath(const std::string& filepath);
+
+        /** Like getHandleByPath(), for a path already made canonical. */
+        static TextureHandle getHandleByCanonicalPath(const std::string& path);
+
+        /** Stream in used textures and evict unused ones. */
+        static void updateStreaming(size_t byteBudget);
+
+        /**
+         * Drop the largest level of the least recently used texture in
+         * `evictable` that was not used since `frame`.
+         *
+         * @param evictable Streamed textures sorted by the frame they were
+         * last used in, most recent first. Textures left with nothing to give
+         * back are removed.
+         * @return The bytes freed, or 0 if no texture could give a level back.
+         */
+        static size_t evictLeastRecentlyUsed(std::vector<Texture*>& evictable,
+                                             uint64_t frame);
+
     private:
-        // TODO: textures should be a map. This forces their name to be unique.
+        /**
+         * Live textures. The first one created stays first, the others are
+         * swapped around as textures are removed.
+         */
         static std::vector<std::shared_ptr<Texture>> textures;
+        /** Slot of each entry in `textures`. */
+        static std::vector<uint32_t> textureSlots;
+
+        static std::vector<Slot> slots;
+        static std::vector<uint32_t> freeSlots;
+
+        static std::unordered_map<std::string, TextureHandle> byName;
+        /**
+         * Textures created with a name another texture had, oldest first.
+         * They get the name when its owner is removed.
+         */
+        static std::unordered_map<std::string, std::deque<TextureHandle>>
+          shadowedNames;
+        static std::unordered_map<std::string, TextureHandle> byPath;
+        static std::unordered_map<uint32_t, TextureHandle> byID;
 
         static uint32_t invalidTextureID;
+
+        /** Incremented by processUploads(), to track when textures are used. */
+        static uint64_t frame;
+        static size_t memoryBudget;
     };
 
 } // Framework
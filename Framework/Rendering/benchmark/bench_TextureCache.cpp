@@ -0,0 +1,99 @@
+/**
+ * Compare texture decoding on a cold and a warm TextureCache.
+ *
+ * Loads every image of the Sokoban and physics demo resource sets three
+ * times: straight from the JPG/PNG files, through an empty cache, which
+ * decodes and writes every entry, and through the filled cache. Only the CPU
+ * side of loading is measured, no GL context is created. Every byte of every
+ * level is read, like an upload would, so mapped pages are really loaded.
+ */
+
+#include "TextureCache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+static std::vector<std::string> findImages(const std::filesystem::path& root) {
+    std::vector<std::string> images;
+    for (const auto& entry :
+         std::filesystem::recursive_directory_iterator(root)) {
+        auto extension = entry.path().extension();
+        if (extension == ".jpg" || extension == ".png") {
+            images.push_back(entry.path().string());
+        }
+    }
+    return images;
+}
+
+/** Load every image and return the time taken, in milliseconds. */
+static double loadAll(const std::vector<std::string>& images,
+                      std::size_t& bytes) {
+    auto start = std::chrono::steady_clock::now();
+
+    unsigned checksum = 0;
+    bytes = 0;
+    for (const auto& path : images) {
+        FW::Texture::Image image = FW::Texture::decodeImage(path);
+        for (const auto& level : image.levels) {
+            for (unsigned char value : level) {
+                checksum += value;
+            }
+            bytes += level.size();
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    // Keep the reads from being optimised away
+    if (checksum == 1) {
+        std::printf(" ");
+    }
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main() {
+    std::filesystem::path cacheDir =
+      std::filesystem::temp_directory_path() / "yagi_bench_texture_cache";
+    FW::TextureCache::setDirectory(cacheDir);
+
+    std::printf("%-12s %7s %14s %14s %14s %10s\n",
+                "set",
+                "images",
+                "uncached",
+                "cold cache",
+                "warm cache",
+                "cache MiB");
+
+    struct ResourceSet {
+        const char* name;
+        const char* directory;
+    };
+    for (auto [name, directory] :
+         { ResourceSet{ "Sokoban", SOKOBAN_TEXTURES_DIR },
+           ResourceSet{ "PhysicsDemo", PHYSICSDEMO_TEXTURES_DIR } }) {
+        std::vector<std::string> images = findImages(directory);
+        std::filesystem::remove_all(cacheDir);
+
+        std::size_t bytes = 0;
+        FW::TextureCache::setEnabled(false);
+        double uncached = loadAll(images, bytes);
+
+        FW::TextureCache::setEnabled(true);
+        double cold = loadAll(images, bytes);
+        double warm = loadAll(images, bytes);
+
+        std::printf("%-12s %7zu %11.1f ms %11.1f ms %11.1f ms %10.1f\n",
+                    name,
+                    images.size(),
+                    uncached,
+                    cold,
+                    warm,
+                    bytes / (1024.0 * 1024.0));
+    }
+
+    std::filesystem::remove_all(cacheDir);
+    return 0;
+}
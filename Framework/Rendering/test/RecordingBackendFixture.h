@@ -0,0 +1,17 @@
+#pragma once
+
+#include "RecordingBackend.h"
+#include "RenderCommands.h"
+
+/**
+ * Record instead of drawing, for every test in the executable. Installed
+ * once, so objects created by one test are never left to another backend.
+ */
+inline FW::RecordingBackend& getRecordingBackend() {
+    static bool installed = [] {
+        RenderCommand::setBackend(FW::createScope<FW::RecordingBackend>());
+        return true;
+    }();
+    (void)installed;
+    return static_cast<FW::RecordingBackend&>(FW::RenderBackend::get());
+}
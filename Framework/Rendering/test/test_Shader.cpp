@@ -0,0 +1,41 @@
+#include "doctest/doctest.h"
+
+#include "RecordingBackendFixture.h"
+#include "Shader.h"
+
+static const char* vertexSource = R"(
+#version 430 core
+uniform mat4 u_model;
+uniform mat3 u_normalMatrix;
+uniform int u_count;
+uniform bool u_lit;
+void main() {}
+)";
+
+static const char* fragmentSource = R"(
+#version 430 core
+uniform sampler2D u_texture;
+uniform float u_shininess;
+void main() {}
+)";
+
+TEST_CASE("Uniform handles are only valid for the uniform's type") {
+    getRecordingBackend();
+    FW::Shader shader(FW::Shader::linkProgram(vertexSource, fragmentSource));
+
+    CHECK(shader.getUniform<glm::mat4>("u_model").isValid());
+    CHECK(shader.getUniform<float>("u_shininess").isValid());
+
+    // Integers, booleans and samplers are all set as integers
+    CHECK(shader.getUniform<int>("u_count").isValid());
+    CHECK(shader.getUniform<int>("u_lit").isValid());
+    CHECK(shader.getUniform<int>("u_texture").isValid());
+
+    // Matrices without a setter are not integers either
+    CHECK(!shader.getUniform<int>("u_normalMatrix").isValid());
+    CHECK(!shader.getUniform<int>("u_model").isValid());
+    CHECK(!shader.getUniform<int>("u_shininess").isValid());
+    CHECK(!shader.getUniform<float>("u_count").isValid());
+    CHECK(!shader.getUniform<glm::mat4>("u_normalMatrix").isValid());
+    CHECK(!shader.getUniform<float>("u_missing").isValid());
+}
@@ -0,0 +1,48 @@
+#include "doctest/doctest.h"
+
+#include "RecordingBackendFixture.h"
+#include "TextureManager.h"
+
+static FW::TextureHandle createTexture(const std::string& name) {
+    uint32_t id = FW::TextureManager::createTexture(
+      name, { 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f });
+    return FW::TextureManager::getHandle(id);
+}
+
+TEST_CASE("Deleted textures hand their name to the next texture with it") {
+    getRecordingBackend();
+    FW::TextureHandle first = createTexture("shared");
+    FW::TextureHandle second = createTexture("shared");
+    FW::TextureHandle third = createTexture("shared");
+    REQUIRE(FW::TextureManager::getHandle("shared") == first);
+
+    // Deleting a texture that does not own the name keeps it
+    CHECK(FW::TextureManager::deleteTexture(
+      (int)FW::TextureManager::getTexture(second)->getTextureId()));
+    CHECK(FW::TextureManager::getHandle("shared") == first);
+
+    CHECK(FW::TextureManager::deleteTexture("shared"));
+    CHECK(FW::TextureManager::getHandle("shared") == third);
+
+    CHECK(FW::TextureManager::deleteTexture("shared"));
+    CHECK(FW::TextureManager::getHandle("shared").isNull());
+}
+
+TEST_CASE("Deleting a texture keeps the others") {
+    getRecordingBackend();
+    size_t count = FW::TextureManager::getTextures().size();
+    FW::TextureHandle a = createTexture("a");
+    FW::TextureHandle b = createTexture("b");
+    FW::TextureHandle c = createTexture("c");
+
+    CHECK(FW::TextureManager::deleteTexture("a"));
+    CHECK(!FW::TextureManager::getTexture(a));
+    CHECK(FW::TextureManager::getTextures().size() == count + 2);
+
+    // The texture swapped into the gap can still be deleted
+    CHECK(FW::TextureManager::deleteTexture("c"));
+    CHECK(FW::TextureManager::getTexture(b));
+    CHECK(!FW::TextureManager::getTexture(c));
+    CHECK(FW::TextureManager::deleteTexture("b"));
+    CHECK(FW::TextureManager::getTextures().size() == count);
+}
@@ -0,0 +1,145 @@
+#include "doctest/doctest.h"
+
+#include "RecordingBackendFixture.h"
+#include "TextureCache.h"
+#include "TextureManager.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+/** Record instead of uploading, and cache decoded images in a temp folder. */
+static FW::RecordingBackend& getBackend() {
+    static bool installed = [] {
+        getRecordingBackend();
+        FW::TextureManager::createTexture(
+          "default", { 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f });
+        FW::TextureCache::setEnabled(true);
+        FW::TextureCache::setDirectory(
+          std::filesystem::temp_directory_path() / "yagi_test_texture_cache");
+        return true;
+    }();
+    (void)installed;
+    return static_cast<FW::RecordingBackend&>(FW::RenderBackend::get());
+}
+
+/** Write a grey `size` by `size` RGB image to the temp directory. */
+static std::string writeImage(const std::string& filename, int size) {
+    std::filesystem::path path =
+      std::filesystem::temp_directory_path() / filename;
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << "P6\n" << size << " " << size << "\n255\n";
+    file << std::string((size_t)size * size * 3, '\x80');
+    return path.string();
+}
+
+/** Number of uploads of a `size` by `size` RGB level. */
+static long countUploads(const FW::RecordingBackend& backend, int size) {
+    return std::ranges::count_if(
+      backend.getCommands(), [size](const FW::RecordingBackend::Command& c) {
+          return c.type == FW::RecordingBackend::Command::Type::TextureUpload &&
+                 c.value == (uint64_t)size * size * 3;
+      });
+}
+
+TEST_CASE("Blocking loads upload every level of a cached image") {
+    FW::RecordingBackend& backend = getBackend();
+    std::string path = writeImage("yagi_test_blocking.ppm", 512);
+
+    backend.clear();
+    FW::TextureManager::loadTexture2D("blocking", path);
+
+    auto handle = FW::TextureManager::getHandle("blocking");
+    FW::Texture* texture = FW::TextureManager::getTexture(handle);
+    REQUIRE(texture);
+    CHECK(!texture->isStreamed());
+    CHECK(countUploads(backend, 512) == 1);
+    CHECK(countUploads(backend, 256) == 1);
+    CHECK(countUploads(backend, 128) == 1);
+
+    FW::TextureManager::deleteTexture("blocking");
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Asynchronous loads stream in larger levels while they are drawn") {
+    FW::RecordingBackend& backend = getBackend();
+    std::string path = writeImage("yagi_test_streamed.ppm", 512);
+
+    backend.clear();
+    auto handle = FW::TextureManager::loadTexture2DAsync("streamed", path);
+    FW::TextureManager::finishUploads();
+    FW::Texture* texture = FW::TextureManager::getTexture(handle);
+    REQUIRE(texture);
+    REQUIRE(texture->isStreamed());
+    CHECK(countUploads(backend, 128) == 1);
+    CHECK(countUploads(backend, 256) == 0);
+    CHECK(countUploads(backend, 512) == 0);
+
+    // Textures that are not drawn stay at their base levels
+    FW::TextureManager::processUploads();
+    CHECK(countUploads(backend, 256) == 0);
+
+    // One larger level per frame the texture is drawn in
+    FW::TextureManager::bind(handle, 0);
+    FW::TextureManager::processUploads();
+    CHECK(countUploads(backend, 256) == 1);
+    CHECK(countUploads(backend, 512) == 0);
+
+    FW::TextureManager::bind(handle, 0);
+    FW::TextureManager::processUploads();
+    CHECK(countUploads(backend, 512) == 1);
+    CHECK(texture->getNextLevelSize() == 0);
+    CHECK(texture->getResidentSize() > (size_t)512 * 512 * 3);
+
+    FW::TextureManager::deleteTexture("streamed");
+    std::filesystem::remove(path);
+    std::filesystem::remove_all(FW::TextureCache::getDirectory());
+}
+
+TEST_CASE("Over budget, the least recently bound texture is evicted first") {
+    getBackend();
+    size_t baseline = FW::TextureManager::getResidentSize();
+    std::string evictedPath = writeImage("yagi_test_evicted.ppm", 512);
+    std::string keptPath = writeImage("yagi_test_kept.ppm", 512);
+
+    auto evicted =
+      FW::TextureManager::loadTexture2DAsync("evicted", evictedPath);
+    auto kept = FW::TextureManager::loadTexture2DAsync("kept", keptPath);
+    FW::TextureManager::finishUploads();
+    FW::TextureManager::processUploads();
+    FW::Texture* evictedTexture = FW::TextureManager::getTexture(evicted);
+    FW::Texture* keptTexture = FW::TextureManager::getTexture(kept);
+    REQUIRE(evictedTexture);
+    REQUIRE(keptTexture);
+
+    // Stream in every level of both
+    for (int i = 0; i < 2; i++) {
+        FW::TextureManager::bind(evicted, 0);
+        FW::TextureManager::bind(kept, 0);
+        FW::TextureManager::processUploads();
+    }
+    REQUIRE(evictedTexture->getNextLevelSize() == 0);
+    REQUIRE(keptTexture->getNextLevelSize() == 0);
+    CHECK(FW::TextureManager::getResidentSize() ==
+          baseline + evictedTexture->getResidentSize() +
+            keptTexture->getResidentSize());
+
+    // One byte over budget
+    FW::TextureManager::bind(kept, 0);
+    FW::TextureManager::setMemoryBudget(
+      FW::TextureManager::getResidentSize() - 1);
+    FW::TextureManager::processUploads();
+    CHECK(evictedTexture->getNextLevelSize() == (size_t)512 * 512 * 3);
+    CHECK(keptTexture->getNextLevelSize() == 0);
+    CHECK(FW::TextureManager::getResidentSize() <=
+          FW::TextureManager::getMemoryBudget());
+
+    FW::TextureManager::setMemoryBudget(0);
+    FW::TextureManager::deleteTexture("evicted");
+    FW::TextureManager::deleteTexture("kept");
+    CHECK(FW::TextureManager::getResidentSize() == baseline);
+    std::filesystem::remove(evictedPath);
+    std::filesystem::remove(keptPath);
+    std::filesystem::remove_all(FW::TextureCache::getDirectory());
+}
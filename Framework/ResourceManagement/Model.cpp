@@ -8,6 +8,7 @@
 // Framework
 #include "Model.h"
 #include "TextureManager.h"
+#include "RenderState.h"
 
 namespace FW {
 #pragma region Mesh
@@ -45,12 +46,9 @@ namespace FW {
             TextureManager::bind((uint32_t)textures[i].id, 0);
         }
 
-        glActiveTexture(GL_TEXTURE0);
-
         // Draw mesh
-        glBindVertexArray(vao);
+        RenderState::get().bindVertexArray(vao);
         glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, nullptr);
-        glBindVertexArray(0);
     }
 
     /*
@@ -62,7 +60,7 @@ namespace FW {
         glGenBuffers(1, &vbo);
         glGenBuffers(1, &ebo);
 
-        glBindVertexArray(vao);
+        RenderState::get().bindVertexArray(vao);
         glBindBuffer(GL_ARRAY_BUFFER, vbo);
 
         // Load vertices to vertex buffer
@@ -109,7 +107,7 @@ namespace FW {
                               sizeof(Vertex),
                               (void*)offsetof(Vertex, normal));
 
-        glBindVertexArray(0);
+        RenderState::get().bindVertexArray(0);
     }
 #pragma endregion
 
@@ -240,13 +238,9 @@ namespace FW {
             SimpleTexture texture;
 
             // We only load texture from disk if it doesn't already exist
-            Texture* foundTexture = nullptr;
-            for (const auto& t : TextureManager::getTextures()) {
-                if (directory + '/' + std::string(str.C_Str()) ==
-                    t->getFilepath()) {
-                    foundTexture = t.get();
-                }
-            }
+            Texture* foundTexture = TextureManager::getTexture(
+              TextureManager::getHandleByPath(directory + '/' +
+                                              std::string(str.C_Str())));
 
             // Set texture ID. Load from disk if it isn't already loaded in
             // TextureManager.
@@ -1,11 +1,207 @@
 #include "ShaderManager.h"
+#include "Files.h"
+#include "Hash.h"
 #include "Log.h"
 
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
 namespace FW {
+    /** Written at the start of every program binary cache file. */
+    struct ProgramBinaryHeader {
+        std::uint32_t magic = 0x59475042; // "YGPB"
+        /// Bumped whenever the layout of the file changes.
+        std::uint32_t version = 2;
+        std::uint32_t format = 0;
+        /// Bytes of program binary following the header.
+        std::uint32_t length = 0;
+        /// Hash of the sources the binary was linked from.
+        std::uint64_t sourceHash = 0;
+    };
+
+    /**
+     * Hash both stages of a program. The vertex source's length goes first,
+     * so pairs that split the same text at different points do not collide.
+     */
+    static std::uint64_t hashSources(const std::string& vertexSource,
+                                     const std::string& fragmentSource) {
+        std::uint64_t vertexLength = vertexSource.size();
+        std::uint64_t hash = hashFNV1a(
+          std::string_view(reinterpret_cast<const char*>(&vertexLength),
+                           sizeof(vertexLength)));
+        hash = hashFNV1a(vertexSource, hash);
+        return hashFNV1a(fragmentSource, hash);
+    }
+
     void ShaderManager::createShaderFromFiles(const std::string& name,
                                               const std::string& vertexSrc,
                                               const std::string& fragmentSrc) {
-        shaders.try_emplace(name, Shader{ vertexSrc, fragmentSrc });
+        if (shaders.contains(name)) {
+            return;
+        }
+
+        std::string vertexSource = Shader::readFile(vertexSrc);
+        std::string fragmentSource = Shader::readFile(fragmentSrc);
+        std::uint64_t sourceHash = hashSources(vertexSource, fragmentSource);
+
+        ref<Shader>& shader = programs[sourceHash];
+        if (!shader) {
+            shader = createRef<Shader>(
+              createProgram(sourceHash, vertexSource, fragmentSource));
+        }
+        shaders.emplace(name, shader);
+    }
+
+    GLuint ShaderManager::createProgram(std::uint64_t sourceHash,
+                                        const std::string& vertexSource,
+                                        const std::string& fragmentSource) {
+        GLint formatCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        if (formatCount == 0) { // The driver cannot export programs
+            return Shader::linkProgram(vertexSource, fragmentSource);
+        }
+
+        std::filesystem::path path = getProgramBinaryPath(sourceHash);
+        if (GLuint program = loadProgramBinary(path, sourceHash)) {
+            return program;
+        }
+
+        GLuint program =
+          Shader::linkProgram(vertexSource, fragmentSource, true);
+        if (program) {
+            saveProgramBinary(path, program, sourceHash);
+        }
+        return program;
+    }
+
+    GLuint ShaderManager::loadProgramBinary(const std::filesystem::path& path,
+                                            std::uint64_t sourceHash) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            return 0;
+        }
+
+        std::streamsize size = file.tellg();
+        ProgramBinaryHeader header;
+        if (size <= (std::streamsize)sizeof(header)) {
+            return 0;
+        }
+
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        // Truncated, from an older version or for other sources
+        const ProgramBinaryHeader expected;
+        if (!file || header.magic != expected.magic ||
+            header.version != expected.version ||
+            header.sourceHash != sourceHash ||
+            header.length != size - (std::streamsize)sizeof(header)) {
+            return 0;
+        }
+
+        std::vector<char> binary(header.length);
+        file.read(binary.data(), binary.size());
+        if (!file) {
+            return 0;
+        }
+
+        GLuint program = glCreateProgram();
+        glProgramBinary(
+          program, header.format, binary.data(), (GLsizei)binary.size());
+
+        // The driver may reject binaries, e.g. after an update that did not
+        // change the version string. Fall back to compiling in that case.
+        GLint success = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (!success) {
+            glDeleteProgram(program);
+            std::error_code error;
+            std::filesystem::remove(path, error);
+            return 0;
+        }
+
+        return program;
+    }
+
+    void ShaderManager::saveProgramBinary(const std::filesystem::path& path,
+                                          GLuint program,
+                                          std::uint64_t sourceHash) {
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0) {
+            return;
+        }
+
+        ProgramBinaryHeader header;
+        header.sourceHash = sourceHash;
+        std::vector<char> binary(length);
+        GLenum format = 0;
+        glGetProgramBinary(program, length, &length, &format, binary.data());
+        header.format = format;
+        header.length = (std::uint32_t)length;
+
+        std::error_code error;
+        std::filesystem::create_directories(path.parent_path(), error);
+        if (error) {
+            WARN("Unable to create shader cache directory {}: {}",
+                 path.parent_path().string(),
+                 error.message());
+            return;
+        }
+
+        // Write to a file of our own and rename it into place, so a crash or
+        // a full disk never leaves a truncated binary behind
+        std::filesystem::path temporary = path;
+        temporary += "." +
+                     std::to_string(std::hash<std::thread::id>{}(
+                       std::this_thread::get_id())) +
+                     ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(binary.data(), length);
+            file.close();
+            if (!file) {
+                WARN("Unable to write shader cache file {}",
+                     temporary.string());
+                std::filesystem::remove(temporary, error);
+                return;
+            }
+        }
+
+        std::filesystem::rename(temporary, path, error);
+        if (error) {
+            std::filesystem::remove(temporary, error);
+        }
+    }
+
+    std::filesystem::path ShaderManager::getProgramBinaryPath(
+      std::uint64_t sourceHash) {
+        if (driverHash == 0) {
+            auto getString = [](GLenum name) {
+                auto* value =
+                  reinterpret_cast<const char*>(glGetString(name));
+                return std::string(value ? value : "");
+            };
+            driverHash = hashFNV1a(getString(GL_VENDOR));
+            driverHash = hashFNV1a(getString(GL_RENDERER), driverHash);
+            driverHash = hashFNV1a(getString(GL_VERSION), driverHash);
+        }
+
+        auto dataDir = getDataDir();
+        std::filesystem::path cacheDir =
+          dataDir ? dataDir.value() / "shader_cache"
+                  : std::filesystem::temp_directory_path() / "yagi_shader_cache";
+
+        std::uint64_t key = hashFNV1a(
+          std::string_view(reinterpret_cast<const char*>(&driverHash),
+                           sizeof(driverHash)),
+          sourceHash);
+        std::stringstream filename;
+        filename << std::hex << key << ".bin";
+        return cacheDir / filename.str();
     }
 
     Shader* ShaderManager::bind(const std::string& name) {
@@ -20,7 +216,7 @@ namespace FW {
     Shader* ShaderManager::getShader(const std::string& name) {
         auto iter = shaders.find(name);
         if (iter != shaders.end()) {
-            return &iter->second;
+            return iter->second.get();
         } else {
             return nullptr;
         }
@@ -28,5 +224,6 @@ namespace FW {
 
     void ShaderManager::clear() {
         shaders.clear();
+        programs.clear();
     }
 }
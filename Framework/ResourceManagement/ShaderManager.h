@@ -2,6 +2,8 @@
 
 #include <Shader.h>
 
+#include <cstdint>
+#include <filesystem>
 #include <unordered_map>
 
 namespace FW {
@@ -36,6 +38,14 @@ namespace FW {
         ~ShaderManager() {}
 
     public:
+        /**
+         * Create a shader and register it under `name`.
+         *
+         * Nothing happens if `name` is already taken, so this is cheap to call
+         * every time an object needs the shader. Shaders with identical source
+         * code share one program, and linked programs are stored in a binary
+         * cache on disk so later runs can skip compiling GLSL.
+         */
         // TODO handle cases where creating the shader fails
         void createShaderFromFiles(const std::string& name,
                                    const std::string& vertexSrc,
@@ -45,7 +55,41 @@ namespace FW {
         Shader* bind(const std::string& name);
 
     private:
-        /** TODO find some way to avoid heap allocation */
-        std::unordered_map<std::string, Shader> shaders;
+        /**
+         * Link a program, going through the binary cache.
+         *
+         * @param sourceHash Hash of the program's source code.
+         */
+        GLuint createProgram(std::uint64_t sourceHash,
+                             const std::string& vertexSource,
+                             const std::string& fragmentSource);
+
+        /**
+         * Restore a program from the binary cache, or return 0. Files that
+         * are truncated, from another version or linked from other sources
+         * are ignored.
+         */
+        GLuint loadProgramBinary(const std::filesystem::path& path,
+                                 std::uint64_t sourceHash);
+
+        /** Store a program in the binary cache, replacing it atomically. */
+        void saveProgramBinary(const std::filesystem::path& path,
+                               GLuint program,
+                               std::uint64_t sourceHash);
+
+        /**
+         * Cache file of a program. The driver is part of the key, since
+         * binaries are only valid for the driver that produced them.
+         */
+        std::filesystem::path getProgramBinaryPath(std::uint64_t sourceHash);
+
+    private:
+        std::unordered_map<std::string, ref<Shader>> shaders;
+
+        /** Shaders by hash of their source code, shared between names. */
+        std::unordered_map<std::uint64_t, ref<Shader>> programs;
+
+        /** Hash of the GL vendor, renderer and version. 0 until queried. */
+        std::uint64_t driverHash = 0;
     };
 }
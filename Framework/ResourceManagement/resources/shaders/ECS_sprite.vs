@@ -6,11 +6,22 @@ layout(location = 1) in vec4 a_color;
 layout(location = 2) in vec2 a_texCoord;
 layout(location = 3) in vec3 a_normal;
 
-// Model - view - projection
-uniform mat4 u_view = mat4(1.0f);
-uniform mat4 u_projection = mat4(1.0f);
+// View - projection, shared by every shader. See FW::Camera::UniformData.
+layout(std140, binding = 0) uniform Camera {
+    mat4 u_projection;
+    mat4 u_view;
+    vec3 u_cameraPosition;
+    float u_nearClip;
+    float u_farClip;
+};
+
+// Model
 uniform mat4 u_model = mat4(1.0f);
 
+// Part of the texture to sample: min UV in xy, max UV in zw. Set for sprites
+// drawn from a texture atlas.
+uniform vec4 u_uvRect = vec4(0.0, 0.0, 1.0, 1.0);
+
 // Output variables down the OpenGL pipeline...
 out vec3 o_position;
 out vec4 o_color;
@@ -18,7 +29,7 @@ out vec2 o_texCoord;
 
 void main() {
     o_color = a_color;
-    o_texCoord = a_texCoord;
+    o_texCoord = mix(u_uvRect.xy, u_uvRect.zw, a_texCoord);
     o_position = a_position;
 
     gl_Position = u_projection * u_view * u_model * vec4(a_position, 1.0);
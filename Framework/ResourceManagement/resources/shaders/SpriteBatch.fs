@@ -0,0 +1,37 @@
+#version 430 core
+
+in vec4 o_color;
+in vec2 o_texCoord;
+flat in int o_texIndex;
+
+out vec4 FragColor;
+
+// Must match SpriteBatch::maxTextureSlots
+uniform sampler2D u_textures[16];
+
+void main() {
+    vec4 tex;
+
+    // Sampler arrays may only be indexed with dynamically uniform values, so
+    // select the sampler explicitly
+    switch (o_texIndex) {
+        case 0:  tex = texture(u_textures[0], o_texCoord); break;
+        case 1:  tex = texture(u_textures[1], o_texCoord); break;
+        case 2:  tex = texture(u_textures[2], o_texCoord); break;
+        case 3:  tex = texture(u_textures[3], o_texCoord); break;
+        case 4:  tex = texture(u_textures[4], o_texCoord); break;
+        case 5:  tex = texture(u_textures[5], o_texCoord); break;
+        case 6:  tex = texture(u_textures[6], o_texCoord); break;
+        case 7:  tex = texture(u_textures[7], o_texCoord); break;
+        case 8:  tex = texture(u_textures[8], o_texCoord); break;
+        case 9:  tex = texture(u_textures[9], o_texCoord); break;
+        case 10: tex = texture(u_textures[10], o_texCoord); break;
+        case 11: tex = texture(u_textures[11], o_texCoord); break;
+        case 12: tex = texture(u_textures[12], o_texCoord); break;
+        case 13: tex = texture(u_textures[13], o_texCoord); break;
+        case 14: tex = texture(u_textures[14], o_texCoord); break;
+        default: tex = texture(u_textures[15], o_texCoord); break;
+    }
+
+    FragColor = tex * o_color;
+}
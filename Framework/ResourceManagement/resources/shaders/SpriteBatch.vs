@@ -0,0 +1,29 @@
+#version 430 core
+
+// Vertex attributes. Positions are already in world space.
+layout(location = 0) in vec3 a_position;
+layout(location = 1) in vec4 a_color;
+layout(location = 2) in vec2 a_texCoord;
+layout(location = 3) in float a_texIndex;
+
+// View - projection, shared by every shader. See FW::Camera::UniformData.
+layout(std140, binding = 0) uniform Camera {
+    mat4 u_projection;
+    mat4 u_view;
+    vec3 u_cameraPosition;
+    float u_nearClip;
+    float u_farClip;
+};
+
+// Output variables down the OpenGL pipeline...
+out vec4 o_color;
+out vec2 o_texCoord;
+flat out int o_texIndex;
+
+void main() {
+    o_color = a_color;
+    o_texCoord = a_texCoord;
+    o_texIndex = int(a_texIndex);
+
+    gl_Position = u_projection * u_view * vec4(a_position, 1.0);
+}
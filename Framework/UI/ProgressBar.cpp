@@ -12,6 +12,8 @@ namespace FW::UI {
             return;
         }}
 
+        UIRoot::init();
+
         background = FW::createRef<FW::Sprite>(camera);
         foreground = FW::createRef<FW::Sprite>(camera);
 
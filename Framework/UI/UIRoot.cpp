@@ -3,7 +3,7 @@
 
 namespace FW::UI {
     void UIRoot::init() {
-        shader = "inbuilt_ecs_shader";
+        shader = DrawableComponent::spriteShaderName;
 
         // If performance becomes an issue, then find some way to avoiid trying
         // to create a new shader every time we initialise a new UI element.
@@ -12,28 +12,18 @@ namespace FW::UI {
           SHADERS_DIR + std::string("ECS_sprite.vs"),
           SHADERS_DIR + std::string("ECS_sprite.fs"));
 
-        transformationComponent = FW::createRef<FW::TransformationComponent>();
+        transformationComponent =
+          FW::createComponent<FW::TransformationComponent>();
         addComponent(transformationComponent);
         transformationComponent->setShader(shader);
     }
 
     void UIRoot::setPosition(const glm::vec2& position) {
-        glm::vec2 delta = this->position - position;
         this->position = position;
 
-        // For every child node we must add their position with our delta.
-        for (auto& childNode : getChildren()) {
-            // Transform component was for some reason not found in the
-            // child node (??) Probably not an assert, but this is a strange
-            // behaviour.
-            auto transformComponent =
-              childNode->getComponent<FW::ref<FW::TransformationComponent>>();
-
-            if (transformComponent) {
-                glm::vec3 newPosition = transformationComponent->getPosition() +
-                                        glm::vec3{ delta, 0.0f };
-                transformationComponent->setPosition(newPosition);
-            }
+        // Child transforms are relative to ours, so they follow along
+        if (transformationComponent) {
+            transformationComponent->setPosition(position);
         }
     }
 }
\ No newline at end of file
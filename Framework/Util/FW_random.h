@@ -8,7 +8,7 @@ namespace FW {
      * The chance of getting struct by lightning after winning the lottery
      * is greater than a collision (https://stackoverflow.com/a/58467162).
      */
-    std::string generateUUID() {
+    inline std::string generateUUID() {
         static std::random_device dev;
         static std::mt19937 rng(dev());
 
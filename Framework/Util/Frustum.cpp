@@ -0,0 +1,52 @@
+#include "Frustum.h"
+
+#include <cmath>
+
+namespace FW {
+    AABB AABB::transformed(const glm::mat4& matrix) const {
+        // The extents along each world axis are the absolute sum of the
+        // rotated and scaled local extents
+        glm::vec3 center = glm::vec3(matrix * glm::vec4(getCenter(), 1.0f));
+        glm::vec3 extents = getExtents();
+        glm::vec3 worldExtents{ 0.0f };
+        for (int column = 0; column < 3; column++) {
+            worldExtents += glm::abs(glm::vec3(matrix[column])) * extents[column];
+        }
+
+        return { center - worldExtents, center + worldExtents };
+    }
+
+    Frustum::Frustum(const glm::mat4& viewProjection) {
+        // glm is column major, so row i of the matrix is m[0][i] ... m[3][i]
+        const glm::mat4& m = viewProjection;
+        glm::vec4 row0{ m[0][0], m[1][0], m[2][0], m[3][0] };
+        glm::vec4 row1{ m[0][1], m[1][1], m[2][1], m[3][1] };
+        glm::vec4 row2{ m[0][2], m[1][2], m[2][2], m[3][2] };
+        glm::vec4 row3{ m[0][3], m[1][3], m[2][3], m[3][3] };
+
+        planes = { row3 + row0, row3 - row0, row3 + row1,
+                   row3 - row1, row3 + row2, row3 - row2 };
+
+        for (auto& plane : planes) {
+            float length = glm::length(glm::vec3(plane));
+            if (length > 0.0f) {
+                plane /= length;
+            }
+        }
+    }
+
+    bool Frustum::intersects(const AABB& box) const {
+        glm::vec3 center = box.getCenter();
+        glm::vec3 extents = box.getExtents();
+
+        for (const auto& plane : planes) {
+            glm::vec3 normal{ plane };
+            // Distance of the box's corner furthest along the normal
+            float radius = glm::dot(extents, glm::abs(normal));
+            if (glm::dot(normal, center) + plane.w + radius < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace FW
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+
+#include <glm/glm.hpp>
+
+namespace FW {
+    /** Axis-aligned bounding box. */
+    struct AABB {
+        glm::vec3 min{ 0.0f };
+        glm::vec3 max{ 0.0f };
+
+        glm::vec3 getCenter() const { return (min + max) * 0.5f; }
+        glm::vec3 getExtents() const { return (max - min) * 0.5f; }
+
+        /**
+         * Get the box enclosing this box after it is transformed by
+         * `matrix`. The result is as tight as an axis-aligned box around the
+         * transformed box can be.
+         */
+        AABB transformed(const glm::mat4& matrix) const;
+    };
+
+    /**
+     * The six planes bounding what a camera sees.
+     *
+     * Planes are extracted from a view-projection matrix, following Gribb
+     * and Hartmann, so this works the same for orthographic and perspective
+     * cameras. Plane normals point inwards.
+     *
+     * A default constructed frustum has no planes and contains everything.
+     */
+    class Frustum {
+    public:
+        Frustum() = default;
+
+        /** Extract the planes of `projection * view`. */
+        explicit Frustum(const glm::mat4& viewProjection);
+
+        /**
+         * Return false if `box` is entirely outside. Boxes near a corner of
+         * the frustum may be reported as intersecting although they are
+         * not, which only costs a draw that could have been skipped.
+         */
+        bool intersects(const AABB& box) const;
+
+    private:
+        /** Left, right, bottom, top, near, far: (normal, distance). */
+        std::array<glm::vec4, 6> planes{};
+    };
+} // namespace FW
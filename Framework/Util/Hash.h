@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace FW {
+    constexpr std::uint64_t fnv1aOffsetBasis = 0xcbf29ce484222325ull;
+
+    /**
+     * 64-bit FNV-1a hash of `data`.
+     *
+     * The result is stable across runs and platforms, so unlike std::hash it
+     * can be used to name files on disk. Pass a previous result as `seed` to
+     * hash several strings as if they were concatenated.
+     */
+    constexpr std::uint64_t hashFNV1a(std::string_view data,
+                                      std::uint64_t seed = fnv1aOffsetBasis) {
+        std::uint64_t hash = seed;
+        for (char c : data) {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+} // namespace FW
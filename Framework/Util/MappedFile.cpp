@@ -0,0 +1,112 @@
+#include "MappedFile.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace FW {
+    MappedFile::MappedFile(const std::filesystem::path& path) {
+#ifdef _WIN32
+        fileHandle = CreateFileW(path.c_str(),
+                                 GENERIC_READ,
+                                 FILE_SHARE_READ,
+                                 nullptr,
+                                 OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL,
+                                 nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) {
+            fileHandle = nullptr;
+            return;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+            close();
+            return;
+        }
+
+        mappingHandle = CreateFileMappingW(
+          fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mappingHandle) {
+            close();
+            return;
+        }
+
+        mapped = static_cast<const std::byte*>(
+          MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        if (!mapped) {
+            close();
+            return;
+        }
+        length = (std::size_t)fileSize.QuadPart;
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+
+        // The mapping keeps the file alive, so the descriptor can go
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* address =
+              mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address != MAP_FAILED) {
+                mapped = static_cast<const std::byte*>(address);
+                length = (std::size_t)info.st_size;
+            }
+        }
+        ::close(fd);
+#endif
+    }
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            mapped = std::exchange(other.mapped, nullptr);
+            length = std::exchange(other.length, 0);
+#ifdef _WIN32
+            fileHandle = std::exchange(other.fileHandle, nullptr);
+            mappingHandle = std::exchange(other.mappingHandle, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+    void MappedFile::close() {
+#ifdef _WIN32
+        if (mapped) {
+            UnmapViewOfFile(mapped);
+        }
+        if (mappingHandle) {
+            CloseHandle(mappingHandle);
+        }
+        if (fileHandle) {
+            CloseHandle(fileHandle);
+        }
+        fileHandle = nullptr;
+        mappingHandle = nullptr;
+#else
+        if (mapped) {
+            munmap(const_cast<std::byte*>(mapped), length);
+        }
+#endif
+        mapped = nullptr;
+        length = 0;
+    }
+} // namespace FW
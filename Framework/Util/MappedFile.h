@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace FW {
+    /**
+     * Read-only memory mapping of a whole file.
+     *
+     * The pages are loaded by the OS on first access and shared with its page
+     * cache, so mapping a file that was read recently costs no copy at all.
+     * The mapping is released when the object is destroyed.
+     */
+    class MappedFile {
+    public:
+        MappedFile() = default;
+
+        /** Map `path`. Check isOpen() to see whether it succeeded. */
+        explicit MappedFile(const std::filesystem::path& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        /** False if the file could not be opened, or if it is empty. */
+        [[nodiscard]] bool isOpen() const { return mapped != nullptr; }
+
+        [[nodiscard]] const std::byte* data() const { return mapped; }
+        [[nodiscard]] std::size_t size() const { return length; }
+
+        [[nodiscard]] std::span<const std::byte> getBytes() const {
+            return { mapped, length };
+        }
+
+    private:
+        void close();
+
+    private:
+        const std::byte* mapped = nullptr;
+        std::size_t length = 0;
+
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#endif
+    };
+} // namespace FW
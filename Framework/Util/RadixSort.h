@@ -0,0 +1,76 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace FW {
+    /**
+     * Stable LSD radix sort on a 64-bit key.
+     *
+     * The key is processed one byte at a time. Histograms for all eight
+     * bytes are built in a single pass up front, and bytes that are equal for
+     * every item are skipped, so keys with unused bits cost fewer passes.
+     *
+     * Small inputs are handed to std::stable_sort, which is faster there.
+     *
+     * @param items The items to sort in place.
+     * @param scratch Buffer reused between calls to avoid allocating. It is
+     * resized as needed.
+     * @param key Callable returning the std::uint64_t key of an item.
+     */
+    template<typename T, typename KeyFn>
+    void radixSort(std::vector<T>& items, std::vector<T>& scratch, KeyFn&& key) {
+        const std::size_t count = items.size();
+
+        if (count < 256) {
+            std::stable_sort(items.begin(), items.end(),
+                             [&](const T& a, const T& b) {
+                                 return key(a) < key(b);
+                             });
+            return;
+        }
+
+        std::array<std::array<std::size_t, 256>, 8> histograms{};
+        for (const T& item : items) {
+            std::uint64_t k = key(item);
+            for (int pass = 0; pass < 8; pass++) {
+                histograms[pass][(k >> (pass * 8)) & 0xFF]++;
+            }
+        }
+
+        scratch.resize(count);
+        T* source = items.data();
+        T* destination = scratch.data();
+
+        for (int pass = 0; pass < 8; pass++) {
+            auto& histogram = histograms[pass];
+            const int shift = pass * 8;
+
+            // Every item has the same byte here, nothing to reorder
+            if (histogram[(key(*source) >> shift) & 0xFF] == count) {
+                continue;
+            }
+
+            std::size_t offset = 0;
+            for (auto& bucket : histogram) {
+                std::size_t size = bucket;
+                bucket = offset;
+                offset += size;
+            }
+
+            for (std::size_t i = 0; i < count; i++) {
+                std::size_t byte = (key(source[i]) >> shift) & 0xFF;
+                destination[histogram[byte]++] = std::move(source[i]);
+            }
+
+            std::swap(source, destination);
+        }
+
+        if (source != items.data()) {
+            std::move(source, source + count, items.data());
+        }
+    }
+} // namespace FW
@@ -0,0 +1,106 @@
+#include "SkylinePacker.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace FW {
+    SkylinePacker::SkylinePacker(int width, int height)
+      : width(width),
+        height(height) {
+        reset();
+    }
+
+    std::optional<SkylinePacker::Rect> SkylinePacker::insert(int width,
+                                                             int height) {
+        if (width <= 0 || height <= 0) {
+            return std::nullopt;
+        }
+
+        // Lowest top edge wins. Ties go to the narrower segment, which
+        // leaves wide gaps for wide rectangles.
+        int bestTop = std::numeric_limits<int>::max();
+        int bestSegmentWidth = std::numeric_limits<int>::max();
+        std::size_t bestIndex = 0;
+        Rect best;
+
+        for (std::size_t i = 0; i < skyline.size(); i++) {
+            int y = fit(i, width, height);
+            if (y < 0) {
+                continue;
+            }
+
+            int top = y + height;
+            if (top < bestTop ||
+                (top == bestTop && skyline[i].width < bestSegmentWidth)) {
+                bestTop = top;
+                bestSegmentWidth = skyline[i].width;
+                bestIndex = i;
+                best = { skyline[i].x, y, width, height };
+            }
+        }
+
+        if (bestTop == std::numeric_limits<int>::max()) {
+            return std::nullopt;
+        }
+
+        addSegment(bestIndex, best);
+        usedArea += (std::int64_t)width * height;
+        return best;
+    }
+
+    void SkylinePacker::reset() {
+        skyline.clear();
+        skyline.push_back({ 0, 0, width });
+        usedArea = 0;
+    }
+
+    int SkylinePacker::fit(std::size_t index, int width, int height) const {
+        if (skyline[index].x + width > this->width) {
+            return -1;
+        }
+
+        // The rectangle rests on the highest segment below it
+        int y = 0;
+        int remaining = width;
+        for (std::size_t i = index; remaining > 0; i++) {
+            y = std::max(y, skyline[i].y);
+            if (y + height > this->height) {
+                return -1;
+            }
+            remaining -= skyline[i].width;
+        }
+        return y;
+    }
+
+    void SkylinePacker::addSegment(std::size_t index, const Rect& rect) {
+        skyline.insert(skyline.begin() + index,
+                       { rect.x, rect.y + rect.height, rect.width });
+
+        // Cut away what the new segment covers of the ones to its right
+        std::size_t i = index + 1;
+        while (i < skyline.size()) {
+            const Segment& previous = skyline[i - 1];
+            int overlap = previous.x + previous.width - skyline[i].x;
+            if (overlap <= 0) {
+                break;
+            }
+
+            skyline[i].x += overlap;
+            skyline[i].width -= overlap;
+            if (skyline[i].width > 0) {
+                break;
+            }
+            skyline.erase(skyline.begin() + i);
+        }
+
+        // Neighbours at the same height become one segment
+        for (i = 1; i < skyline.size();) {
+            if (skyline[i - 1].y == skyline[i].y) {
+                skyline[i - 1].width += skyline[i].width;
+                skyline.erase(skyline.begin() + i);
+            } else {
+                i++;
+            }
+        }
+    }
+} // namespace FW
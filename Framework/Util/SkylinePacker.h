@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace FW {
+    /**
+     * Packs rectangles into a fixed-size area.
+     *
+     * The packer keeps the skyline, the top edge of everything placed so far,
+     * as a list of horizontal segments from left to right. A new rectangle is
+     * placed on the skyline where its top ends lowest, which keeps the
+     * remaining space in one piece. Inserting costs O(segments), and there are
+     * rarely more segments than rectangles in a row.
+     *
+     * Space below the skyline is never reused, so inserting rectangles from
+     * tallest to shortest packs noticeably tighter.
+     */
+    class SkylinePacker {
+    public:
+        struct Rect {
+            int x = 0;
+            int y = 0;
+            int width = 0;
+            int height = 0;
+        };
+
+    public:
+        SkylinePacker(int width, int height);
+
+        /**
+         * Find room for a `width` x `height` rectangle and mark it as used.
+         *
+         * @return The placed rectangle, or nothing if it does not fit.
+         */
+        std::optional<Rect> insert(int width, int height);
+
+        /** Forget every rectangle inserted so far. */
+        void reset();
+
+        int getWidth() const { return width; }
+        int getHeight() const { return height; }
+
+        /** Fraction of the area covered by inserted rectangles. */
+        float getOccupancy() const {
+            return (float)usedArea / ((float)width * (float)height);
+        }
+
+    private:
+        struct Segment {
+            int x;
+            int y;
+            int width;
+        };
+
+        /**
+         * Bottom of a `width` x `height` rectangle whose left edge is at the
+         * start of segment `index`, or -1 if it would stick out.
+         */
+        int fit(std::size_t index, int width, int height) const;
+
+        /** Raise the skyline over `rect`, placed at segment `index`. */
+        void addSegment(std::size_t index, const Rect& rect);
+
+    private:
+        int width;
+        int height;
+        std::int64_t usedArea = 0;
+
+        std::vector<Segment> skyline;
+    };
+} // namespace FW
@@ -0,0 +1,57 @@
+#include "doctest/doctest.h"
+
+#include "Frustum.h"
+
+#include <cmath>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+TEST_CASE("Frustum of an orthographic camera culls boxes outside the view") {
+    glm::mat4 projection = glm::ortho(-10.0f, 10.0f, -5.0f, 5.0f, 0.1f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(20.0f, 0.0f, 10.0f),
+                                 glm::vec3(20.0f, 0.0f, 0.0f),
+                                 glm::vec3(0.0f, 1.0f, 0.0f));
+    FW::Frustum frustum(projection * view);
+
+    // The view spans x in [10, 30] and y in [-5, 5] at z = 0
+    CHECK(frustum.intersects({ { 19.0f, -1.0f, -1.0f }, { 21.0f, 1.0f, 1.0f } }));
+    CHECK(frustum.intersects({ { 29.0f, 4.0f, 0.0f }, { 31.0f, 6.0f, 0.0f } }));
+    CHECK(!frustum.intersects({ { 0.0f, -1.0f, 0.0f }, { 9.0f, 1.0f, 0.0f } }));
+    CHECK(!frustum.intersects({ { 31.0f, -1.0f, 0.0f }, { 40.0f, 1.0f, 0.0f } }));
+    CHECK(!frustum.intersects({ { 20.0f, 6.0f, 0.0f }, { 21.0f, 7.0f, 0.0f } }));
+
+    // Behind the camera
+    CHECK(!frustum.intersects({ { 19.0f, -1.0f, 11.0f }, { 21.0f, 1.0f, 12.0f } }));
+}
+
+TEST_CASE("Frustum of a perspective camera culls boxes outside the view") {
+    glm::mat4 projection =
+      glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 50.0f);
+    FW::Frustum frustum(projection);
+
+    // The camera looks down -Z, and sees x in [-d, d] at distance d
+    CHECK(frustum.intersects({ { -1.0f, -1.0f, -11.0f }, { 1.0f, 1.0f, -9.0f } }));
+    CHECK(frustum.intersects({ { 9.0f, 0.0f, -10.0f }, { 11.0f, 1.0f, -10.0f } }));
+    CHECK(!frustum.intersects({ { 12.0f, 0.0f, -10.0f }, { 13.0f, 1.0f, -10.0f } }));
+    CHECK(!frustum.intersects({ { -1.0f, -1.0f, -60.0f }, { 1.0f, 1.0f, -55.0f } }));
+}
+
+TEST_CASE("Default Frustum contains everything") {
+    FW::Frustum frustum;
+    CHECK(frustum.intersects({ { 1e6f, 1e6f, 1e6f }, { 1e6f, 1e6f, 1e6f } }));
+}
+
+TEST_CASE("AABB transformed encloses the transformed corners") {
+    FW::AABB box{ { -0.5f, -0.5f, 0.0f }, { 0.5f, 0.5f, 0.0f } };
+
+    glm::mat4 matrix = glm::translate(glm::mat4(1.0f), { 10.0f, 0.0f, 0.0f });
+    matrix = glm::rotate(matrix, glm::radians(45.0f), { 0.0f, 0.0f, 1.0f });
+    matrix = glm::scale(matrix, { 2.0f, 2.0f, 1.0f });
+
+    FW::AABB world = box.transformed(matrix);
+    float halfDiagonal = std::sqrt(2.0f);
+    CHECK(world.min.x == doctest::Approx(10.0f - halfDiagonal));
+    CHECK(world.max.x == doctest::Approx(10.0f + halfDiagonal));
+    CHECK(world.min.y == doctest::Approx(-halfDiagonal));
+    CHECK(world.max.y == doctest::Approx(halfDiagonal));
+}
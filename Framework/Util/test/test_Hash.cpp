@@ -0,0 +1,20 @@
+#include "doctest/doctest.h"
+
+#include "Hash.h"
+
+#include <string>
+
+TEST_CASE("hashFNV1a() matches the reference values") {
+    CHECK(FW::hashFNV1a("") == 0xcbf29ce484222325ull);
+    CHECK(FW::hashFNV1a("a") == 0xaf63dc4c8601ec8cull);
+    CHECK(FW::hashFNV1a("foobar") == 0x85944171f73967e8ull);
+}
+
+TEST_CASE("hashFNV1a() can be chained") {
+    std::string first = "vertex source";
+    std::string second = "fragment source";
+
+    CHECK(FW::hashFNV1a(second, FW::hashFNV1a(first)) ==
+          FW::hashFNV1a(first + second));
+    CHECK(FW::hashFNV1a(first) != FW::hashFNV1a(second));
+}
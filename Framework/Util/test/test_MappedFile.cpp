@@ -0,0 +1,57 @@
+#include "doctest/doctest.h"
+
+#include "MappedFile.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+
+static std::filesystem::path writeTempFile(const std::string& contents) {
+    std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "yagi_test_mapped_file.bin";
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << contents;
+    return path;
+}
+
+TEST_CASE("MappedFile maps the whole file") {
+    std::string contents = "decoded texels";
+    std::filesystem::path path = writeTempFile(contents);
+
+    {
+        FW::MappedFile file(path);
+        REQUIRE(file.isOpen());
+        CHECK(file.size() == contents.size());
+        CHECK(std::memcmp(file.data(), contents.data(), contents.size()) == 0);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("MappedFile fails on missing and empty files") {
+    CHECK(!FW::MappedFile("this/file/does/not/exist.bin").isOpen());
+
+    std::filesystem::path path = writeTempFile("");
+    CHECK(!FW::MappedFile(path).isOpen());
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("MappedFile hands over the mapping when moved") {
+    std::filesystem::path path = writeTempFile("moved");
+
+    FW::MappedFile first(path);
+    const std::byte* data = first.data();
+    FW::MappedFile second = std::move(first);
+
+    CHECK(!first.isOpen());
+    CHECK(second.isOpen());
+    CHECK(second.data() == data);
+    CHECK(second.size() == 5);
+
+    second = FW::MappedFile();
+    CHECK(!second.isOpen());
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,41 @@
+#include "doctest/doctest.h"
+
+#include "RadixSort.h"
+
+#include <random>
+
+struct KeyedItem {
+    std::uint64_t key;
+    std::size_t order;
+};
+
+TEST_CASE("radixSort() sorts like a stable sort") {
+    std::mt19937_64 rng(1234);
+
+    for (std::size_t count : { 0, 1, 100, 5000 }) {
+        std::vector<KeyedItem> items(count);
+        for (std::size_t i = 0; i < count; i++) {
+            // Few distinct keys, with both high and low bits in use
+            std::uint64_t k = rng() % 64;
+            items[i] = { (k << 58) | (k * 7), i };
+        }
+
+        std::vector<KeyedItem> expected = items;
+        std::stable_sort(expected.begin(),
+                         expected.end(),
+                         [](const KeyedItem& a, const KeyedItem& b) {
+                             return a.key < b.key;
+                         });
+
+        std::vector<KeyedItem> scratch;
+        FW::radixSort(items, scratch, [](const KeyedItem& item) {
+            return item.key;
+        });
+
+        REQUIRE(items.size() == expected.size());
+        for (std::size_t i = 0; i < count; i++) {
+            CHECK(items[i].key == expected[i].key);
+            CHECK(items[i].order == expected[i].order);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#include "doctest/doctest.h"
+
+#include "SkylinePacker.h"
+
+#include <random>
+#include <vector>
+
+using Rect = FW::SkylinePacker::Rect;
+
+static bool overlaps(const Rect& a, const Rect& b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width &&
+           a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+TEST_CASE("SkylinePacker places rectangles inside without overlap") {
+    std::mt19937 rng(42);
+    FW::SkylinePacker packer(512, 512);
+
+    std::vector<Rect> placed;
+    for (int i = 0; i < 200; i++) {
+        auto rect = packer.insert(8 + rng() % 56, 8 + rng() % 56);
+        if (!rect) {
+            continue;
+        }
+
+        CHECK(rect->x >= 0);
+        CHECK(rect->y >= 0);
+        CHECK(rect->x + rect->width <= 512);
+        CHECK(rect->y + rect->height <= 512);
+        for (const Rect& other : placed) {
+            CHECK(!overlaps(*rect, other));
+        }
+        placed.push_back(*rect);
+    }
+
+    CHECK(placed.size() > 50);
+    CHECK(packer.getOccupancy() > 0.5f);
+}
+
+TEST_CASE("SkylinePacker fills the area exactly with equal tiles") {
+    FW::SkylinePacker packer(64, 64);
+    for (int i = 0; i < 16; i++) {
+        REQUIRE(packer.insert(16, 16));
+    }
+
+    CHECK(packer.getOccupancy() == 1.0f);
+    CHECK(!packer.insert(1, 1));
+}
+
+TEST_CASE("SkylinePacker rejects rectangles that cannot fit") {
+    FW::SkylinePacker packer(32, 32);
+    CHECK(!packer.insert(33, 1));
+    CHECK(!packer.insert(1, 33));
+    CHECK(!packer.insert(0, 4));
+
+    REQUIRE(packer.insert(32, 32));
+    CHECK(!packer.insert(1, 1));
+
+    packer.reset();
+    CHECK(packer.getOccupancy() == 0.0f);
+    CHECK(packer.insert(32, 32));
+}
@@ -10,6 +10,7 @@
 #include "Timer.h"
 #include "assertions.h"
 #include "EntryPoint.h"
+#include "JobSystem.h"
 
 // Geometric Tools
 #include "GeometricTools.h"
@@ -44,7 +45,6 @@
 #include "ParticleSystem.h"
 #include "Force.h"
 #include "Solver.h"
-#include "PhysicsBody.h"
 
 // Resource Management
 //#include "Model.h"
@@ -102,7 +102,7 @@ bool PhysicsApp::init() {
     // -------------
     // Entities
     // -------------
-    FW::TextureManager::loadTexture2D(
+    FW::TextureManager::loadTexture2DAsync(
       "metal_plate_diff",
       RESOURCES_DIR +
         std::string("textures/polyhaven/metal_plate/metal_plate_diff_1k.jpg"));
@@ -149,6 +149,7 @@ void PhysicsApp::run() {
     emitterTimer.resetTimer();
 
     while (!glfwWindowShouldClose(getWindow())) {
+        FW::TextureManager::processUploads();
         glfwPollEvents();
         appWidget.beginDraw();
 
@@ -24,13 +24,13 @@ void PhysicsScene::update(float delta) {
         shape->init();
 
         FW::ref<FW::DrawableComponent> drawableComponent =
-          FW::createRef<FW::DrawableComponent>();
+          FW::createComponent<FW::DrawableComponent>();
         drawableComponent->setShape(shape);
         drawableComponent->setShader(shader);
         drawableComponent->init();
 
         FW::ref<FW::TransformationComponent> xformComponent =
-          FW::createRef<FW::TransformationComponent>();
+          FW::createComponent<FW::TransformationComponent>();
         xformComponent->setShader(shader);
         xformComponent->init();
 
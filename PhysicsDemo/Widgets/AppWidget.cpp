@@ -10,6 +10,7 @@
 #include "Layouts.h"
 #include "Files.h"
 #include "Component.h"
+#include "RenderState.h"
 
 #include "AssetSystem.h"
 
@@ -606,7 +607,7 @@ void AppWidget::setFontSize(float size) {
     // Upload the font texture to the GPU (example using OpenGL)
     uint32_t fontTexture;
     glGenTextures(1, &fontTexture);
-    glBindTexture(GL_TEXTURE_2D, fontTexture);
+    FW::RenderState::get().bindTexture(GL_TEXTURE_2D, fontTexture, 0);
     glTexImage2D(GL_TEXTURE_2D,
                  0,
                  GL_RGBA,